@@ -8,14 +8,68 @@ SOURCES += \
     src/WebcamHandler.cpp \
     src/Projectile.cpp \
     src/PalmDetection.cpp \
-    src/PalmTracker.cpp
+    src/PalmTracker.cpp \
+    src/VisionBufferPool.cpp \
+    src/FramePreprocessor.cpp \
+    src/PalmCalibrationModel.cpp \
+    src/SkinDetector.cpp \
+    src/ImagePyramid.cpp \
+    src/RenderUniforms.cpp \
+    src/ShaderLibrary.cpp \
+    src/Mesh.cpp \
+    src/ShadowMap.cpp \
+    src/RenderQueue.cpp \
+    src/Frustum.cpp \
+    src/MeshUploadQueue.cpp \
+    src/ProjectileRenderer.cpp \
+    src/GameSimulation.cpp \
+    src/GpuProfiler.cpp \
+    src/TextureLoader.cpp \
+    src/StartupTimer.cpp \
+    src/SceneRenderer.cpp \
+    src/MeshLibrary.cpp \
+    src/JuiceParticles.cpp \
+    src/DynamicResolution.cpp \
+    src/StreamBuffer.cpp \
+    src/MeshSlicer.cpp \
+    src/SliceJobs.cpp \
+    src/FragmentManager.cpp
 
 HEADERS += \
     src/MainWindow.h \
     src/OpenGLWidget.h \
     src/WebcamHandler.h \
     src/Projectile.h \
-    src/PalmTracker.h
+    src/PalmTracker.h \
+    src/VisionBufferPool.h \
+    src/FramePreprocessor.h \
+    src/PalmCalibrationModel.h \
+    src/SkinDetector.h \
+    src/ImagePyramid.h \
+    src/RenderUniforms.h \
+    src/ShaderLibrary.h \
+    src/Mesh.h \
+    src/ShadowMap.h \
+    src/RenderQueue.h \
+    src/Frustum.h \
+    src/TripleBuffer.h \
+    src/MeshUploadQueue.h \
+    src/ProjectileRenderer.h \
+    src/GameSimulation.h \
+    src/GpuProfiler.h \
+    src/KtxFormat.h \
+    src/TextureLoader.h \
+    src/StartupTimer.h \
+    src/SceneRenderer.h \
+    src/MeshAssetFormat.h \
+    src/MeshLibrary.h \
+    src/JuiceParticles.h \
+    src/DynamicResolution.h \
+    src/StreamBuffer.h \
+    src/TrigTables.h \
+    src/MeshSlicer.h \
+    src/SliceJobs.h \
+    src/FragmentManager.h
 
 # OpenCV
 
@@ -0,0 +1,133 @@
+#include "DynamicResolution.h"
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Échelle arrondie au pas inférieur (la marge évite 0.55 / 0.05 = 10.999...)
+float quantize(float scale) {
+    return std::floor(scale / DynamicResolution::SCALE_STEP + 1e-3f) * DynamicResolution::SCALE_STEP;
+}
+
+}
+
+void DynamicResolution::setBounds(float minScale, float maxScale) {
+    m_minScale = std::clamp(minScale, 0.25f, 1.0f);
+    m_maxScale = std::clamp(maxScale, m_minScale, 1.0f);
+    m_scale = std::clamp(m_scale, m_minScale, m_maxScale);
+    m_samplesSinceChange = 0;
+    m_smoothedTime = 0.0f;
+}
+
+void DynamicResolution::setBudget(float milliseconds) {
+    m_budget = std::max(1.0f, milliseconds);
+}
+
+int DynamicResolution::renderWidth() const {
+    return isActive() ? std::max(1, int(std::lround(m_outputWidth * m_scale))) : m_outputWidth;
+}
+
+int DynamicResolution::renderHeight() const {
+    return isActive() ? std::max(1, int(std::lround(m_outputHeight * m_scale))) : m_outputHeight;
+}
+
+void DynamicResolution::resize(int outputWidth, int outputHeight) {
+    if (!m_initialized) {
+        initializeOpenGLFunctions();
+        m_initialized = true;
+    }
+
+    m_outputWidth = outputWidth;
+    m_outputHeight = outputHeight;
+
+    // Deux bornes à 1 : rendu direct, sans framebuffer ni copie
+    if (m_minScale >= 1.0f) {
+        destroy();
+        return;
+    }
+
+    const int width = std::max(1, int(std::ceil(outputWidth * m_maxScale)));
+    const int height = std::max(1, int(std::ceil(outputHeight * m_maxScale)));
+    if (m_framebuffer && width == m_allocatedWidth && height == m_allocatedHeight) return;
+
+    m_allocatedWidth = width;
+    m_allocatedHeight = height;
+    allocate();
+}
+
+void DynamicResolution::allocate() {
+    if (!m_framebuffer) {
+        glGenFramebuffers(1, &m_framebuffer);
+        glGenRenderbuffers(1, &m_colorBuffer);
+        glGenRenderbuffers(1, &m_depthBuffer);
+    }
+
+    glBindRenderbuffer(GL_RENDERBUFFER, m_colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, m_allocatedWidth, m_allocatedHeight);
+    glBindRenderbuffer(GL_RENDERBUFFER, m_depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, m_allocatedWidth, m_allocatedHeight);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_colorBuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, m_depthBuffer);
+    const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    if (!complete) {
+        qWarning() << "Scaled render target incomplete, rendering at full resolution";
+        destroy();
+    }
+}
+
+void DynamicResolution::destroy() {
+    if (!m_framebuffer) return;
+
+    glDeleteFramebuffers(1, &m_framebuffer);
+    glDeleteRenderbuffers(1, &m_colorBuffer);
+    glDeleteRenderbuffers(1, &m_depthBuffer);
+    m_framebuffer = 0;
+    m_colorBuffer = 0;
+    m_depthBuffer = 0;
+    m_allocatedWidth = 0;
+    m_allocatedHeight = 0;
+}
+
+void DynamicResolution::adjust(const GpuProfiler& profiler) {
+    if (!isActive() || !profiler.isSupported() || profiler.gpuSampleCount() == m_lastSample) return;
+    m_lastSample = profiler.gpuSampleCount();
+
+    // Les premières mesures après un changement portent sur des images rendues à l'ancienne échelle
+    if (++m_samplesSinceChange <= GpuProfiler::FRAME_LATENCY) return;
+
+    const float time = profiler.latestGpuTime();
+    m_smoothedTime = m_smoothedTime > 0.0f ? m_smoothedTime * 0.9f + time * 0.1f : time;
+
+    // Le coût suit à peu près le nombre de pixels, soit le carré de l'échelle
+    float target = m_scale;
+    if (time > m_budget) {
+        target = quantize(m_scale * std::sqrt(m_budget * 0.95f / time));
+        target = std::min(target, m_scale - SCALE_STEP);
+    } else if (m_samplesSinceChange > 30 && m_smoothedTime < m_budget * UPSCALE_MARGIN) {
+        target = m_scale + SCALE_STEP;
+    }
+
+    target = std::clamp(target, m_minScale, m_maxScale);
+    if (std::abs(target - m_scale) > 1e-3f) {
+        m_scale = target;
+        m_samplesSinceChange = 0;
+        m_smoothedTime = 0.0f;
+    }
+}
+
+void DynamicResolution::present(GLuint targetFramebuffer) {
+    if (!isActive()) return;
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, m_framebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, targetFramebuffer);
+    glBlitFramebuffer(0, 0, renderWidth(), renderHeight(),
+                      0, 0, m_outputWidth, m_outputHeight,
+                      GL_COLOR_BUFFER_BIT, GL_LINEAR);
+    glBindFramebuffer(GL_FRAMEBUFFER, targetFramebuffer);
+}
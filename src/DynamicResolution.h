@@ -0,0 +1,109 @@
+/**
+ * @file DynamicResolution.h
+ * @brief Résolution de rendu adaptée au temps GPU mesuré
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef DYNAMICRESOLUTION_H
+#define DYNAMICRESOLUTION_H
+
+#include <QOpenGLExtraFunctions>
+#include "GpuProfiler.h"
+
+/**
+ * @class DynamicResolution
+ * @brief Cible de rendu réduite et agrandie vers la fenêtre pour tenir un budget GPU
+ *
+ * La scène est rendue dans un framebuffer hors écran dont seule une partie,
+ * l'échelle courante de la taille de la fenêtre, est utilisée ; elle est
+ * ensuite agrandie vers la fenêtre par un glBlitFramebuffer filtré. Le
+ * framebuffer est alloué une fois à l'échelle maximale : changer d'échelle ne
+ * change que la zone d'affichage, sans réallocation.
+ *
+ * L'échelle suit le temps GPU relevé par GpuProfiler. Les mesures arrivant
+ * FRAME_LATENCY images plus tard, aucune décision n'est prise avant que les
+ * images rendues à la nouvelle échelle n'aient été mesurées. Une image trop
+ * lente fait baisser l'échelle aussitôt ; elle ne remonte que si la moyenne
+ * récente laisse une marge, par pas de SCALE_STEP.
+ */
+class DynamicResolution : protected QOpenGLExtraFunctions {
+public:
+    static constexpr float DEFAULT_MIN_SCALE = 0.5f;     ///< Échelle minimale par défaut (par côté)
+    static constexpr float DEFAULT_MAX_SCALE = 1.0f;     ///< Échelle maximale par défaut (par côté)
+    static constexpr float DEFAULT_BUDGET_MS = 14.0f;    ///< Budget GPU par défaut, sous les 16,7 ms de 60 Hz
+    static constexpr float SCALE_STEP = 0.05f;           ///< Granularité de l'échelle
+    static constexpr float UPSCALE_MARGIN = 0.8f;        ///< Fraction du budget sous laquelle l'échelle remonte
+
+    DynamicResolution() = default;
+
+    DynamicResolution(const DynamicResolution&) = delete;
+    DynamicResolution& operator=(const DynamicResolution&) = delete;
+
+    /**
+     * @brief Bornes de l'échelle appliquée à chaque côté de la fenêtre
+     *
+     * Avec deux bornes à 1, la scène est rendue directement dans la fenêtre.
+     */
+    void setBounds(float minScale, float maxScale);
+
+    /**
+     * @brief Temps GPU visé par image (ms)
+     */
+    void setBudget(float milliseconds);
+
+    /**
+     * @brief Adapte la cible à la taille de la fenêtre (contexte courant requis)
+     * @param outputWidth Largeur de la fenêtre en pixels physiques
+     * @param outputHeight Hauteur de la fenêtre en pixels physiques
+     */
+    void resize(int outputWidth, int outputHeight);
+
+    /**
+     * @brief Libère le framebuffer (contexte courant requis)
+     */
+    void destroy();
+
+    /**
+     * @brief Ajuste l'échelle d'après les mesures GPU arrivées depuis l'image précédente
+     */
+    void adjust(const GpuProfiler& profiler);
+
+    /**
+     * @brief Agrandit l'image rendue vers la fenêtre
+     * @param targetFramebuffer Framebuffer de la fenêtre
+     */
+    void present(GLuint targetFramebuffer);
+
+    /**
+     * @brief Indique si la scène passe par le framebuffer réduit
+     */
+    bool isActive() const { return m_framebuffer != 0; }
+
+    GLuint framebuffer() const { return m_framebuffer; }
+    int renderWidth() const;
+    int renderHeight() const;
+    float scale() const { return m_scale; }
+
+private:
+    void allocate();
+
+    float m_minScale = DEFAULT_MIN_SCALE;
+    float m_maxScale = DEFAULT_MAX_SCALE;
+    float m_budget = DEFAULT_BUDGET_MS;
+    float m_scale = DEFAULT_MAX_SCALE;          ///< Échelle courante, multiple de SCALE_STEP
+    float m_smoothedTime = 0.0f;                ///< Moyenne glissante du temps GPU à l'échelle courante (ms)
+    quint64 m_lastSample = 0;                   ///< Dernière mesure prise en compte
+    int m_samplesSinceChange = 0;               ///< Mesures reçues depuis le dernier changement d'échelle
+
+    int m_outputWidth = 0;
+    int m_outputHeight = 0;
+    int m_allocatedWidth = 0;                   ///< Taille du framebuffer (échelle maximale)
+    int m_allocatedHeight = 0;
+    GLuint m_framebuffer = 0;
+    GLuint m_colorBuffer = 0;
+    GLuint m_depthBuffer = 0;
+    bool m_initialized = false;
+};
+
+#endif
@@ -0,0 +1,91 @@
+#include "FragmentManager.h"
+#include <algorithm>
+
+namespace {
+
+// Indice du fragment le plus ancien parmi ceux retenus par le filtre (-1 : aucun)
+template <typename Filter>
+int oldest(const std::vector<Projectile>& fragments, Filter filter) {
+    int found = -1;
+    for (int i = 0; i < int(fragments.size()); ++i) {
+        if (filter(fragments[i]) && (found < 0 || fragments[i].id() < fragments[found].id())) {
+            found = i;
+        }
+    }
+    return found;
+}
+
+void swapRemove(std::vector<Projectile>& fragments, int index) {
+    if (index != int(fragments.size()) - 1) {
+        fragments[index] = fragments.back();
+    }
+    fragments.pop_back();
+}
+
+}
+
+FragmentManager::FragmentManager() {
+    m_fragments.reserve(MAX_FRAGMENTS);
+    m_pending.reserve(MAX_FRAGMENTS);
+}
+
+bool FragmentManager::canSlice(const Projectile& projectile) {
+    if (!projectile.isFragment()) return true;
+    return projectile.generation() < MAX_GENERATION && !projectile.isFading();
+}
+
+void FragmentManager::add(const Projectile& fragment) {
+    while (count() >= MAX_FRAGMENTS) {
+        evictOldest();
+    }
+    m_pending.push_back(fragment);
+    retireExcess();
+}
+
+void FragmentManager::commitPending() {
+    m_fragments.insert(m_fragments.end(), m_pending.begin(), m_pending.end());
+    m_pending.clear();
+}
+
+void FragmentManager::removeAt(int index) {
+    swapRemove(m_fragments, index);
+}
+
+void FragmentManager::removeInactive() {
+    for (int i = 0; i < int(m_fragments.size()); ++i) {
+        if (!m_fragments[i].isActive()) {
+            swapRemove(m_fragments, i);
+            i--;
+        }
+    }
+}
+
+void FragmentManager::clear() {
+    m_fragments.clear();
+    m_pending.clear();
+    m_evictions = 0;
+}
+
+void FragmentManager::evictOldest() {
+    auto any = [](const Projectile&) { return true; };
+    const int index = oldest(m_fragments, any);
+    if (index >= 0) {
+        swapRemove(m_fragments, index);
+    } else {
+        swapRemove(m_pending, oldest(m_pending, any));
+    }
+    m_evictions++;
+}
+
+void FragmentManager::retireExcess() {
+    auto visible = [](const Projectile& fragment) { return !fragment.isFading(); };
+    int remaining = int(std::count_if(m_fragments.begin(), m_fragments.end(), visible)) + int(m_pending.size());
+
+    // Les fragments en attente viennent d'apparaître : seuls les fragments déjà simulés disparaissent
+    while (remaining > RETIRE_THRESHOLD) {
+        const int index = oldest(m_fragments, visible);
+        if (index < 0) break;
+        m_fragments[index].startFade(FADE_DURATION);
+        remaining--;
+    }
+}
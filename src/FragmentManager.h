@@ -0,0 +1,114 @@
+/**
+ * @file FragmentManager.h
+ * @brief Budget, stockage et retrait des fragments de projectiles
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef FRAGMENTMANAGER_H
+#define FRAGMENTMANAGER_H
+
+#include "Projectile.h"
+#include <vector>
+
+/**
+ * @class FragmentManager
+ * @brief Fragments vivants de la simulation, en nombre borné
+ *
+ * Chaque découpe ajoute deux fragments qui vivent jusqu'à leur chute : sans
+ * limite, un balayage dans un nuage de fragments fait croître leur nombre de
+ * façon géométrique. Le gestionnaire borne ce nombre de trois façons :
+ * - un fragment issu de MAX_GENERATION découpes successives ne se découpe plus ;
+ * - au-delà de RETIRE_THRESHOLD fragments, les plus anciens disparaissent en
+ *   FADE_DURATION secondes (réduits jusqu'à une taille nulle) ;
+ * - MAX_FRAGMENTS n'est jamais dépassé : si la disparition progressive ne
+ *   suffit pas, le plus ancien est retiré aussitôt.
+ *
+ * Les fragments sont rangés dans des tableaux réservés à MAX_FRAGMENTS à la
+ * construction : l'ajout et le retrait (échange avec le dernier) n'allouent
+ * jamais. Les identifiants de projectiles étant croissants, le plus ancien
+ * fragment est celui dont l'identifiant est le plus petit.
+ *
+ * Les fragments ajoutés pendant un pas attendent commitPending() : ils ne
+ * peuvent pas être découpés à nouveau par le coup qui les a créés.
+ */
+class FragmentManager {
+public:
+    static constexpr int MAX_FRAGMENTS = 48;                        ///< Fragments simultanés au plus (budget strict)
+    static constexpr int RETIRE_THRESHOLD = MAX_FRAGMENTS * 3 / 4;  ///< Nombre au-delà duquel les plus anciens disparaissent
+    static constexpr int MAX_GENERATION = 2;                        ///< Découpes successives au plus depuis le projectile entier
+    static constexpr float FADE_DURATION = 0.3f;                    ///< Durée de disparition d'un fragment retiré (s)
+
+    static_assert(MAX_GENERATION <= Projectile::MAX_CUTS, "a fragment stores every cut that produced it");
+
+    /**
+     * @brief Constructeur : réserve le stockage pour MAX_FRAGMENTS fragments
+     */
+    FragmentManager();
+
+    /**
+     * @brief Indique si un projectile peut encore être découpé
+     *
+     * Les projectiles entiers le peuvent toujours ; un fragment seulement s'il
+     * n'a pas atteint MAX_GENERATION et n'est pas en train de disparaître.
+     */
+    static bool canSlice(const Projectile& projectile);
+
+    /**
+     * @brief Ajoute un fragment, actif à partir du prochain commitPending()
+     *
+     * Fait de la place si le budget est atteint et lance la disparition des plus
+     * anciens au-delà de RETIRE_THRESHOLD.
+     */
+    void add(const Projectile& fragment);
+
+    /**
+     * @brief Rend actifs les fragments ajoutés depuis le dernier appel
+     */
+    void commitPending();
+
+    /**
+     * @brief Retire le fragment d'indice index (le dernier prend sa place)
+     */
+    void removeAt(int index);
+
+    /**
+     * @brief Retire les fragments devenus inactifs (tombés ou disparus)
+     */
+    void removeInactive();
+
+    /**
+     * @brief Retire tous les fragments
+     */
+    void clear();
+
+    std::vector<Projectile>& fragments() { return m_fragments; }
+    const std::vector<Projectile>& fragments() const { return m_fragments; }
+
+    /**
+     * @brief Nombre de fragments, actifs et en attente
+     */
+    int count() const { return int(m_fragments.size() + m_pending.size()); }
+
+    /**
+     * @brief Nombre de fragments retirés aussitôt faute de place depuis le dernier clear()
+     */
+    int evictions() const { return m_evictions; }
+
+private:
+    /**
+     * @brief Retire immédiatement le plus ancien fragment (actif de préférence)
+     */
+    void evictOldest();
+
+    /**
+     * @brief Lance la disparition des plus anciens fragments au-delà de RETIRE_THRESHOLD
+     */
+    void retireExcess();
+
+    std::vector<Projectile> m_fragments;   ///< Fragments simulés
+    std::vector<Projectile> m_pending;     ///< Fragments ajoutés pendant le pas en cours
+    int m_evictions = 0;
+};
+
+#endif
@@ -0,0 +1,154 @@
+#include "FramePreprocessor.h"
+#include "VisionBufferPool.h"
+#include <opencv2/core/hal/intrin.hpp>
+#include <algorithm>
+
+namespace {
+
+// Approximation 8 bits de BT.601 (somme = 256) : tient dans les voies 16 bits, mais peut
+// différer d'un niveau de cv::COLOR_BGR2GRAY, qui utilise des poids sur 14 bits
+const int GRAY_WEIGHT_B = 29;
+const int GRAY_WEIGHT_G = 150;
+const int GRAY_WEIGHT_R = 77;
+
+}
+
+void FramePreprocessor::configure(const cv::Size& frameSize, int scale) {
+    m_scale = std::max(1, scale);
+    m_frameSize = frameSize;
+    m_reducedSize = cv::Size(frameSize.width / m_scale, frameSize.height / m_scale);
+
+    m_graySums.assign(m_reducedSize.width, 0);
+    m_colorSums.assign(m_reducedSize.width * 3, 0);
+    m_histogram.fill(0);
+    m_lut.create(1, 256, CV_8U);
+}
+
+void FramePreprocessor::process(const cv::Mat& bgr, VisionBufferPool& buffers, cv::Mat& preview) {
+    CV_Assert(bgr.type() == CV_8UC3 && bgr.size() == m_frameSize);
+    CV_Assert(preview.empty() || (preview.type() == CV_8UC3 && preview.size() == m_reducedSize));
+
+    cv::Mat& gray = buffers.gray();
+    cv::Mat& small = buffers.smallGray();
+
+    const int width = m_frameSize.width;
+    const int reducedWidth = m_reducedSize.width;
+    const int area = m_scale * m_scale;
+    const bool withPreview = !preview.empty();
+
+    m_histogram.fill(0);
+
+    for (int sy = 0; sy < m_reducedSize.height; ++sy) {
+        std::fill(m_graySums.begin(), m_graySums.end(), 0);
+        if (withPreview) {
+            std::fill(m_colorSums.begin(), m_colorSums.end(), 0);
+        }
+
+        for (int r = 0; r < m_scale; ++r) {
+            const int y = sy * m_scale + r;
+            const uchar* bgrRow = bgr.ptr<uchar>(y);
+            uchar* grayRow = gray.ptr<uchar>(y);
+
+            convertRowToGray(bgrRow, grayRow, width);
+
+            for (int sx = 0, x = 0; sx < reducedWidth; ++sx) {
+                int graySum = 0;
+                int b = 0, g = 0, rr = 0;
+                for (int k = 0; k < m_scale; ++k, ++x) {
+                    graySum += grayRow[x];
+                    b += bgrRow[3 * x];
+                    g += bgrRow[3 * x + 1];
+                    rr += bgrRow[3 * x + 2];
+                }
+                m_graySums[sx] += graySum;
+                if (withPreview) {
+                    m_colorSums[3 * sx] += b;
+                    m_colorSums[3 * sx + 1] += g;
+                    m_colorSums[3 * sx + 2] += rr;
+                }
+            }
+        }
+
+        uchar* smallRow = small.ptr<uchar>(sy);
+        for (int sx = 0; sx < reducedWidth; ++sx) {
+            uchar value = uchar((m_graySums[sx] + area / 2) / area);
+            smallRow[sx] = value;
+            m_histogram[value]++;
+        }
+
+        if (withPreview) {
+            uchar* previewRow = preview.ptr<uchar>(sy);
+            for (int i = 0; i < reducedWidth * 3; ++i) {
+                previewRow[i] = uchar((m_colorSums[i] + area / 2) / area);
+            }
+        }
+    }
+
+    for (int y = m_reducedSize.height * m_scale; y < m_frameSize.height; ++y) {
+        convertRowToGray(bgr.ptr<uchar>(y), gray.ptr<uchar>(y), width);
+    }
+
+    buildEqualizationLut();
+    cv::LUT(small, m_lut, buffers.detection());
+}
+
+void FramePreprocessor::convertRowToGray(const uchar* bgr, uchar* gray, int width) const {
+    int x = 0;
+
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    using namespace cv;
+
+    const int lanes = VTraits<v_uint8>::vlanes();
+    const v_uint16 weightB = vx_setall_u16(GRAY_WEIGHT_B);
+    const v_uint16 weightG = vx_setall_u16(GRAY_WEIGHT_G);
+    const v_uint16 weightR = vx_setall_u16(GRAY_WEIGHT_R);
+    const v_uint16 rounding = vx_setall_u16(128);
+
+    for (; x <= width - lanes; x += lanes) {
+        v_uint8 b, g, r;
+        v_load_deinterleave(bgr + 3 * x, b, g, r);
+
+        v_uint16 b0, b1, g0, g1, r0, r1;
+        v_expand(b, b0, b1);
+        v_expand(g, g0, g1);
+        v_expand(r, r0, r1);
+
+        v_uint16 y0 = v_add(v_add(v_mul_wrap(b0, weightB), v_mul_wrap(g0, weightG)),
+                            v_add(v_mul_wrap(r0, weightR), rounding));
+        v_uint16 y1 = v_add(v_add(v_mul_wrap(b1, weightB), v_mul_wrap(g1, weightG)),
+                            v_add(v_mul_wrap(r1, weightR), rounding));
+
+        v_store(gray + x, v_pack(v_shr<8>(y0), v_shr<8>(y1)));
+    }
+    vx_cleanup();
+#endif
+
+    for (; x < width; ++x) {
+        const uchar* p = bgr + 3 * x;
+        gray[x] = uchar((p[0] * GRAY_WEIGHT_B + p[1] * GRAY_WEIGHT_G + p[2] * GRAY_WEIGHT_R + 128) >> 8);
+    }
+}
+
+void FramePreprocessor::buildEqualizationLut() {
+    uchar* lut = m_lut.ptr<uchar>();
+    const int total = m_reducedSize.area();
+
+    int first = 0;
+    while (first < 256 && m_histogram[first] == 0) {
+        ++first;
+    }
+
+    if (first == 256 || m_histogram[first] == total) {
+        std::fill(lut, lut + 256, uchar(first == 256 ? 0 : first));
+        return;
+    }
+
+    const float scale = 255.0f / float(total - m_histogram[first]);
+    int sum = 0;
+
+    std::fill(lut, lut + first + 1, uchar(0));
+    for (int i = first + 1; i < 256; ++i) {
+        sum += m_histogram[i];
+        lut[i] = cv::saturate_cast<uchar>(sum * scale);
+    }
+}
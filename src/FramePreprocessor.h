@@ -0,0 +1,68 @@
+/**
+ * @file FramePreprocessor.h
+ * @brief Prétraitement des images de la webcam en une seule passe mémoire
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef FRAMEPREPROCESSOR_H
+#define FRAMEPREPROCESSOR_H
+
+#include <QSize>
+#include <opencv2/opencv.hpp>
+#include <array>
+#include <vector>
+
+class VisionBufferPool;
+
+/**
+ * @class FramePreprocessor
+ * @brief Noyau fusionné BGR → gris → réduction → égalisation
+ *
+ * L'image BGR est parcourue une seule fois, par bandes de quelques lignes qui
+ * restent en cache. Pour chaque bande, le noyau produit :
+ * - l'image en niveaux de gris pleine résolution (conversion vectorisée),
+ * - l'image de détection réduite et son histogramme,
+ * - l'aperçu BGR réduit du même facteur.
+ *
+ * L'égalisation n'est ensuite appliquée qu'à l'image réduite, par une table de
+ * correspondance calculée à partir de l'histogramme. Tous les consommateurs
+ * (détection, suivi, aperçu) partagent ces résultats.
+ */
+class FramePreprocessor {
+public:
+    /**
+     * @brief Prépare les tampons internes pour une taille d'image donnée
+     * @param frameSize Taille des images de la caméra
+     * @param scale Facteur de réduction de l'image de détection et de l'aperçu
+     */
+    void configure(const cv::Size& frameSize, int scale);
+
+    /**
+     * @brief Traite une image de la caméra
+     * @param bgr Image BGR capturée
+     * @param buffers Tampons recevant le gris pleine résolution et l'image de détection
+     * @param preview Aperçu BGR réduit à remplir (peut être vide)
+     */
+    void process(const cv::Mat& bgr, VisionBufferPool& buffers, cv::Mat& preview);
+
+    int scale() const { return m_scale; }
+    QSize reducedSize() const { return QSize(m_reducedSize.width, m_reducedSize.height); }
+    const std::array<int, 256>& histogram() const { return m_histogram; }
+    const cv::Mat& equalizationLut() const { return m_lut; }
+
+private:
+    void convertRowToGray(const uchar* bgr, uchar* gray, int width) const;
+    void buildEqualizationLut();
+
+    int m_scale = 1;
+    cv::Size m_frameSize;
+    cv::Size m_reducedSize;
+
+    std::vector<int> m_graySums;    ///< Sommes par bloc pour l'image réduite
+    std::vector<int> m_colorSums;   ///< Sommes par bloc pour l'aperçu BGR
+    std::array<int, 256> m_histogram{};
+    cv::Mat m_lut;                  ///< Table d'égalisation (1x256, CV_8U)
+};
+
+#endif
@@ -0,0 +1,40 @@
+#include "Frustum.h"
+#include <QDebug>
+
+Frustum::Frustum(const QMatrix4x4& viewProjection) {
+    setMatrix(viewProjection);
+}
+
+void Frustum::setMatrix(const QMatrix4x4& viewProjection) {
+    const QVector4D x = viewProjection.row(0);
+    const QVector4D y = viewProjection.row(1);
+    const QVector4D z = viewProjection.row(2);
+    const QVector4D w = viewProjection.row(3);
+
+    // Gauche, droite, bas, haut, proche, lointain
+    const QVector4D planes[6] = { w + x, w - x, w + y, w - y, w + z, w - z };
+
+    m_planeCount = 0;
+    for (const QVector4D& plane : planes) {
+        const float length = plane.toVector3D().length();
+        m_planes[m_planeCount++] = length > 0.0f ? plane / length : plane;
+    }
+}
+
+void Frustum::addPlane(const QVector3D& normal, float distance) {
+    if (m_planeCount >= MAX_PLANES) {
+        qWarning() << "Frustum plane limit reached, plane ignored";
+        return;
+    }
+    m_planes[m_planeCount++] = QVector4D(normal, distance);
+}
+
+bool Frustum::intersectsSphere(const QVector3D& center, float radius) const {
+    for (int i = 0; i < m_planeCount; ++i) {
+        const QVector4D& plane = m_planes[i];
+        if (QVector3D::dotProduct(plane.toVector3D(), center) + plane.w() < -radius) {
+            return false;
+        }
+    }
+    return true;
+}
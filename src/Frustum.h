@@ -0,0 +1,73 @@
+/**
+ * @file Frustum.h
+ * @brief Pyramide de vision utilisée pour écarter les objets hors champ
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <QMatrix4x4>
+#include <QVector3D>
+#include <QVector4D>
+#include <array>
+
+/**
+ * @struct CullingStats
+ * @brief Compteurs de l'élimination des objets dynamiques sur une image
+ */
+struct CullingStats {
+    int drawn = 0;            ///< Objets soumis à la passe couleur
+    int culled = 0;           ///< Objets hors du champ de la caméra
+    int shadowCasters = 0;    ///< Objets soumis à la passe d'ombre
+    int shadowCulled = 0;     ///< Objets hors du volume de la lumière
+};
+
+/**
+ * @class Frustum
+ * @brief Plans d'une matrice projection * vue et test des sphères englobantes
+ *
+ * Les six plans sont extraits directement des lignes de la matrice (méthode de
+ * Gribb et Hartmann). Des plans supplémentaires peuvent restreindre le volume,
+ * par exemple le sol de l'arène pour la passe d'ombre.
+ */
+class Frustum {
+public:
+    static constexpr int MAX_PLANES = 8;   ///< Six plans de la pyramide et deux plans libres
+
+    Frustum() = default;
+
+    /**
+     * @brief Construit la pyramide d'une matrice projection * vue
+     * @param viewProjection Matrice projection * vue
+     */
+    explicit Frustum(const QMatrix4x4& viewProjection);
+
+    /**
+     * @brief Remplace les plans par ceux d'une nouvelle matrice
+     * @param viewProjection Matrice projection * vue
+     */
+    void setMatrix(const QMatrix4x4& viewProjection);
+
+    /**
+     * @brief Ajoute un demi-espace : les points conservés vérifient normal·p + distance >= 0
+     * @param normal Normale du plan (normalisée)
+     * @param distance Distance signée à l'origine
+     */
+    void addPlane(const QVector3D& normal, float distance);
+
+    /**
+     * @brief Teste une sphère englobante
+     * @param center Centre de la sphère (espace monde)
+     * @param radius Rayon de la sphère
+     * @return false si la sphère est entièrement hors d'un des plans
+     */
+    bool intersectsSphere(const QVector3D& center, float radius) const;
+
+private:
+    std::array<QVector4D, MAX_PLANES> m_planes;
+    int m_planeCount = 0;
+};
+
+#endif
@@ -0,0 +1,288 @@
+#include "GameSimulation.h"
+#include <QRandomGenerator>
+#include <algorithm>
+#include <cmath>
+
+GameSimulation::GameSimulation(MeshUploadQueue* uploads, float cylinderRadius, float cylinderHeight)
+    : m_sliceJobs(uploads),
+      m_cylinderRadius(cylinderRadius),
+      m_cylinderHeight(cylinderHeight)
+{
+    m_fragmentHits.reserve(FragmentManager::MAX_FRAGMENTS);
+    moveToThread(&m_thread);
+    connect(&m_thread, &QThread::started, this, &GameSimulation::run);
+}
+
+GameSimulation::~GameSimulation() {
+    stop();
+}
+
+void GameSimulation::start() {
+    if (!m_thread.isRunning()) {
+        m_thread.start();
+    }
+}
+
+void GameSimulation::stop() {
+    if (!m_thread.isRunning()) return;
+
+    // Le minuteur appartient au thread de simulation : il doit y être détruit
+    QMetaObject::invokeMethod(this, [this]() {
+        delete m_timer;
+        m_timer = nullptr;
+    }, Qt::BlockingQueuedConnection);
+
+    m_thread.quit();
+    m_thread.wait();
+}
+
+qint64 GameSimulation::clock() {
+    static const QElapsedTimer reference = []() {
+        QElapsedTimer timer;
+        timer.start();
+        return timer;
+    }();
+    return reference.nsecsElapsed();
+}
+
+void GameSimulation::setHandPosition(const QVector3D& position) {
+    m_handPosition = position;
+    m_handSet = true;
+}
+
+void GameSimulation::resetGame() {
+    m_projectiles.clear();
+    m_fragments.clear();
+    m_recentBursts.clear();
+
+    m_gameTime = 0.0f;
+    m_lastSpawnTime = 0.0f;
+    m_simulationAccumulator = 0.0f;
+
+    m_isGameRunning = true;
+
+    publishSnapshot();
+}
+
+void GameSimulation::run() {
+    m_timer = new QTimer(this);
+    m_timer->setTimerType(Qt::PreciseTimer);
+    connect(m_timer, &QTimer::timeout, this, &GameSimulation::tick);
+
+    m_elapsedTimer.start();
+    publishSnapshot();
+    m_timer->start(int(SIMULATION_STEP * 1000.0f));
+}
+
+void GameSimulation::tick() {
+    const float deltaTime = std::min(m_elapsedTimer.nsecsElapsed() / 1e9f, MAX_FRAME_TIME);
+    m_elapsedTimer.restart();
+
+    m_simulationAccumulator += deltaTime;
+    if (m_simulationAccumulator < SIMULATION_STEP) return;
+
+    while (m_simulationAccumulator >= SIMULATION_STEP) {
+        stepSimulation();
+        m_simulationAccumulator -= SIMULATION_STEP;
+    }
+    publishSnapshot();
+}
+
+void GameSimulation::stepSimulation() {
+    m_gameTime += SIMULATION_STEP;
+    m_stepCount++;
+
+    // Aussi hors partie : un projectile figé doit rester immobile à l'écran
+    for (int i = 0; i < m_projectiles.size(); i++) {
+        m_projectiles[i].storePreviousState();
+    }
+    for (Projectile& fragment : m_fragments.fragments()) {
+        fragment.storePreviousState();
+    }
+
+    if (m_isGameRunning && m_gameTime - m_lastSpawnTime > m_spawnInterval) {
+        spawnProjectile();
+        m_lastSpawnTime = m_gameTime;
+    }
+
+    updateProjectiles(SIMULATION_STEP);
+
+    if (m_isGameRunning) {
+        checkCollisions();
+    }
+
+    // Les fragments créés pendant le pas rejoignent la simulation au pas suivant
+    m_fragments.commitPending();
+}
+
+void GameSimulation::publishSnapshot() {
+    SimulationSnapshot& snapshot = m_snapshots.writeBuffer();
+
+    snapshot.projectiles.clear();
+    for (const Projectile& projectile : m_projectiles) {
+        if (projectile.isActive()) {
+            snapshot.projectiles.push_back(projectile.state());
+        }
+    }
+    for (const Projectile& fragment : m_fragments.fragments()) {
+        if (fragment.isActive()) {
+            snapshot.projectiles.push_back(fragment.state());
+        }
+    }
+
+    // Le rendu peut sauter des états : chaque découpe reste publiée un moment, il ne lance que les nouvelles
+    m_recentBursts.erase(std::remove_if(m_recentBursts.begin(), m_recentBursts.end(),
+                                        [this](const JuiceBurst& burst) {
+                                            return burst.time < m_gameTime - BURST_RETENTION;
+                                        }),
+                         m_recentBursts.end());
+    snapshot.bursts = m_recentBursts;
+
+    snapshot.gameTime = m_gameTime;
+    snapshot.step = m_stepCount;
+    snapshot.publishedAt = clock();
+
+    m_snapshots.publish();
+}
+
+void GameSimulation::spawnProjectile() {
+    Projectile::Type type;
+    int typeRandom = QRandomGenerator::global()->bounded(5);
+
+    if (typeRandom == 0) {
+        type = Projectile::Type::BANANA;
+    } else if (typeRandom == 1) {
+        type = Projectile::Type::APPLE;
+    } else if (typeRandom == 2) {
+        type = Projectile::Type::ANANAS;
+    } else if (typeRandom == 3) {
+        type = Projectile::Type::FRAISE;
+    } else {
+        type = Projectile::Type::WOOD_CUBE;
+    }
+
+    float x = 0.0f;
+    float y = -0.5f;
+    float z = -7.0f;
+
+    float targetAngle = QRandomGenerator::global()->bounded(628) / 100.0f;
+    float targetHeight = QRandomGenerator::global()->bounded(-80, 80) / 100.0f * m_cylinderHeight/2;
+
+    float targetX = m_cylinderRadius * std::cos(targetAngle);
+    float targetY = targetHeight - 0.5f;
+    float targetZ = 2.5f + m_cylinderRadius * std::sin(targetAngle);
+
+    float dx = targetX - x;
+    float dz = targetZ - z;
+
+    float time = QRandomGenerator::global()->bounded(70, 100) / 100.0f;
+
+    float peakHeight = QRandomGenerator::global()->bounded(170, 270) / 100.0f;
+
+    float vx = dx / time;
+    float vy = (2.0f * peakHeight / time) + ((targetY - y) / time);
+    float vz = dz / time;
+
+    vx += QRandomGenerator::global()->bounded(-10, 10) / 100.0f;
+    vz += QRandomGenerator::global()->bounded(-10, 10) / 100.0f;
+
+    Projectile p(type, QVector3D(x, y, z), QVector3D(vx, vy, vz));
+    m_projectiles.append(p);
+}
+
+void GameSimulation::updateProjectiles(float deltaTime) {
+
+    if (!m_isGameRunning) return;
+
+    for (int i = 0; i < m_projectiles.size(); i++) {
+
+        m_projectiles[i].applyGravity(deltaTime * 0.8f);
+
+        float reducedDelta = deltaTime * 0.9f;
+        m_projectiles[i].update(reducedDelta);
+
+        QVector3D pos = m_projectiles[i].position();
+        if (!m_projectiles[i].isFragment() && pos.z() > 5.0f && pos.z() < 7.0f) {
+
+            m_isGameRunning = false;
+            m_projectiles[i].markForGameOver();
+            emit gameOver();
+            return;
+        }
+
+        if (!m_projectiles[i].isActive()) {
+            m_projectiles.removeAt(i);
+            i--;
+        }
+    }
+
+    for (Projectile& fragment : m_fragments.fragments()) {
+        fragment.applyGravity(deltaTime * 0.8f);
+        fragment.update(deltaTime * 0.9f);
+    }
+    m_fragments.removeInactive();
+}
+
+void GameSimulation::checkCollisions() {
+    if (!m_handSet) return;
+
+    QVector3D swordPosition = m_handPosition + QVector3D(0, -0.5f, 2.5f);
+
+    const float bladeRadius = 0.05f;
+    const float bladeHeight = 0.3f;
+
+    for (int i = 0; i < m_projectiles.size(); i++) {
+        if (m_projectiles[i].checkCollisionWithCylinder(bladeRadius, bladeHeight, swordPosition)) {
+            sliceProjectile(m_projectiles[i]);
+            m_projectiles.removeAt(i);
+            i--;
+        }
+    }
+
+    // Parcours décroissant : retirer i n'y ramène qu'un fragment déjà testé. Les découpes
+    // attendent la fin du parcours, car faire de la place déplace les fragments du tableau.
+    std::vector<Projectile>& fragments = m_fragments.fragments();
+    m_fragmentHits.clear();
+    for (int i = int(fragments.size()) - 1; i >= 0; i--) {
+        if (FragmentManager::canSlice(fragments[i])
+            && fragments[i].checkCollisionWithCylinder(bladeRadius, bladeHeight, swordPosition)) {
+            m_fragmentHits.push_back(fragments[i]);
+            m_fragments.removeAt(i);
+        }
+    }
+    for (Projectile& hit : m_fragmentHits) {
+        sliceProjectile(hit);
+    }
+}
+
+void GameSimulation::sliceProjectile(Projectile& projectile) {
+    const bool isOriginal = !projectile.isFragment();
+
+    JuiceBurst burst;
+    burst.time = m_gameTime;
+    burst.type = projectile.type();
+    burst.position = projectile.position();
+    burst.velocity = projectile.velocity();
+
+    std::vector<Projectile> fragments = projectile.slice();
+
+    if (!fragments.empty()) {
+        burst.sequence = ++m_burstSequence;
+        burst.sliceNormal = fragments.front().state().lastCut().normal;
+        m_recentBursts.push_back(burst);
+    }
+
+    for (const auto& fragment : fragments) {
+        requestFragmentMeshes(fragment);
+        m_fragments.add(fragment);
+    }
+
+    if (isOriginal) {
+        emit scoreIncreased();
+    }
+}
+
+void GameSimulation::requestFragmentMeshes(const Projectile& fragment) {
+    // Découpe, compactage et dépôt dans la file se font hors du pas de simulation
+    m_sliceJobs.submit(fragment.state());
+}
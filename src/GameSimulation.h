@@ -0,0 +1,197 @@
+/**
+ * @file GameSimulation.h
+ * @brief Simulation du jeu à pas fixe dans un thread dédié
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef GAMESIMULATION_H
+#define GAMESIMULATION_H
+
+#include <QObject>
+#include <QThread>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+#include <QVector3D>
+#include "FragmentManager.h"
+#include "JuiceParticles.h"
+#include "Projectile.h"
+#include "MeshUploadQueue.h"
+#include "SliceJobs.h"
+#include "TripleBuffer.h"
+#include <vector>
+
+/**
+ * @struct SimulationSnapshot
+ * @brief État complet et immuable publié après chaque pas de simulation
+ */
+struct SimulationSnapshot {
+    std::vector<Projectile::State> projectiles;   ///< Projectiles actifs
+    std::vector<JuiceBurst> bursts;               ///< Découpes récentes, republiées tant qu'elles ont moins de BURST_RETENTION
+    float gameTime = 0.0f;                        ///< Temps de jeu au dernier pas
+    qint64 publishedAt = 0;                       ///< Instant de publication (GameSimulation::clock)
+    quint64 step = 0;                             ///< Numéro du dernier pas
+};
+
+/**
+ * @class GameSimulation
+ * @brief Apparition, physique et collisions des projectiles, hors du thread de l'interface
+ *
+ * La simulation avance par pas fixes de SIMULATION_STEP dans son propre thread,
+ * si bien que le rendu ou une fenêtre modale ne ralentissent plus le jeu. Après
+ * chaque pas, l'état des projectiles est publié dans un triple tampon que le
+ * rendu lit sans verrou. Les maillages des fragments sont découpés par des
+ * tâches de fond (SliceJobs) et transmis au thread OpenGL par une
+ * MeshUploadQueue.
+ *
+ * Les méthodes publiques autres que latestSnapshot() et clock() sont à appeler
+ * par QMetaObject::invokeMethod ou par des connexions de signaux.
+ */
+class GameSimulation : public QObject {
+    Q_OBJECT
+
+public:
+    static constexpr float SIMULATION_STEP = 1.0f / 120.0f;   ///< Durée d'un pas de simulation (120 Hz)
+    static constexpr float MAX_FRAME_TIME = 0.25f;           ///< Temps rattrapé au plus par réveil
+    static constexpr float BURST_RETENTION = 0.25f;          ///< Durée de publication d'une découpe (images sautées par le rendu)
+
+    /**
+     * @brief Constructeur
+     * @param uploads File d'envoi des maillages de fragments (doit survivre à la simulation)
+     * @param cylinderRadius Rayon du cylindre parcouru par l'épée
+     * @param cylinderHeight Hauteur du cylindre parcouru par l'épée
+     */
+    GameSimulation(MeshUploadQueue* uploads, float cylinderRadius, float cylinderHeight);
+
+    /**
+     * @brief Destructeur : arrête le thread de simulation
+     */
+    ~GameSimulation();
+
+    /**
+     * @brief Démarre le thread de simulation
+     */
+    void start();
+
+    /**
+     * @brief Arrête le thread de simulation et attend sa fin
+     */
+    void stop();
+
+    /**
+     * @brief Dernier état publié (thread de rendu uniquement, sans verrou)
+     */
+    const SimulationSnapshot& latestSnapshot() { return m_snapshots.readBuffer(); }
+
+    /**
+     * @brief Horloge commune aux deux threads, en nanosecondes
+     */
+    static qint64 clock();
+
+public slots:
+    /**
+     * @brief Met à jour la position de la main utilisée pour les collisions
+     * @param position Position 3D de la main
+     */
+    void setHandPosition(const QVector3D& position);
+
+    /**
+     * @brief Réinitialise la partie (projectiles, temps, apparitions)
+     */
+    void resetGame();
+
+signals:
+    /**
+     * @brief Émis quand un projectile entier est tranché
+     */
+    void scoreIncreased();
+
+    /**
+     * @brief Émis quand un projectile atteint le joueur
+     */
+    void gameOver();
+
+private slots:
+    /**
+     * @brief Crée le minuteur dans le thread de simulation
+     */
+    void run();
+
+    /**
+     * @brief Rattrape le temps réel par pas fixes puis publie l'état
+     */
+    void tick();
+
+private:
+    /**
+     * @brief Exécute un pas fixe de simulation (apparition, physique, collisions)
+     */
+    void stepSimulation();
+
+    /**
+     * @brief Génère un nouveau projectile
+     *
+     * Crée un projectile avec une position et une vitesse aléatoires
+     */
+    void spawnProjectile();
+
+    /**
+     * @brief Met à jour la position et l'état des projectiles
+     * @param deltaTime Temps écoulé depuis la dernière mise à jour
+     *
+     * Applique la physique et supprime les projectiles inactifs
+     */
+    void updateProjectiles(float deltaTime);
+
+    /**
+     * @brief Vérifie les collisions entre l'épée et les projectiles
+     *
+     * Détecte si l'épée a touché un projectile et le découpe si c'est le cas. Un
+     * fragment n'est découpé que si FragmentManager::canSlice l'autorise.
+     */
+    void checkCollisions();
+
+    /**
+     * @brief Découpe un projectile touché : gerbe de jus, fragments et score
+     * @param projectile Projectile touché, rendu inactif ; l'appelant le retire de sa liste
+     */
+    void sliceProjectile(Projectile& projectile);
+
+    /**
+     * @brief Confie la construction des maillages d'un fragment aux tâches de découpe
+     */
+    void requestFragmentMeshes(const Projectile& fragment);
+
+    /**
+     * @brief Copie l'état des projectiles dans le triple tampon
+     */
+    void publishSnapshot();
+
+    QThread m_thread;                              ///< Thread de la simulation
+    QTimer* m_timer = nullptr;                     ///< Réveil périodique, créé dans le thread
+    QElapsedTimer m_elapsedTimer;                  ///< Temps réel depuis le dernier réveil
+    SliceJobs m_sliceJobs;                         ///< Découpe des fragments, déposés dans la file d'envoi
+    TripleBuffer<SimulationSnapshot> m_snapshots;  ///< États publiés pour le rendu
+
+    QVector<Projectile> m_projectiles;             ///< Projectiles entiers actifs
+    FragmentManager m_fragments;                   ///< Fragments, en nombre borné
+    std::vector<Projectile> m_fragmentHits;        ///< Fragments touchés pendant le pas, découpés après le parcours
+
+    std::vector<JuiceBurst> m_recentBursts;        ///< Découpes encore publiées
+    quint64 m_burstSequence = 0;                   ///< Numéro de la dernière découpe
+
+    QVector3D m_handPosition;                      ///< Position de la main (collisions)
+    bool m_handSet = false;                        ///< Indique si la position de la main est définie
+    float m_cylinderRadius;                        ///< Rayon du cylindre (épée)
+    float m_cylinderHeight;                        ///< Hauteur du cylindre (épée)
+
+    float m_gameTime = 0.0f;                       ///< Temps total de jeu en secondes
+    float m_simulationAccumulator = 0.0f;          ///< Temps réel pas encore simulé
+    quint64 m_stepCount = 0;                       ///< Nombre de pas exécutés
+    float m_lastSpawnTime = 0.0f;                  ///< Moment du dernier spawn de projectile
+    float m_spawnInterval = 2.0f;                  ///< Intervalle entre deux spawns de projectiles
+    bool m_isGameRunning = true;                   ///< Indique si le jeu est en cours
+};
+
+#endif
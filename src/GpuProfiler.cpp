@@ -0,0 +1,173 @@
+#include "GpuProfiler.h"
+#include <QOpenGLContext>
+#include <QDebug>
+#include <algorithm>
+
+#ifndef GL_TIME_ELAPSED
+#define GL_TIME_ELAPSED 0x88BF
+#endif
+
+bool GpuProfiler::initialize() {
+    initializeOpenGLFunctions();
+
+    QOpenGLContext* context = QOpenGLContext::currentContext();
+    m_supported = context && !context->isOpenGLES()
+                  && (context->format().version() >= qMakePair(3, 3) || context->hasExtension("GL_ARB_timer_query"));
+
+    if (!m_supported) {
+        qWarning("GPU timer queries unsupported, only CPU frame time is measured");
+        return false;
+    }
+
+    for (FrameQueries& frame : m_frames) {
+        glGenQueries(PASS_COUNT, frame.queries.data());
+    }
+    return true;
+}
+
+void GpuProfiler::destroy() {
+    if (!m_supported) return;
+
+    for (FrameQueries& frame : m_frames) {
+        glDeleteQueries(PASS_COUNT, frame.queries.data());
+        frame = FrameQueries();
+    }
+    m_supported = false;
+}
+
+void GpuProfiler::beginFrame() {
+    m_cpuTimer.start();
+    if (!m_supported) return;
+
+    m_current = (m_current + 1) % FRAME_LATENCY;
+    FrameQueries& frame = m_frames[m_current];
+    if (frame.pending) {
+        collect(frame);
+    }
+    frame.issued.fill(false);
+}
+
+void GpuProfiler::collect(FrameQueries& frame) {
+    frame.pending = false;
+
+    // Les requêtes se terminent dans l'ordre : la dernière émise suffit à savoir si tout est prêt
+    int last = -1;
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        if (frame.issued[pass]) {
+            last = pass;
+        }
+    }
+    if (last < 0) return;
+
+    GLuint available = 0;
+    glGetQueryObjectuiv(frame.queries[last], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+        m_droppedFrames++;
+        return;
+    }
+
+    float total = 0.0f;
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        if (!frame.issued[pass]) continue;
+
+        GLuint nanoseconds = 0;
+        glGetQueryObjectuiv(frame.queries[pass], GL_QUERY_RESULT, &nanoseconds);
+        const float milliseconds = nanoseconds / 1e6f;
+        m_passHistory[pass].add(milliseconds);
+        total += milliseconds;
+    }
+    m_gpuHistory.add(total);
+}
+
+void GpuProfiler::beginPass(Pass pass) {
+    if (!m_supported || m_openPass >= 0) return;
+
+    FrameQueries& frame = m_frames[m_current];
+    glBeginQuery(GL_TIME_ELAPSED, frame.queries[pass]);
+    frame.issued[pass] = true;
+    frame.pending = true;
+    m_openPass = pass;
+}
+
+void GpuProfiler::endPass() {
+    if (m_openPass < 0) return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    m_openPass = -1;
+}
+
+void GpuProfiler::endFrame() {
+    endPass();
+    m_cpuHistory.add(m_cpuTimer.nsecsElapsed() / 1e6f);
+}
+
+QStringList GpuProfiler::report() const {
+    auto line = [](const QString& label, const Stats& stats) {
+        return QString("%1 %2 ms (min %3, max %4)")
+            .arg(label, -12)
+            .arg(stats.average, 0, 'f', 2)
+            .arg(stats.minimum, 0, 'f', 2)
+            .arg(stats.maximum, 0, 'f', 2);
+    };
+
+    QStringList lines;
+    const Stats cpu = cpuStats();
+    lines << line("CPU frame", cpu);
+
+    if (!m_supported) {
+        lines << "GPU timings unavailable";
+        return lines;
+    }
+
+    for (int pass = 0; pass < PASS_COUNT; ++pass) {
+        lines << line(QString("GPU %1").arg(passName(Pass(pass))), passStats(Pass(pass)));
+    }
+    const Stats gpu = gpuStats();
+    lines << line("GPU total", gpu);
+
+    // Le côté le plus lent fixe la cadence : c'est lui qu'il faut optimiser
+    lines << QString("%1-bound, %2 samples dropped")
+                 .arg(gpu.average > cpu.average ? "GPU" : "CPU")
+                 .arg(m_droppedFrames);
+    return lines;
+}
+
+const char* GpuProfiler::passName(Pass pass) {
+    switch (pass) {
+    case PASS_SHADOW:
+        return "shadow";
+    case PASS_OPAQUE:
+        return "opaque";
+    case PASS_TRANSPARENT:
+        return "transparent";
+    case PASS_PARTICLES:
+        return "particles";
+    case PASS_COUNT:
+        break;
+    }
+    return "unknown";
+}
+
+void GpuProfiler::History::add(float value) {
+    values[next] = value;
+    next = (next + 1) % HISTORY;
+    count = std::min(count + 1, HISTORY);
+    ++total;
+}
+
+GpuProfiler::Stats GpuProfiler::History::stats() const {
+    Stats stats;
+    if (count == 0) return stats;
+
+    stats.minimum = values[0];
+    stats.maximum = values[0];
+    float sum = 0.0f;
+    for (int i = 0; i < count; ++i) {
+        sum += values[i];
+        stats.minimum = std::min(stats.minimum, values[i]);
+        stats.maximum = std::max(stats.maximum, values[i]);
+    }
+    stats.average = sum / count;
+    stats.samples = count;
+    return stats;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file GpuProfiler.h
+ * @brief Mesure du temps GPU de chaque passe de rendu par requêtes de minutage
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef GPUPROFILER_H
+#define GPUPROFILER_H
+
+#include <QOpenGLExtraFunctions>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <array>
+
+/**
+ * @class GpuProfiler
+ * @brief Paires de requêtes GL_TIME_ELAPSED autour des passes et statistiques glissantes
+ *
+ * Chaque passe est encadrée par une requête de minutage. Les requêtes d'une
+ * image sont lues FRAME_LATENCY images plus tard, une fois le GPU passé : si le
+ * résultat n'est pas encore disponible, l'échantillon est abandonné plutôt que
+ * de bloquer le rendu. Le temps CPU de préparation de l'image est mesuré en
+ * parallèle pour distinguer les images limitées par le CPU de celles limitées
+ * par le GPU.
+ */
+class GpuProfiler : protected QOpenGLExtraFunctions {
+public:
+    /**
+     * @brief Passes mesurées, dans l'ordre d'exécution
+     */
+    enum Pass {
+        PASS_SHADOW = 0,     ///< Carte d'ombre
+        PASS_OPAQUE,         ///< Effacement et objets opaques (arène, épée, projectiles)
+        PASS_TRANSPARENT,    ///< Objets translucides
+        PASS_PARTICLES,      ///< Simulation (transform feedback) et tracé des gerbes de jus
+        PASS_COUNT
+    };
+
+    static constexpr int FRAME_LATENCY = 2;   ///< Jeux de requêtes en vol
+    static constexpr int HISTORY = 120;       ///< Images couvertes par les statistiques
+
+    /**
+     * @struct Stats
+     * @brief Statistiques d'une mesure sur les HISTORY dernières images (ms)
+     */
+    struct Stats {
+        float average = 0.0f;
+        float minimum = 0.0f;
+        float maximum = 0.0f;
+        int samples = 0;
+    };
+
+    GpuProfiler() = default;
+    ~GpuProfiler() = default;
+
+    GpuProfiler(const GpuProfiler&) = delete;
+    GpuProfiler& operator=(const GpuProfiler&) = delete;
+
+    /**
+     * @brief Crée les requêtes si le contexte les prend en charge (contexte courant requis)
+     * @return true si les temps GPU sont disponibles ; le temps CPU est mesuré dans tous les cas
+     */
+    bool initialize();
+
+    /**
+     * @brief Libère les requêtes (contexte courant requis)
+     */
+    void destroy();
+
+    /**
+     * @brief Démarre une image : relève sans attendre les résultats du jeu de requêtes réutilisé
+     */
+    void beginFrame();
+
+    /**
+     * @brief Ouvre la mesure d'une passe (une seule passe ouverte à la fois)
+     */
+    void beginPass(Pass pass);
+
+    /**
+     * @brief Ferme la mesure de la passe ouverte
+     */
+    void endPass();
+
+    /**
+     * @brief Termine une image et enregistre son temps CPU
+     */
+    void endFrame();
+
+    bool isSupported() const { return m_supported; }
+    Stats passStats(Pass pass) const { return m_passHistory[pass].stats(); }
+    Stats gpuStats() const { return m_gpuHistory.stats(); }
+    float latestGpuTime() const { return m_gpuHistory.latest(); }       ///< Dernière image relevée (ms)
+    quint64 gpuSampleCount() const { return m_gpuHistory.total; }       ///< Images relevées depuis le début
+    Stats cpuStats() const { return m_cpuHistory.stats(); }
+    int droppedFrames() const { return m_droppedFrames; }
+
+    /**
+     * @brief Résumé lisible des statistiques, une ligne par mesure
+     */
+    QStringList report() const;
+
+    static const char* passName(Pass pass);
+
+private:
+    /**
+     * @struct History
+     * @brief Tampon circulaire des dernières valeurs d'une mesure
+     */
+    struct History {
+        std::array<float, HISTORY> values{};
+        int count = 0;
+        int next = 0;
+        quint64 total = 0;          ///< Valeurs ajoutées depuis le début
+
+        void add(float value);
+        Stats stats() const;
+        float latest() const { return count > 0 ? values[(next + HISTORY - 1) % HISTORY] : 0.0f; }
+    };
+
+    /**
+     * @struct FrameQueries
+     * @brief Requêtes d'une image en vol
+     */
+    struct FrameQueries {
+        std::array<GLuint, PASS_COUNT> queries{};
+        std::array<bool, PASS_COUNT> issued{};
+        bool pending = false;
+    };
+
+    void collect(FrameQueries& frame);
+
+    bool m_supported = false;
+    std::array<FrameQueries, FRAME_LATENCY> m_frames;
+    int m_current = 0;                            ///< Jeu de requêtes de l'image en cours
+    int m_openPass = -1;                          ///< Passe mesurée en ce moment (-1 : aucune)
+    int m_droppedFrames = 0;                      ///< Résultats pas encore prêts, abandonnés
+
+    QElapsedTimer m_cpuTimer;
+    std::array<History, PASS_COUNT> m_passHistory;
+    History m_gpuHistory;                         ///< Somme des passes
+    History m_cpuHistory;                         ///< Préparation et soumission de l'image
+};
+
+#endif
@@ -0,0 +1,78 @@
+#include "ImagePyramid.h"
+#include <cmath>
+
+void ImagePyramid::configure(const cv::Size& baseSize, double scaleFactor, const cv::Size& minSize, int maxLevels) {
+    CV_Assert(scaleFactor > 1.0);
+
+    m_baseSize = baseSize;
+    m_scaleFactor = scaleFactor;
+    m_octaveLevel = -1;
+
+    m_scales.clear();
+    m_sizes.clear();
+
+    double scale = 1.0;
+    for (int i = 0; i < maxLevels; ++i, scale *= scaleFactor) {
+        cv::Size size(cvRound(baseSize.width / scale), cvRound(baseSize.height / scale));
+        if (size.width < minSize.width || size.height < minSize.height) {
+            break;
+        }
+
+        if (std::abs(scale - 2.0) < 1e-3) {
+            m_octaveLevel = i;
+            size = cv::Size(baseSize.width / 2, baseSize.height / 2);
+        }
+
+        m_scales.push_back(scale);
+        m_sizes.push_back(size);
+    }
+
+    const size_t count = m_scales.size();
+    m_storage.resize(count);
+    m_levels.resize(count);
+    m_equalizedStorage.resize(count);
+    m_equalized.resize(count);
+
+    for (size_t i = 1; i < count; ++i) {
+        m_storage[i].create(m_sizes[i], CV_8UC1);
+        m_equalizedStorage[i].create(m_sizes[i], CV_8UC1);
+    }
+    if (count > 0) {
+        m_equalizedStorage[0].create(m_sizes[0], CV_8UC1);
+    }
+}
+
+void ImagePyramid::build(const cv::Mat& gray, const cv::Mat& octave) {
+    CV_Assert(gray.type() == CV_8UC1 && gray.size() == m_baseSize);
+
+    for (int i = 0; i < levelCount(); ++i) {
+        if (i == 0) {
+            m_levels[i] = gray;
+        } else if (i == m_octaveLevel && octave.size() == m_sizes[i]) {
+            m_levels[i] = octave;
+        } else {
+            cv::resize(m_levels[i - 1], m_storage[i], m_sizes[i], 0, 0, cv::INTER_LINEAR);
+            m_levels[i] = m_storage[i];
+        }
+    }
+}
+
+void ImagePyramid::equalize(const cv::Mat& lut, int firstLevel, const cv::Mat& equalizedOctave) {
+    for (int i = firstLevel; i < levelCount(); ++i) {
+        if (i == m_octaveLevel && equalizedOctave.size() == m_sizes[i]) {
+            m_equalized[i] = equalizedOctave;
+        } else {
+            cv::LUT(m_levels[i], lut, m_equalizedStorage[i]);
+            m_equalized[i] = m_equalizedStorage[i];
+        }
+    }
+}
+
+int ImagePyramid::firstLevelAtScale(double minScale) const {
+    for (int i = 0; i < levelCount(); ++i) {
+        if (m_scales[i] >= minScale - 1e-3) {
+            return i;
+        }
+    }
+    return levelCount();
+}
@@ -0,0 +1,85 @@
+/**
+ * @file ImagePyramid.h
+ * @brief Pyramide d'images partagée par la détection et le suivi de la paume
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef IMAGEPYRAMID_H
+#define IMAGEPYRAMID_H
+
+#include <opencv2/opencv.hpp>
+#include <vector>
+
+/**
+ * @class ImagePyramid
+ * @brief Pyramide en niveaux de gris construite une seule fois par image
+ *
+ * La cascade de Haar et l'extracteur ORB construisaient chacun leur propre
+ * pyramide sur la même image. Celle-ci est construite une fois à partir de
+ * l'image en niveaux de gris du prétraitement, puis parcourue niveau par niveau
+ * par les deux consommateurs.
+ *
+ * Lorsqu'un niveau correspond exactement à une réduction d'un facteur 2, l'image
+ * réduite déjà produite par le prétraitement est réutilisée au lieu d'être
+ * recalculée. Les niveaux utilisés par la cascade peuvent en outre être égalisés
+ * avec la table d'égalisation partagée.
+ */
+class ImagePyramid {
+public:
+    /**
+     * @brief Dimensionne les niveaux de la pyramide
+     * @param baseSize Taille du niveau 0 (image pleine résolution)
+     * @param scaleFactor Rapport de taille entre deux niveaux successifs (> 1)
+     * @param minSize Taille en dessous de laquelle on s'arrête
+     * @param maxLevels Nombre maximal de niveaux
+     */
+    void configure(const cv::Size& baseSize, double scaleFactor, const cv::Size& minSize, int maxLevels = 32);
+
+    /**
+     * @brief Indique si la pyramide est dimensionnée pour cette taille d'image
+     */
+    bool isConfiguredFor(const cv::Size& baseSize) const { return !m_scales.empty() && baseSize == m_baseSize; }
+
+    /**
+     * @brief Construit les niveaux à partir d'une image en niveaux de gris
+     * @param gray Image pleine résolution (CV_8UC1), référencée sans copie comme niveau 0
+     * @param octave Image déjà réduite d'un facteur 2 (facultative), réutilisée pour le niveau correspondant
+     */
+    void build(const cv::Mat& gray, const cv::Mat& octave = cv::Mat());
+
+    /**
+     * @brief Égalise les niveaux à partir de firstLevel
+     * @param lut Table d'égalisation (1x256, CV_8U)
+     * @param firstLevel Premier niveau à égaliser
+     * @param equalizedOctave Version déjà égalisée de l'image octave passée à build() (facultative)
+     */
+    void equalize(const cv::Mat& lut, int firstLevel, const cv::Mat& equalizedOctave = cv::Mat());
+
+    /**
+     * @brief Premier niveau dont le facteur de réduction atteint minScale
+     * @return Index du niveau, ou levelCount() s'il n'y en a aucun
+     */
+    int firstLevelAtScale(double minScale) const;
+
+    int levelCount() const { return int(m_scales.size()); }
+    const cv::Mat& level(int index) const { return m_levels[index]; }
+    const cv::Mat& equalizedLevel(int index) const { return m_equalized[index]; }
+    double scale(int index) const { return m_scales[index]; }
+    double scaleFactor() const { return m_scaleFactor; }
+    const cv::Size& baseSize() const { return m_baseSize; }
+
+private:
+    cv::Size m_baseSize;
+    double m_scaleFactor = 1.2;
+    int m_octaveLevel = -1;             ///< Niveau de facteur 2, s'il existe
+
+    std::vector<double> m_scales;       ///< Facteur de réduction de chaque niveau
+    std::vector<cv::Size> m_sizes;
+    std::vector<cv::Mat> m_storage;     ///< Mémoire propre à chaque niveau
+    std::vector<cv::Mat> m_levels;      ///< En-têtes des niveaux (propres ou partagés)
+    std::vector<cv::Mat> m_equalizedStorage;
+    std::vector<cv::Mat> m_equalized;
+};
+
+#endif
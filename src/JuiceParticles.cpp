@@ -0,0 +1,335 @@
+#include "JuiceParticles.h"
+#include <QVector4D>
+#include <QDebug>
+#include <algorithm>
+
+namespace {
+
+// Particule : position + vie restante, vitesse + taille, couleur (3 x vec4)
+constexpr int PARTICLE_FLOATS = 12;
+
+const char* UPDATE_VERTEX_SOURCE = R"(
+#version 330 core
+layout(location = 0) in vec4 positionLife;
+layout(location = 1) in vec4 velocitySize;
+layout(location = 2) in vec4 color;
+
+out vec4 outPositionLife;
+out vec4 outVelocitySize;
+out vec4 outColor;
+
+const int MAX_EMITTERS = 8;
+uniform int emitterCount;
+uniform vec4 emitterPosition[MAX_EMITTERS];
+uniform vec4 emitterVelocity[MAX_EMITTERS];
+uniform vec4 emitterNormal[MAX_EMITTERS];
+uniform vec4 emitterColor[MAX_EMITTERS];
+uniform ivec2 emitterRange[MAX_EMITTERS];   // premier indice dans l'anneau, nombre de particules
+uniform int particleCount;
+uniform uint seed;
+uniform float deltaTime;
+uniform float groundLevel;
+
+const float GRAVITY = 6.0;
+const float DRAG = 1.5;
+
+uint hash(uint x) {
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+float random(inout uint state) {
+    state = hash(state);
+    return float(state) * (1.0 / 4294967296.0);
+}
+
+void main() {
+    vec4 p = positionLife;
+    vec4 v = velocitySize;
+    vec4 c = color;
+    uint id = uint(gl_VertexID);
+    bool spawned = false;
+
+    for (int e = 0; e < emitterCount; ++e) {
+        uint offset = (id + uint(particleCount - emitterRange[e].x)) % uint(particleCount);
+        if (offset < uint(emitterRange[e].y)) {
+            uint state = hash(id ^ seed);
+
+            // Direction uniforme sur la sphère, poussée de part et d'autre du plan de coupe
+            float z = random(state) * 2.0 - 1.0;
+            float angle = random(state) * 6.2831853;
+            float r = sqrt(1.0 - z * z);
+            float side = (offset & 1u) == 0u ? 1.0 : -1.0;
+            vec3 direction = normalize(vec3(r * cos(angle), r * sin(angle), z) + emitterNormal[e].xyz * side * 1.5);
+
+            p.xyz = emitterPosition[e].xyz + direction * 0.03;
+            p.w = mix(0.5, 1.2, random(state));
+            v.xyz = emitterVelocity[e].xyz * 0.3 + direction * mix(0.8, 3.0, random(state)) + vec3(0.0, 0.8, 0.0);
+            v.w = mix(0.008, 0.025, random(state));
+            c = vec4(emitterColor[e].rgb * mix(0.75, 1.15, random(state)), 1.0);
+            spawned = true;
+        }
+    }
+
+    if (!spawned && p.w > 0.0) {
+        v.y -= GRAVITY * deltaTime;
+        v.xyz *= max(0.0, 1.0 - DRAG * deltaTime);
+        p.xyz += v.xyz * deltaTime;
+        p.w -= deltaTime;
+
+        if (p.y < groundLevel) {
+            p.y = groundLevel;
+            v.xyz *= vec3(0.3, -0.2, 0.3);
+        }
+    }
+
+    outPositionLife = p;
+    outVelocitySize = v;
+    outColor = c;
+}
+)";
+
+const char* DRAW_VERTEX_SOURCE = R"(
+#version 330 core
+layout(location = 0) in vec2 corner;
+layout(location = 1) in vec4 positionLife;
+layout(location = 2) in vec4 velocitySize;
+layout(location = 3) in vec4 color;
+
+uniform mat4 viewMatrix;
+uniform mat4 projectionMatrix;
+
+out vec2 vCorner;
+out vec4 vColor;
+
+void main() {
+    vCorner = corner;
+    if (positionLife.w <= 0.0) {
+        // Particule morte : quad dégénéré hors du volume de vue
+        gl_Position = vec4(2.0, 2.0, 2.0, 1.0);
+        vColor = vec4(0.0);
+        return;
+    }
+
+    vec4 viewPosition = viewMatrix * vec4(positionLife.xyz, 1.0);
+    viewPosition.xy += corner * velocitySize.w;
+    gl_Position = projectionMatrix * viewPosition;
+    vColor = vec4(color.rgb, color.a * clamp(positionLife.w / 0.25, 0.0, 1.0));
+}
+)";
+
+const char* DRAW_FRAGMENT_SOURCE = R"(
+#version 330 core
+in vec2 vCorner;
+in vec4 vColor;
+
+out vec4 fragColor;
+
+void main() {
+    float d = dot(vCorner, vCorner);
+    if (d > 1.0) discard;
+    fragColor = vec4(vColor.rgb * (1.0 - 0.35 * d), vColor.a * (1.0 - d * d));
+}
+)";
+
+}
+
+bool JuiceParticles::initialize() {
+    initializeOpenGLFunctions();
+
+    m_updateProgram = new QOpenGLShaderProgram;
+    m_updateProgram->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, UPDATE_VERTEX_SOURCE);
+    // Les sorties capturées doivent être déclarées avant l'édition de liens
+    const char* varyings[] = { "outPositionLife", "outVelocitySize", "outColor" };
+    glTransformFeedbackVaryings(m_updateProgram->programId(), 3, varyings, GL_INTERLEAVED_ATTRIBS);
+    if (!m_updateProgram->link()) {
+        qWarning() << "Particle update shader failed to link:" << m_updateProgram->log();
+        destroy();
+        return false;
+    }
+
+    m_drawProgram = new QOpenGLShaderProgram;
+    m_drawProgram->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, DRAW_VERTEX_SOURCE);
+    m_drawProgram->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, DRAW_FRAGMENT_SOURCE);
+    if (!m_drawProgram->link()) {
+        qWarning() << "Particle draw shader failed to link:" << m_drawProgram->log();
+        destroy();
+        return false;
+    }
+
+    m_emitterCountLocation = m_updateProgram->uniformLocation("emitterCount");
+    m_emitterPositionLocation = m_updateProgram->uniformLocation("emitterPosition");
+    m_emitterVelocityLocation = m_updateProgram->uniformLocation("emitterVelocity");
+    m_emitterNormalLocation = m_updateProgram->uniformLocation("emitterNormal");
+    m_emitterColorLocation = m_updateProgram->uniformLocation("emitterColor");
+    m_emitterRangeLocation = m_updateProgram->uniformLocation("emitterRange");
+    m_seedLocation = m_updateProgram->uniformLocation("seed");
+
+    // Vie nulle partout : toutes les particules sont mortes au départ
+    const std::vector<GLfloat> empty(size_t(MAX_PARTICLES) * PARTICLE_FLOATS, 0.0f);
+    const GLsizei stride = PARTICLE_FLOATS * sizeof(GLfloat);
+
+    const GLfloat corners[] = { -1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f };
+    glGenBuffers(1, &m_cornerBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, m_cornerBuffer);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+
+    glGenBuffers(2, m_buffers.data());
+    glGenVertexArrays(2, m_updateVaos.data());
+    glGenVertexArrays(2, m_drawVaos.data());
+
+    for (int i = 0; i < 2; ++i) {
+        glBindBuffer(GL_ARRAY_BUFFER, m_buffers[i]);
+        glBufferData(GL_ARRAY_BUFFER, GLsizeiptr(empty.size() * sizeof(GLfloat)), empty.data(), GL_DYNAMIC_COPY);
+
+        glBindVertexArray(m_updateVaos[i]);
+        for (GLuint attribute = 0; attribute < 3; ++attribute) {
+            glEnableVertexAttribArray(attribute);
+            glVertexAttribPointer(attribute, 4, GL_FLOAT, GL_FALSE, stride,
+                                  reinterpret_cast<void*>(attribute * 4 * sizeof(GLfloat)));
+        }
+
+        glBindVertexArray(m_drawVaos[i]);
+        glBindBuffer(GL_ARRAY_BUFFER, m_cornerBuffer);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+
+        glBindBuffer(GL_ARRAY_BUFFER, m_buffers[i]);
+        for (GLuint attribute = 1; attribute < 4; ++attribute) {
+            glEnableVertexAttribArray(attribute);
+            glVertexAttribPointer(attribute, 4, GL_FLOAT, GL_FALSE, stride,
+                                  reinterpret_cast<void*>((attribute - 1) * 4 * sizeof(GLfloat)));
+            glVertexAttribDivisor(attribute, 1);
+        }
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    return true;
+}
+
+void JuiceParticles::destroy() {
+    if (m_buffers[0]) {
+        glDeleteVertexArrays(2, m_updateVaos.data());
+        glDeleteVertexArrays(2, m_drawVaos.data());
+        glDeleteBuffers(2, m_buffers.data());
+        glDeleteBuffers(1, &m_cornerBuffer);
+        m_updateVaos.fill(0);
+        m_drawVaos.fill(0);
+        m_buffers.fill(0);
+        m_cornerBuffer = 0;
+    }
+    delete m_updateProgram;
+    m_updateProgram = nullptr;
+    delete m_drawProgram;
+    m_drawProgram = nullptr;
+    m_pending.clear();
+}
+
+void JuiceParticles::launch(const std::vector<JuiceBurst>& bursts) {
+    for (const JuiceBurst& burst : bursts) {
+        if (burst.sequence <= m_lastSequence) continue;
+        m_lastSequence = burst.sequence;
+
+        m_pending.push_back({ burst, m_nextParticle });
+        m_nextParticle = (m_nextParticle + PARTICLES_PER_BURST) % MAX_PARTICLES;
+    }
+
+    // Plus de gerbes en attente que l'anneau n'en contient : les plus anciennes seraient écrasées
+    const size_t capacity = MAX_PARTICLES / PARTICLES_PER_BURST;
+    if (m_pending.size() > capacity) {
+        m_pending.erase(m_pending.begin(), m_pending.end() - capacity);
+    }
+}
+
+void JuiceParticles::update(float deltaTime, float groundLevel) {
+    if (!m_updateProgram || !isActive()) return;
+
+    m_clock += deltaTime;
+
+    const int emitterCount = std::min(int(m_pending.size()), MAX_EMITTERS);
+    QVector4D positions[MAX_EMITTERS];
+    QVector4D velocities[MAX_EMITTERS];
+    QVector4D normals[MAX_EMITTERS];
+    QVector4D colors[MAX_EMITTERS];
+    GLint ranges[MAX_EMITTERS * 2];
+    for (int e = 0; e < emitterCount; ++e) {
+        const JuiceBurst& burst = m_pending[e].burst;
+        positions[e] = QVector4D(burst.position, 1.0f);
+        velocities[e] = QVector4D(burst.velocity, 0.0f);
+        normals[e] = QVector4D(burst.sliceNormal, 0.0f);
+        colors[e] = QVector4D(juiceColor(burst.type), 1.0f);
+        ranges[e * 2] = m_pending[e].firstParticle;
+        ranges[e * 2 + 1] = PARTICLES_PER_BURST;
+    }
+    if (emitterCount > 0) {
+        m_pending.erase(m_pending.begin(), m_pending.begin() + emitterCount);
+        m_aliveUntil = m_clock + MAX_LIFETIME;
+    }
+
+    m_updateProgram->bind();
+    m_updateProgram->setUniformValue(m_emitterCountLocation, emitterCount);
+    if (emitterCount > 0) {
+        m_updateProgram->setUniformValueArray(m_emitterPositionLocation, positions, emitterCount);
+        m_updateProgram->setUniformValueArray(m_emitterVelocityLocation, velocities, emitterCount);
+        m_updateProgram->setUniformValueArray(m_emitterNormalLocation, normals, emitterCount);
+        m_updateProgram->setUniformValueArray(m_emitterColorLocation, colors, emitterCount);
+        glUniform2iv(m_emitterRangeLocation, emitterCount, ranges);
+    }
+    m_updateProgram->setUniformValue("particleCount", MAX_PARTICLES);
+    m_updateProgram->setUniformValue("deltaTime", deltaTime);
+    m_updateProgram->setUniformValue("groundLevel", groundLevel);
+    glUniform1ui(m_seedLocation, m_seed);
+    m_seed = m_seed * 1664525u + 1013904223u;
+
+    // Lecture du tampon courant, écriture dans l'autre, sans rastérisation
+    const int next = 1 - m_current;
+    glEnable(GL_RASTERIZER_DISCARD);
+    glBindVertexArray(m_updateVaos[m_current]);
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, m_buffers[next]);
+    glBeginTransformFeedback(GL_POINTS);
+    glDrawArrays(GL_POINTS, 0, MAX_PARTICLES);
+    glEndTransformFeedback();
+    glBindBufferBase(GL_TRANSFORM_FEEDBACK_BUFFER, 0, 0);
+    glBindVertexArray(0);
+    glDisable(GL_RASTERIZER_DISCARD);
+    m_updateProgram->release();
+
+    m_current = next;
+}
+
+void JuiceParticles::draw(const QMatrix4x4& view, const QMatrix4x4& projection) {
+    if (!m_drawProgram || m_clock >= m_aliveUntil) return;
+
+    m_drawProgram->bind();
+    m_drawProgram->setUniformValue("viewMatrix", view);
+    m_drawProgram->setUniformValue("projectionMatrix", projection);
+
+    glDepthMask(GL_FALSE);
+    glBindVertexArray(m_drawVaos[m_current]);
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, MAX_PARTICLES);
+    glBindVertexArray(0);
+    glDepthMask(GL_TRUE);
+
+    m_drawProgram->release();
+}
+
+QVector3D JuiceParticles::juiceColor(Projectile::Type type) {
+    switch (type) {
+    case Projectile::Type::BANANA:
+        return QVector3D(1.0f, 0.95f, 0.6f);
+    case Projectile::Type::APPLE:
+        return QVector3D(0.9f, 0.95f, 0.55f);
+    case Projectile::Type::ANANAS:
+        return QVector3D(1.0f, 0.85f, 0.2f);
+    case Projectile::Type::FRAISE:
+        return QVector3D(0.85f, 0.05f, 0.1f);
+    case Projectile::Type::WOOD_CUBE:
+        return QVector3D(0.45f, 0.3f, 0.15f);
+    }
+    return QVector3D(1.0f, 1.0f, 1.0f);
+}
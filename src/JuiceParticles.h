@@ -0,0 +1,126 @@
+/**
+ * @file JuiceParticles.h
+ * @brief Gerbes de jus lors des découpes, simulées entièrement sur le GPU
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef JUICEPARTICLES_H
+#define JUICEPARTICLES_H
+
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLShaderProgram>
+#include <QMatrix4x4>
+#include <QVector3D>
+#include "Projectile.h"
+#include <array>
+#include <vector>
+
+/**
+ * @struct JuiceBurst
+ * @brief Découpe publiée par la simulation, source d'une gerbe de particules
+ */
+struct JuiceBurst {
+    quint64 sequence = 0;                          ///< Numéro croissant : chaque gerbe n'est lancée qu'une fois
+    float time = 0.0f;                             ///< Temps de jeu de la découpe
+    Projectile::Type type = Projectile::Type::APPLE;
+    QVector3D position;                            ///< Point de coupe
+    QVector3D velocity;                            ///< Vitesse du projectile tranché
+    QVector3D sliceNormal;                         ///< Normale du plan de coupe
+};
+
+/**
+ * @class JuiceParticles
+ * @brief Système de particules résident sur le GPU (transform feedback)
+ *
+ * Les particules vivent dans deux tampons utilisés en alternance : à chaque
+ * image, un vertex shader lit l'un, fait naître les particules des nouvelles
+ * gerbes, intègre les autres (gravité, frottement, rebond sur le sol) et écrit
+ * le résultat dans l'autre par transform feedback, sans rastérisation. Les
+ * particules sont ensuite tracées en un seul appel, comme des quads instanciés
+ * orientés vers la caméra. Le CPU ne fournit que quelques uniformes par gerbe :
+ * positions et directions initiales sont tirées dans le shader.
+ */
+class JuiceParticles : protected QOpenGLExtraFunctions {
+public:
+    static constexpr int MAX_PARTICLES = 32768;        ///< Taille de l'anneau de particules
+    static constexpr int PARTICLES_PER_BURST = 2048;   ///< Particules lancées par découpe
+    static constexpr int MAX_EMITTERS = 8;             ///< Gerbes lancées au plus par image
+    static constexpr float MAX_LIFETIME = 1.2f;        ///< Durée de vie maximale d'une particule (s)
+
+    JuiceParticles() = default;
+
+    JuiceParticles(const JuiceParticles&) = delete;
+    JuiceParticles& operator=(const JuiceParticles&) = delete;
+
+    /**
+     * @brief Crée les shaders et les tampons (contexte courant requis)
+     * @return false si un shader ne compile pas
+     */
+    bool initialize();
+
+    /**
+     * @brief Libère les shaders et les tampons (contexte courant requis)
+     */
+    void destroy();
+
+    /**
+     * @brief Retient les gerbes pas encore lancées
+     * @param bursts Gerbes récentes publiées par la simulation
+     */
+    void launch(const std::vector<JuiceBurst>& bursts);
+
+    /**
+     * @brief Fait naître et avance les particules (passe de transform feedback)
+     * @param deltaTime Temps écoulé depuis l'image précédente (s)
+     * @param groundLevel Hauteur du sol, où les gouttes rebondissent
+     */
+    void update(float deltaTime, float groundLevel);
+
+    /**
+     * @brief Trace les particules vivantes (mélange alpha, sans écriture de profondeur)
+     */
+    void draw(const QMatrix4x4& view, const QMatrix4x4& projection);
+
+    /**
+     * @brief Indique si des particules peuvent encore être vivantes
+     */
+    bool isActive() const { return m_clock < m_aliveUntil || !m_pending.empty(); }
+
+private:
+    /**
+     * @struct Emitter
+     * @brief Gerbe en attente de lancement et sa plage dans l'anneau
+     */
+    struct Emitter {
+        JuiceBurst burst;
+        int firstParticle = 0;
+    };
+
+    static QVector3D juiceColor(Projectile::Type type);
+
+    QOpenGLShaderProgram* m_updateProgram = nullptr;   ///< Simulation (vertex shader seul, transform feedback)
+    QOpenGLShaderProgram* m_drawProgram = nullptr;     ///< Quads orientés vers la caméra
+    std::array<GLuint, 2> m_buffers{};                 ///< Particules, lues et écrites en alternance
+    std::array<GLuint, 2> m_updateVaos{};              ///< Lecture de chaque tampon par la simulation
+    std::array<GLuint, 2> m_drawVaos{};                ///< Coins du quad et tampon lu par instance
+    GLuint m_cornerBuffer = 0;
+    int m_current = 0;                                 ///< Tampon contenant l'état courant
+
+    std::vector<Emitter> m_pending;                    ///< Gerbes à lancer aux prochaines mises à jour
+    quint64 m_lastSequence = 0;                        ///< Dernière gerbe retenue
+    int m_nextParticle = 0;                            ///< Début de la prochaine plage dans l'anneau
+    quint32 m_seed = 1;
+    float m_clock = 0.0f;                              ///< Temps écoulé dans le système de particules
+    float m_aliveUntil = 0.0f;                         ///< Fin de vie de la dernière particule lancée
+
+    GLint m_emitterCountLocation = -1;
+    GLint m_emitterPositionLocation = -1;
+    GLint m_emitterVelocityLocation = -1;
+    GLint m_emitterNormalLocation = -1;
+    GLint m_emitterColorLocation = -1;
+    GLint m_emitterRangeLocation = -1;
+    GLint m_seedLocation = -1;
+};
+
+#endif
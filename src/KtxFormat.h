@@ -0,0 +1,87 @@
+/**
+ * @file KtxFormat.h
+ * @brief Format KTX 1.1 des textures précalculées (outil de précalcul et chargement)
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef KTXFORMAT_H
+#define KTXFORMAT_H
+
+#include <QtGlobal>
+#include <algorithm>
+
+/**
+ * @namespace Ktx
+ * @brief En-tête et constantes du conteneur KTX 1.1
+ *
+ * Un fichier contient l'en-tête, puis pour chaque niveau de mipmap sa taille
+ * en octets (32 bits) suivie des texels, alignés sur 4 octets. Les textures
+ * sont écrites déjà retournées (origine en bas à gauche, comme OpenGL) et avec
+ * toute la chaîne de mipmaps, en RGBA8 ou compressées en BC1.
+ */
+namespace Ktx {
+
+constexpr unsigned char IDENTIFIER[12] = {
+    0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'
+};
+constexpr quint32 ENDIANNESS = 0x04030201;
+
+// Valeurs OpenGL, définies ici pour que l'outil n'ait pas besoin des en-têtes GL
+constexpr quint32 GL_TYPE_UNSIGNED_BYTE = 0x1401;
+constexpr quint32 GL_FORMAT_RGBA = 0x1908;
+constexpr quint32 GL_FORMAT_RGB = 0x1907;
+constexpr quint32 GL_INTERNAL_RGBA8 = 0x8058;
+constexpr quint32 GL_INTERNAL_BC1_RGB = 0x83F0;    ///< GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+
+/**
+ * @struct Header
+ * @brief En-tête de 64 octets, dans l'ordre du fichier
+ */
+struct Header {
+    unsigned char identifier[12];
+    quint32 endianness;
+    quint32 glType;                 ///< 0 pour un format compressé
+    quint32 glTypeSize;
+    quint32 glFormat;               ///< 0 pour un format compressé
+    quint32 glInternalFormat;
+    quint32 glBaseInternalFormat;
+    quint32 pixelWidth;
+    quint32 pixelHeight;
+    quint32 pixelDepth;
+    quint32 numberOfArrayElements;
+    quint32 numberOfFaces;
+    quint32 numberOfMipmapLevels;
+    quint32 bytesOfKeyValueData;
+};
+
+static_assert(sizeof(Header) == 64, "KTX header must be 64 bytes");
+
+/**
+ * @brief Taille d'un niveau de mipmap en octets
+ * @param internalFormat GL_INTERNAL_RGBA8 ou GL_INTERNAL_BC1_RGB
+ */
+inline quint32 levelSize(quint32 internalFormat, quint32 width, quint32 height) {
+    if (internalFormat == GL_INTERNAL_BC1_RGB) {
+        // Blocs de 4x4 texels, 8 octets chacun
+        return std::max(1u, (width + 3) / 4) * std::max(1u, (height + 3) / 4) * 8;
+    }
+    return width * height * 4;
+}
+
+/**
+ * @brief Nombre de niveaux jusqu'à 1x1
+ */
+inline quint32 mipLevelCount(quint32 width, quint32 height) {
+    quint32 levels = 1;
+    while (width > 1 || height > 1) {
+        width = std::max(1u, width / 2);
+        height = std::max(1u, height / 2);
+        ++levels;
+    }
+    return levels;
+}
+
+}
+
+#endif
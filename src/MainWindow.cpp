@@ -1,6 +1,8 @@
 #include "MainWindow.h"
 #include "WebcamHandler.h"
 #include "OpenGLWidget.h"
+#include "PalmTracker.h"
+#include "PalmCalibrationModel.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QCloseEvent>
@@ -81,6 +83,11 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent), webcamHandler(new
     connect(openglWidget, &OpenGLWidget::scoreIncreased, this, &MainWindow::incrementScore);
     connect(openglWidget, &OpenGLWidget::gameOver, this, &MainWindow::endGame);
 
+    // Calibration dans le thread de la webcam : ses images et sa cascade ne changent pas de thread
+    connect(openglWidget, &OpenGLWidget::calibrationRequested, webcamHandler, &WebcamHandler::startCalibration, Qt::DirectConnection);
+    connect(webcamHandler, &WebcamHandler::calibrationViewReady, openglWidget, &OpenGLWidget::calibratePalmDetection, Qt::DirectConnection);
+    connect(openglWidget, &OpenGLWidget::calibrationComplete, webcamHandler, &WebcamHandler::stopCalibration, Qt::DirectConnection);
+
     score = 0;
     elapsedTime = 0;
     scoreLabel->setText("Score: 0");
@@ -128,6 +135,21 @@ void MainWindow::incrementScore() {
     scoreLabel->setText(QString("Score: %1").arg(score));
 }
 
+void MainWindow::setRenderScaling(float minScale, float maxScale, float budgetMs) {
+    openglWidget->setRenderScaling(minScale, maxScale, budgetMs);
+}
+
+void MainWindow::setPalmTracker(PalmTracker *tracker) {
+    webcamHandler->setPalmTracker(tracker);
+
+    connect(openglWidget, &OpenGLWidget::calibrationComplete, this, [tracker](bool success) {
+        PalmCalibrationModel model;
+        if (success && model.load(PalmCalibrationModel::defaultPath())) {
+            tracker->setCalibrationModel(model);
+        }
+    });
+}
+
 void MainWindow::updateGameTime() {
     elapsedTime++;
     timeLabel->setText(QString("Time: %1s").arg(elapsedTime));
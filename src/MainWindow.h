@@ -12,6 +12,7 @@
 
 class WebcamHandler;
 class OpenGLWidget;
+class PalmTracker;
 
 /**
  * @class MainWindow
@@ -48,6 +49,23 @@ public:
      */
     void incrementScore();
 
+    /**
+     * @brief Associe le suivi de paume par points caractéristiques
+     * @param tracker Suivi de paume (déjà calibré ou non)
+     *
+     * Le suivi est transmis au gestionnaire de webcam ; à chaque nouvelle
+     * calibration réussie, le modèle enregistré est rechargé dans le suivi.
+     */
+    void setPalmTracker(PalmTracker *tracker);
+
+    /**
+     * @brief Règle la résolution dynamique de la zone de jeu
+     * @param minScale Échelle minimale de chaque côté de la fenêtre
+     * @param maxScale Échelle maximale de chaque côté de la fenêtre
+     * @param budgetMs Temps GPU visé par image (ms)
+     */
+    void setRenderScaling(float minScale, float maxScale, float budgetMs);
+
 protected:
     /**
      * @brief Gère l'événement de fermeture de la fenêtre
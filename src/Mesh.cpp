@@ -0,0 +1,360 @@
+#include "Mesh.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include <QOpenGLContext>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+
+namespace {
+
+struct PendingDeletion {
+    GLuint vao;
+    GLuint vbo;
+    GLuint ebo;
+};
+
+QMutex pendingMutex;
+std::vector<PendingDeletion> pendingDeletions;
+
+quint64 totalUploadedBytes = 0;   // Thread OpenGL uniquement
+
+// Cache de sommets simulé par l'optimisation (taille courante des GPU intégrés ou plus)
+constexpr int CACHE_SIZE = 32;
+
+/**
+ * @brief Score de Forsyth d'un sommet : présence récente dans le cache et triangles restants
+ */
+float forsythScore(int cachePosition, int remainingTriangles) {
+    if (remainingTriangles <= 0) return -1.0f;
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        // Les trois sommets du dernier triangle ont un score fixe, pour ne pas favoriser les bandes
+        score = cachePosition < 3
+            ? 0.75f
+            : std::pow(1.0f - float(cachePosition - 3) / float(CACHE_SIZE - 3), 1.5f);
+    }
+    // Favorise les sommets presque terminés, pour éviter de laisser des triangles isolés
+    return score + 2.0f / std::sqrt(float(remainingTriangles));
+}
+
+void optimizeTriangleOrder(GLuint* indices, size_t indexCount, size_t vertexCount) {
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount < 2) return;
+
+    // Triangles de chaque sommet
+    std::vector<int> remaining(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; ++i) {
+        remaining[indices[i]]++;
+    }
+    std::vector<size_t> offsets(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        offsets[v + 1] = offsets[v] + size_t(remaining[v]);
+    }
+    std::vector<size_t> adjacency(triangleCount * 3);
+    std::vector<size_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            adjacency[cursor[indices[t * 3 + k]]++] = t;
+        }
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        vertexScore[v] = forsythScore(-1, remaining[v]);
+    }
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<GLuint> cache;
+    std::vector<GLuint> output;
+    output.reserve(triangleCount * 3);
+
+    size_t best = triangleCount;
+    float bestScore = -1.0f;
+    for (size_t t = 0; t < triangleCount; ++t) {
+        const float score = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+        if (score > bestScore) {
+            bestScore = score;
+            best = t;
+        }
+    }
+
+    size_t nextUnemitted = 0;
+    while (output.size() < triangleCount * 3) {
+        if (best == triangleCount) {
+            // Aucun triangle voisin du cache : on reprend le premier non émis
+            while (emitted[nextUnemitted]) ++nextUnemitted;
+            best = nextUnemitted;
+        }
+
+        emitted[best] = true;
+        std::vector<GLuint> newCache;
+        newCache.reserve(cache.size() + 3);
+        for (int k = 0; k < 3; ++k) {
+            const GLuint v = indices[best * 3 + k];
+            output.push_back(v);
+            remaining[v]--;
+            if (std::find(newCache.begin(), newCache.end(), v) == newCache.end()) {
+                newCache.push_back(v);
+            }
+        }
+        for (GLuint v : cache) {
+            if (std::find(newCache.begin(), newCache.end(), v) == newCache.end()) {
+                newCache.push_back(v);
+            }
+        }
+
+        // Les sommets sortis du cache perdent leur bonus de position
+        for (size_t i = 0; i < newCache.size(); ++i) {
+            const GLuint v = newCache[i];
+            cachePosition[v] = i < size_t(CACHE_SIZE) ? int(i) : -1;
+            vertexScore[v] = forsythScore(cachePosition[v], remaining[v]);
+        }
+
+        // Seuls les triangles des sommets touchés changent de score
+        best = triangleCount;
+        bestScore = -1.0f;
+        for (GLuint v : newCache) {
+            for (size_t a = offsets[v]; a < offsets[v + 1]; ++a) {
+                const size_t t = adjacency[a];
+                if (emitted[t]) continue;
+                const float score = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+                if (score > bestScore) {
+                    bestScore = score;
+                    best = t;
+                }
+            }
+        }
+
+        if (newCache.size() > size_t(CACHE_SIZE)) {
+            newCache.resize(CACHE_SIZE);
+        }
+        cache.swap(newCache);
+    }
+
+    std::copy(output.begin(), output.end(), indices);
+}
+
+/**
+ * @brief Normale en entiers signés 10:10:10:2 (GL_INT_2_10_10_10_REV)
+ */
+quint32 packNormal(float x, float y, float z) {
+    auto component = [](float value) {
+        const int scaled = int(std::lround(std::clamp(value, -1.0f, 1.0f) * 511.0f));
+        return quint32(scaled) & 0x3FFu;
+    };
+    return component(x) | (component(y) << 10) | (component(z) << 20);
+}
+
+}
+
+GLuint MeshData::addVertex(const QVector3D& position, const QVector3D& normal, float u, float v) {
+    vertices.insert(vertices.end(), {
+        position.x(), position.y(), position.z(),
+        normal.x(), normal.y(), normal.z(),
+        u, v
+    });
+    return GLuint(vertices.size() / VERTEX_SIZE - 1);
+}
+
+void MeshData::closePart(size_t firstIndex, GLenum mode) {
+    parts.push_back({ GLsizei(firstIndex), GLsizei(indices.size() - firstIndex), mode });
+}
+
+float MeshData::boundingRadius() const {
+    float radiusSquared = 0.0f;
+    for (size_t i = 0; i < vertices.size(); i += VERTEX_SIZE) {
+        float x = vertices[i], y = vertices[i + 1], z = vertices[i + 2];
+        radiusSquared = std::max(radiusSquared, x * x + y * y + z * z);
+    }
+    return std::sqrt(radiusSquared);
+}
+
+void MeshData::optimizeVertexCache() {
+    const size_t vertexCount = vertices.size() / VERTEX_SIZE;
+    if (vertexCount == 0) return;
+
+    if (parts.empty()) {
+        optimizeTriangleOrder(indices.data(), indices.size(), vertexCount);
+    }
+    for (const MeshPart& part : parts) {
+        if (part.mode == GL_TRIANGLES) {
+            optimizeTriangleOrder(indices.data() + part.firstIndex, size_t(part.indexCount), vertexCount);
+        }
+    }
+
+    // Sommets rangés dans l'ordre de leur première lecture : accès mémoire séquentiels
+    const GLuint unused = GLuint(-1);
+    std::vector<GLuint> remap(vertexCount, unused);
+    GLuint next = 0;
+    for (GLuint& index : indices) {
+        if (remap[index] == unused) {
+            remap[index] = next++;
+        }
+        index = remap[index];
+    }
+    for (GLuint& target : remap) {
+        if (target == unused) {
+            target = next++;
+        }
+    }
+
+    std::vector<GLfloat> reordered(vertices.size());
+    for (size_t v = 0; v < vertexCount; ++v) {
+        std::copy_n(vertices.begin() + v * VERTEX_SIZE, VERTEX_SIZE, reordered.begin() + remap[v] * VERTEX_SIZE);
+    }
+    vertices.swap(reordered);
+}
+
+PackedMeshData PackedMeshData::pack(const MeshData& data) {
+    PackedMeshData packed;
+    const size_t vertexCount = data.vertices.size() / MeshData::VERTEX_SIZE;
+
+    packed.vertices.resize(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        const GLfloat* source = data.vertices.data() + v * MeshData::VERTEX_SIZE;
+        PackedVertex& vertex = packed.vertices[v];
+        vertex.position[0] = qfloat16(source[0]);
+        vertex.position[1] = qfloat16(source[1]);
+        vertex.position[2] = qfloat16(source[2]);
+        vertex.padding = qfloat16(0.0f);
+        vertex.normal = packNormal(source[3], source[4], source[5]);
+        vertex.texCoord[0] = qfloat16(source[6]);
+        vertex.texCoord[1] = qfloat16(source[7]);
+    }
+
+    if (vertexCount <= 65536) {
+        packed.shortIndices.assign(data.indices.begin(), data.indices.end());
+    } else {
+        packed.indices = data.indices;
+    }
+
+    packed.parts = data.parts;
+    if (packed.parts.empty()) {
+        packed.parts.push_back({ 0, GLsizei(data.indices.size()) });
+    }
+    packed.boundingRadius = data.boundingRadius();
+    return packed;
+}
+
+MeshView PackedMeshData::view() const {
+    MeshView view;
+    view.vertices = vertices.data();
+    view.vertexBytes = GLsizeiptr(vertices.size() * sizeof(PackedVertex));
+    if (indices.empty()) {
+        view.indices = shortIndices.data();
+        view.indexBytes = GLsizeiptr(shortIndices.size() * sizeof(GLushort));
+        view.indexType = GL_UNSIGNED_SHORT;
+    } else {
+        view.indices = indices.data();
+        view.indexBytes = GLsizeiptr(indices.size() * sizeof(GLuint));
+        view.indexType = GL_UNSIGNED_INT;
+    }
+    view.parts = parts;
+    view.boundingRadius = boundingRadius;
+    return view;
+}
+
+quint64 Mesh::uploadedBytes() {
+    return totalUploadedBytes;
+}
+
+quint32 Mesh::nextId() {
+    static std::atomic<quint32> counter{ 1 };
+    return counter++;
+}
+
+Mesh::~Mesh() {
+    if (m_vao) {
+        QMutexLocker locker(&pendingMutex);
+        pendingDeletions.push_back({ m_vao, m_vbo, m_ebo });
+    }
+}
+
+void Mesh::upload(const MeshData& data) {
+    upload(PackedMeshData::pack(data).view());
+}
+
+void Mesh::upload(const MeshView& view) {
+    initializeOpenGLFunctions();
+
+    if (!m_vao) {
+        glGenVertexArrays(1, &m_vao);
+        glGenBuffers(1, &m_vbo);
+        glGenBuffers(1, &m_ebo);
+    }
+
+    glBindVertexArray(m_vao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
+    glBufferData(GL_ARRAY_BUFFER, view.vertexBytes, view.vertices, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, view.indexBytes, view.indices, GL_STATIC_DRAW);
+    totalUploadedBytes += quint64(view.vertexBytes + view.indexBytes);
+
+    const GLsizei stride = sizeof(PackedVertex);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_HALF_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<void*>(offsetof(PackedVertex, position)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride,
+                          reinterpret_cast<void*>(offsetof(PackedVertex, normal)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride,
+                          reinterpret_cast<void*>(offsetof(PackedVertex, texCoord)));
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    m_indexType = view.indexType;
+    m_indexSize = view.indexType == GL_UNSIGNED_SHORT ? sizeof(GLushort) : sizeof(GLuint);
+    m_parts = view.parts;
+    if (m_parts.empty()) {
+        m_parts.push_back({ 0, GLsizei(view.indexBytes / m_indexSize) });
+    }
+    m_boundingRadius = view.boundingRadius;
+}
+
+void Mesh::bind() {
+    glBindVertexArray(m_vao);
+}
+
+void Mesh::release() {
+    glBindVertexArray(0);
+}
+
+void Mesh::drawPart(int part) {
+    const MeshPart& range = m_parts[part];
+    if (range.indexCount > 0) {
+        glDrawElements(range.mode, range.indexCount, m_indexType,
+                       reinterpret_cast<void*>(range.firstIndex * m_indexSize));
+    }
+}
+
+void Mesh::collectGarbage() {
+    // Sans contexte courant, les noms restent en attente jusqu'au prochain appel
+    QOpenGLContext* context = QOpenGLContext::currentContext();
+    if (!context) {
+        return;
+    }
+
+    std::vector<PendingDeletion> deletions;
+    {
+        QMutexLocker locker(&pendingMutex);
+        deletions.swap(pendingDeletions);
+    }
+    if (deletions.empty()) {
+        return;
+    }
+
+    QOpenGLExtraFunctions* f = context->extraFunctions();
+    for (const PendingDeletion& deletion : deletions) {
+        f->glDeleteVertexArrays(1, &deletion.vao);
+        f->glDeleteBuffers(1, &deletion.vbo);
+        f->glDeleteBuffers(1, &deletion.ebo);
+    }
+}
@@ -0,0 +1,191 @@
+/**
+ * @file Mesh.h
+ * @brief Maillage stocké sur le GPU, partagé entre les objets qui l'utilisent
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef MESH_H
+#define MESH_H
+
+#include <QOpenGLExtraFunctions>
+#include <QFloat16>
+#include <QVector3D>
+#include <vector>
+
+/**
+ * @struct MeshPart
+ * @brief Plage d'indices tracée en un seul appel (corps, feuilles, lame...)
+ */
+struct MeshPart {
+    GLsizei firstIndex = 0;   ///< Premier indice de la plage
+    GLsizei indexCount = 0;   ///< Nombre d'indices
+    GLenum mode = GL_TRIANGLES; ///< Primitive tracée (GL_TRIANGLES ou GL_LINES)
+};
+
+/**
+ * @struct MeshData
+ * @brief Géométrie côté CPU : sommets entrelacés position/normale/UV (8 flottants)
+ */
+struct MeshData {
+    static constexpr int VERTEX_SIZE = 8;   ///< Nombre de flottants par sommet
+
+    std::vector<GLfloat> vertices;
+    std::vector<GLuint> indices;
+    std::vector<MeshPart> parts;
+
+    /**
+     * @brief Ajoute un sommet
+     * @return Indice du sommet ajouté
+     */
+    GLuint addVertex(const QVector3D& position, const QVector3D& normal, float u = 0.0f, float v = 0.0f);
+
+    /**
+     * @brief Ajoute une plage couvrant les indices ajoutés depuis firstIndex
+     * @param firstIndex Premier indice de la plage
+     * @param mode Primitive tracée
+     */
+    void closePart(size_t firstIndex, GLenum mode = GL_TRIANGLES);
+
+    /**
+     * @brief Rayon de la sphère englobante centrée sur l'origine du modèle
+     */
+    float boundingRadius() const;
+
+    /**
+     * @brief Réordonne les triangles pour le cache de sommets, puis les sommets par première utilisation
+     *
+     * Algorithme de Forsyth, plage par plage : les plages restent contiguës et
+     * tracent les mêmes triangles. À appeler une fois la géométrie terminée
+     * (après la découpe pour un fragment).
+     */
+    void optimizeVertexCache();
+};
+
+/**
+ * @struct MeshView
+ * @brief Géométrie déjà au format GPU, lue sans copie (fichier précalculé projeté en mémoire)
+ */
+struct MeshView {
+    const void* vertices = nullptr;           ///< Sommets au format PackedVertex
+    GLsizeiptr vertexBytes = 0;
+    const void* indices = nullptr;
+    GLsizeiptr indexBytes = 0;
+    GLenum indexType = GL_UNSIGNED_INT;       ///< GL_UNSIGNED_SHORT ou GL_UNSIGNED_INT
+    std::vector<MeshPart> parts;
+    float boundingRadius = 0.0f;
+};
+
+/**
+ * @struct PackedVertex
+ * @brief Sommet au format GPU (16 octets) : position et UV en demi-flottants, normale en 10:10:10:2
+ */
+struct PackedVertex {
+    qfloat16 position[3];
+    qfloat16 padding;
+    quint32 normal;                 ///< GL_INT_2_10_10_10_REV normalisé
+    qfloat16 texCoord[2];
+};
+
+static_assert(sizeof(PackedVertex) == 16, "Packed vertex must be 16 bytes");
+
+/**
+ * @struct PackedMeshData
+ * @brief Géométrie compactée, prête à être envoyée ou écrite dans le fichier précalculé
+ *
+ * Moitié moins d'octets par sommet que MeshData, et des indices 16 bits dès
+ * que le maillage a au plus 65536 sommets.
+ */
+struct PackedMeshData {
+    std::vector<PackedVertex> vertices;
+    std::vector<GLushort> shortIndices;     ///< Indices 16 bits (vide si le maillage exige 32 bits)
+    std::vector<GLuint> indices;            ///< Indices 32 bits (vide si shortIndices suffit)
+    std::vector<MeshPart> parts;
+    float boundingRadius = 0.0f;
+
+    /**
+     * @brief Compacte une géométrie (tout thread)
+     */
+    static PackedMeshData pack(const MeshData& data);
+
+    /**
+     * @brief Vue sur les tampons, valide tant que cet objet existe
+     */
+    MeshView view() const;
+};
+
+/**
+ * @class Mesh
+ * @brief VAO, VBO et EBO d'une géométrie envoyée une seule fois au GPU
+ *
+ * Un même maillage est partagé par tous les projectiles d'un type ; seuls les
+ * fragments découpés possèdent le leur, construit une fois lors de la découpe.
+ * Les objets OpenGL sont libérés de façon différée par collectGarbage(), car un
+ * maillage peut être détruit hors du contexte OpenGL (suppression d'un projectile
+ * dans la boucle de jeu).
+ */
+class Mesh : protected QOpenGLExtraFunctions {
+public:
+    Mesh() = default;
+    ~Mesh();
+
+    Mesh(const Mesh&) = delete;
+    Mesh& operator=(const Mesh&) = delete;
+
+    /**
+     * @brief Compacte puis envoie la géométrie au GPU (contexte courant requis)
+     * @param data Géométrie à envoyer
+     */
+    void upload(const MeshData& data);
+
+    /**
+     * @brief Envoie une géométrie déjà compactée, sans conversion (contexte courant requis)
+     * @param view Tampons à envoyer tels quels
+     */
+    void upload(const MeshView& view);
+
+    /**
+     * @brief Lie le VAO du maillage
+     */
+    void bind();
+
+    /**
+     * @brief Délie le VAO
+     */
+    void release();
+
+    /**
+     * @brief Trace une plage d'indices (le VAO doit être lié)
+     * @param part Index de la plage
+     */
+    void drawPart(int part);
+
+    int partCount() const { return int(m_parts.size()); }
+    quint32 id() const { return m_id; }
+    float boundingRadius() const { return m_boundingRadius; }
+    bool isUploaded() const { return m_vao != 0; }
+
+    /**
+     * @brief Libère les objets OpenGL des maillages détruits (sans contexte courant, ils restent en attente)
+     */
+    static void collectGarbage();
+
+    /**
+     * @brief Octets de sommets et d'indices envoyés depuis le démarrage, tous maillages confondus
+     */
+    static quint64 uploadedBytes();
+
+private:
+    static quint32 nextId();
+
+    quint32 m_id = nextId();   ///< Identifiant stable, utilisé dans les clés de tri
+    GLuint m_vao = 0;
+    GLuint m_vbo = 0;
+    GLuint m_ebo = 0;
+    GLenum m_indexType = GL_UNSIGNED_INT;
+    GLsizei m_indexSize = sizeof(GLuint);
+    std::vector<MeshPart> m_parts;
+    float m_boundingRadius = 0.0f;
+};
+
+#endif
@@ -0,0 +1,85 @@
+/**
+ * @file MeshAssetFormat.h
+ * @brief Format binaire des maillages précalculés (outil de précalcul et chargement)
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef MESHASSETFORMAT_H
+#define MESHASSETFORMAT_H
+
+#include <QtGlobal>
+
+/**
+ * @namespace MeshAsset
+ * @brief En-tête, table des maillages et constantes du fichier meshes.bin
+ *
+ * Le fichier contient l'en-tête, la table des entrées, puis pour chaque
+ * maillage ses sommets compactés (PackedVertex, 16 octets), ses indices
+ * (16 bits dès que possible, dans l'ordre optimisé pour le cache de sommets)
+ * et ses plages de tracé. Toutes les positions sont des décalages en octets
+ * depuis le début du fichier, alignés sur 4 octets, pour que les données soient
+ * envoyées directement depuis la projection en mémoire.
+ */
+namespace MeshAsset {
+
+constexpr char MAGIC[8] = { 'S', 'D', 'M', 'E', 'S', 'H', '\r', '\n' };
+constexpr quint32 VERSION = 2;
+
+/// Maillages stockés ; les types de projectiles gardent l'ordre de Projectile::Type
+enum Kind : quint16 {
+    KIND_BANANA = 0,
+    KIND_APPLE,
+    KIND_ANANAS,
+    KIND_FRAISE,
+    KIND_WOOD_CUBE,
+    KIND_SWORD,
+    KIND_COUNT
+};
+
+/**
+ * @struct Header
+ * @brief En-tête de 16 octets
+ */
+struct Header {
+    char magic[8];
+    quint32 version;
+    quint32 entryCount;
+};
+
+/**
+ * @struct Entry
+ * @brief Emplacement d'un maillage (un niveau de détail) dans le fichier
+ */
+struct Entry {
+    quint16 kind;                   ///< Valeur de Kind
+    quint16 lod;                    ///< Niveau de détail
+    quint32 vertexCount;
+    quint32 vertexOffset;
+    quint32 indexCount;
+    quint32 indexOffset;
+    quint32 indexSize;              ///< 2 ou 4 octets par indice
+    quint32 partCount;
+    quint32 partOffset;
+    float boundingRadius;           ///< Sphère englobante centrée sur l'origine du modèle
+};
+
+/**
+ * @struct Part
+ * @brief Plage d'indices tracée en un appel (voir MeshPart)
+ */
+struct Part {
+    quint32 firstIndex;
+    quint32 indexCount;
+    quint32 mode;                   ///< GL_TRIANGLES ou GL_LINES
+};
+
+constexpr int VERTEX_STRIDE = 16;   ///< Octets par sommet, comme PackedVertex
+
+static_assert(sizeof(Header) == 16, "Mesh asset header must be 16 bytes");
+static_assert(sizeof(Entry) == 40, "Mesh asset entry must be 40 bytes");
+static_assert(sizeof(Part) == 12, "Mesh asset part must be 12 bytes");
+
+}
+
+#endif
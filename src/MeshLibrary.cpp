@@ -0,0 +1,244 @@
+#include "MeshLibrary.h"
+#include "Projectile.h"
+#include <QCoreApplication>
+#include <QVector>
+#include <QDebug>
+#include <cstring>
+
+static_assert(int(MeshAsset::KIND_WOOD_CUBE) == int(Projectile::Type::WOOD_CUBE)
+              && Projectile::TYPE_COUNT == int(MeshAsset::KIND_SWORD),
+              "Mesh asset kinds must follow Projectile::Type");
+
+QString MeshLibrary::bakedPath() {
+    return QCoreApplication::applicationDirPath() + "/meshes.bin";
+}
+
+int MeshLibrary::lodCount(MeshAsset::Kind kind) {
+    return (kind == MeshAsset::KIND_WOOD_CUBE || kind == MeshAsset::KIND_SWORD) ? 1 : Projectile::LOD_COUNT;
+}
+
+bool MeshLibrary::open(const QString& path) {
+    if (!QFile::exists(path)) return false;
+
+    auto file = std::make_unique<QFile>(path);
+    if (!file->open(QIODevice::ReadOnly)) {
+        qWarning() << "Cannot open baked meshes" << path;
+        return false;
+    }
+
+    const qint64 size = file->size();
+    const uchar* data = size >= qint64(sizeof(MeshAsset::Header)) ? file->map(0, size) : nullptr;
+    if (!data) {
+        qWarning() << "Cannot map baked meshes" << path;
+        return false;
+    }
+
+    MeshAsset::Header header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, MeshAsset::MAGIC, sizeof(MeshAsset::MAGIC)) != 0
+        || header.version != MeshAsset::VERSION
+        || qint64(sizeof(header)) + qint64(header.entryCount) * qint64(sizeof(MeshAsset::Entry)) > size) {
+        qWarning() << "Unsupported baked meshes" << path;
+        return false;
+    }
+
+    m_file = std::move(file);
+    m_data = data;
+    m_size = size;
+    m_entries = reinterpret_cast<const MeshAsset::Entry*>(data + sizeof(header));
+    m_entryCount = header.entryCount;
+    return true;
+}
+
+const MeshAsset::Entry* MeshLibrary::find(MeshAsset::Kind kind, int lod) const {
+    for (quint32 i = 0; i < m_entryCount; ++i) {
+        if (m_entries[i].kind == kind && m_entries[i].lod == lod) {
+            return isValid(m_entries[i]) ? &m_entries[i] : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+bool MeshLibrary::isValid(const MeshAsset::Entry& entry) const {
+    const qint64 vertexBytes = qint64(entry.vertexCount) * MeshAsset::VERTEX_STRIDE;
+    const qint64 indexBytes = qint64(entry.indexCount) * entry.indexSize;
+    const qint64 partBytes = qint64(entry.partCount) * qint64(sizeof(MeshAsset::Part));
+
+    return (entry.indexSize == 2 || entry.indexSize == 4)
+        && (entry.vertexOffset % 4) == 0 && (entry.indexOffset % entry.indexSize) == 0 && (entry.partOffset % 4) == 0
+        && qint64(entry.vertexOffset) + vertexBytes <= m_size
+        && qint64(entry.indexOffset) + indexBytes <= m_size
+        && qint64(entry.partOffset) + partBytes <= m_size;
+}
+
+bool MeshLibrary::contains(MeshAsset::Kind kind, int lod) const {
+    return find(kind, lod) != nullptr;
+}
+
+void MeshLibrary::upload(Mesh& mesh, MeshAsset::Kind kind, int lod) const {
+    const MeshAsset::Entry* entry = find(kind, lod);
+    if (!entry) {
+        mesh.upload(generate(kind, lod));
+        return;
+    }
+
+    MeshView view;
+    view.vertices = m_data + entry->vertexOffset;
+    view.vertexBytes = GLsizeiptr(entry->vertexCount) * MeshAsset::VERTEX_STRIDE;
+    view.indices = m_data + entry->indexOffset;
+    view.indexBytes = GLsizeiptr(entry->indexCount) * entry->indexSize;
+    view.indexType = entry->indexSize == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+    view.boundingRadius = entry->boundingRadius;
+
+    const MeshAsset::Part* parts = reinterpret_cast<const MeshAsset::Part*>(m_data + entry->partOffset);
+    view.parts.reserve(entry->partCount);
+    for (quint32 i = 0; i < entry->partCount; ++i) {
+        view.parts.push_back({ GLsizei(parts[i].firstIndex), GLsizei(parts[i].indexCount), GLenum(parts[i].mode) });
+    }
+
+    mesh.upload(view);
+}
+
+MeshData MeshLibrary::generate(MeshAsset::Kind kind, int lod) {
+    MeshData data = kind == MeshAsset::KIND_SWORD ? buildSword() : Projectile::buildMeshData(Projectile::Type(kind), lod);
+    data.optimizeVertexCache();
+    return data;
+}
+
+MeshData MeshLibrary::buildSword() {
+    const float bladeLength = 0.25f;    
+    const float bladeWidth = 0.06f;     
+    const float handleLength = 0.15f;   
+    const float handleWidth = 0.03f;    
+    const float guardWidth = 0.1f;      
+    const float guardHeight = 0.02f;    
+    const float thickness = 0.03f;      
+
+    QVector<GLfloat> vertices;
+
+    vertices << -bladeWidth/2 << 0 << thickness/2 << 0 << 0 << 1 << 0.0f << 0.0f;  
+    vertices << bladeWidth/2 << 0 << thickness/2 << 0 << 0 << 1 << 1.0f << 0.0f;   
+    vertices << 0 << bladeLength << thickness/2 << 0 << 0 << 1 << 0.5f << 1.0f;    
+
+    vertices << bladeWidth/2 << 0 << -thickness/2 << 0 << 0 << -1 << 0.0f << 0.0f;  
+    vertices << -bladeWidth/2 << 0 << -thickness/2 << 0 << 0 << -1 << 1.0f << 0.0f; 
+    vertices << 0 << bladeLength << -thickness/2 << 0 << 0 << -1 << 0.5f << 1.0f;   
+
+    vertices << -bladeWidth/2 << 0 << thickness/2 << -1 << 0.5f << 0 << 0.0f << 0.0f;   
+    vertices << 0 << bladeLength << thickness/2 << -1 << 0.5f << 0 << 1.0f << 1.0f;     
+    vertices << 0 << bladeLength << -thickness/2 << -1 << 0.5f << 0 << 0.0f << 1.0f;    
+
+    vertices << 0 << bladeLength << -thickness/2 << -1 << 0.5f << 0 << 0.0f << 1.0f;    
+    vertices << -bladeWidth/2 << 0 << -thickness/2 << -1 << 0.5f << 0 << 1.0f << 0.0f;  
+    vertices << -bladeWidth/2 << 0 << thickness/2 << -1 << 0.5f << 0 << 0.0f << 0.0f;   
+
+    vertices << bladeWidth/2 << 0 << thickness/2 << 1 << 0.5f << 0 << 0.0f << 0.0f;     
+    vertices << 0 << bladeLength << -thickness/2 << 1 << 0.5f << 0 << 1.0f << 1.0f;     
+    vertices << 0 << bladeLength << thickness/2 << 1 << 0.5f << 0 << 0.0f << 1.0f;      
+
+    vertices << 0 << bladeLength << -thickness/2 << 1 << 0.5f << 0 << 1.0f << 1.0f;     
+    vertices << bladeWidth/2 << 0 << thickness/2 << 1 << 0.5f << 0 << 0.0f << 0.0f;     
+    vertices << bladeWidth/2 << 0 << -thickness/2 << 1 << 0.5f << 0 << 1.0f << 0.0f;    
+
+    vertices << -bladeWidth/2 << 0 << thickness/2 << 0 << -1 << 0 << 0.0f << 0.0f;     
+    vertices << -bladeWidth/2 << 0 << -thickness/2 << 0 << -1 << 0 << 0.0f << 1.0f;    
+    vertices << bladeWidth/2 << 0 << -thickness/2 << 0 << -1 << 0 << 1.0f << 1.0f;     
+
+    vertices << bladeWidth/2 << 0 << -thickness/2 << 0 << -1 << 0 << 1.0f << 1.0f;     
+    vertices << bladeWidth/2 << 0 << thickness/2 << 0 << -1 << 0 << 1.0f << 0.0f;      
+    vertices << -bladeWidth/2 << 0 << thickness/2 << 0 << -1 << 0 << 0.0f << 0.0f;     
+
+    vertices << -guardWidth/2 << -guardHeight << thickness/2 << 0 << 0 << 1 << 0.0f << 1.0f;   
+    vertices << guardWidth/2 << -guardHeight << thickness/2 << 0 << 0 << 1 << 1.0f << 1.0f;     
+    vertices << guardWidth/2 << 0 << thickness/2 << 0 << 0 << 1 << 1.0f << 0.0f;              
+
+    vertices << guardWidth/2 << 0 << thickness/2 << 0 << 0 << 1 << 1.0f << 0.0f;              
+    vertices << -guardWidth/2 << 0 << thickness/2 << 0 << 0 << 1 << 0.0f << 0.0f;             
+    vertices << -guardWidth/2 << -guardHeight << thickness/2 << 0 << 0 << 1 << 0.0f << 1.0f;   
+
+    vertices << -guardWidth/2 << -guardHeight << -thickness/2 << 0 << 0 << -1 << 1.0f << 1.0f;  
+    vertices << guardWidth/2 << 0 << -thickness/2 << 0 << 0 << -1 << 0.0f << 0.0f;             
+    vertices << guardWidth/2 << -guardHeight << -thickness/2 << 0 << 0 << -1 << 0.0f << 1.0f;   
+
+    vertices << guardWidth/2 << 0 << -thickness/2 << 0 << 0 << -1 << 0.0f << 0.0f;             
+    vertices << -guardWidth/2 << -guardHeight << -thickness/2 << 0 << 0 << -1 << 1.0f << 1.0f;  
+    vertices << -guardWidth/2 << 0 << -thickness/2 << 0 << 0 << -1 << 1.0f << 0.0f;            
+
+    vertices << -guardWidth/2 << -guardHeight << thickness/2 << 0 << -1 << 0 << 0.0f << 0.0f;   
+    vertices << guardWidth/2 << -guardHeight << thickness/2 << 0 << -1 << 0 << 1.0f << 0.0f;    
+    vertices << guardWidth/2 << -guardHeight << -thickness/2 << 0 << -1 << 0 << 1.0f << 1.0f;   
+
+    vertices << guardWidth/2 << -guardHeight << -thickness/2 << 0 << -1 << 0 << 1.0f << 1.0f;   
+    vertices << -guardWidth/2 << -guardHeight << -thickness/2 << 0 << -1 << 0 << 0.0f << 1.0f;  
+    vertices << -guardWidth/2 << -guardHeight << thickness/2 << 0 << -1 << 0 << 0.0f << 0.0f;   
+
+    vertices << -guardWidth/2 << -guardHeight << thickness/2 << -1 << 0 << 0 << 1.0f << 1.0f;   
+    vertices << -guardWidth/2 << -guardHeight << -thickness/2 << -1 << 0 << 0 << 0.0f << 1.0f;  
+    vertices << -guardWidth/2 << 0 << -thickness/2 << -1 << 0 << 0 << 0.0f << 0.0f;            
+
+    vertices << -guardWidth/2 << 0 << -thickness/2 << -1 << 0 << 0 << 0.0f << 0.0f;            
+    vertices << -guardWidth/2 << 0 << thickness/2 << -1 << 0 << 0 << 1.0f << 0.0f;             
+    vertices << -guardWidth/2 << -guardHeight << thickness/2 << -1 << 0 << 0 << 1.0f << 1.0f;   
+
+    vertices << guardWidth/2 << -guardHeight << thickness/2 << 1 << 0 << 0 << 0.0f << 1.0f;     
+    vertices << guardWidth/2 << 0 << -thickness/2 << 1 << 0 << 0 << 1.0f << 0.0f;              
+    vertices << guardWidth/2 << -guardHeight << -thickness/2 << 1 << 0 << 0 << 1.0f << 1.0f;    
+
+    vertices << guardWidth/2 << 0 << -thickness/2 << 1 << 0 << 0 << 1.0f << 0.0f;              
+    vertices << guardWidth/2 << -guardHeight << thickness/2 << 1 << 0 << 0 << 0.0f << 1.0f;     
+    vertices << guardWidth/2 << 0 << thickness/2 << 1 << 0 << 0 << 0.0f << 0.0f;              
+
+    vertices << -handleWidth/2 << -handleLength-guardHeight << thickness/2 << 0 << 0 << 1 << 0.0f << 1.0f;  
+    vertices << handleWidth/2 << -handleLength-guardHeight << thickness/2 << 0 << 0 << 1 << 1.0f << 1.0f;   
+    vertices << handleWidth/2 << -guardHeight << thickness/2 << 0 << 0 << 1 << 1.0f << 0.0f;               
+
+    vertices << handleWidth/2 << -guardHeight << thickness/2 << 0 << 0 << 1 << 1.0f << 0.0f;               
+    vertices << -handleWidth/2 << -guardHeight << thickness/2 << 0 << 0 << 1 << 0.0f << 0.0f;              
+    vertices << -handleWidth/2 << -handleLength-guardHeight << thickness/2 << 0 << 0 << 1 << 0.0f << 1.0f; 
+
+    vertices << -handleWidth/2 << -handleLength-guardHeight << -thickness/2 << 0 << 0 << -1 << 0.0f << 1.0f; 
+    vertices << handleWidth/2 << -guardHeight << -thickness/2 << 0 << 0 << -1 << 1.0f << 0.0f;               
+    vertices << handleWidth/2 << -handleLength-guardHeight << -thickness/2 << 0 << 0 << -1 << 1.0f << 1.0f;  
+
+    vertices << handleWidth/2 << -guardHeight << -thickness/2 << 0 << 0 << -1 << 1.0f << 0.0f;               
+    vertices << -handleWidth/2 << -handleLength-guardHeight << -thickness/2 << 0 << 0 << -1 << 0.0f << 1.0f; 
+    vertices << -handleWidth/2 << -guardHeight << -thickness/2 << 0 << 0 << -1 << 0.0f << 0.0f;              
+
+    vertices << -handleWidth/2 << -handleLength-guardHeight << thickness/2 << 0 << -1 << 0 << 0.0f << 0.0f;  
+    vertices << handleWidth/2 << -handleLength-guardHeight << thickness/2 << 0 << -1 << 0 << 1.0f << 0.0f;   
+    vertices << handleWidth/2 << -handleLength-guardHeight << -thickness/2 << 0 << -1 << 0 << 1.0f << 1.0f;  
+
+    vertices << handleWidth/2 << -handleLength-guardHeight << -thickness/2 << 0 << -1 << 0 << 1.0f << 1.0f;  
+    vertices << -handleWidth/2 << -handleLength-guardHeight << -thickness/2 << 0 << -1 << 0 << 0.0f << 1.0f; 
+    vertices << -handleWidth/2 << -handleLength-guardHeight << thickness/2 << 0 << -1 << 0 << 0.0f << 0.0f;  
+
+    vertices << -handleWidth/2 << -handleLength-guardHeight << thickness/2 << -1 << 0 << 0 << 0.0f << 1.0f;  
+    vertices << -handleWidth/2 << -handleLength-guardHeight << -thickness/2 << -1 << 0 << 0 << 1.0f << 1.0f; 
+    vertices << -handleWidth/2 << -guardHeight << -thickness/2 << -1 << 0 << 0 << 1.0f << 0.0f;              
+
+    vertices << -handleWidth/2 << -guardHeight << -thickness/2 << -1 << 0 << 0 << 1.0f << 0.0f;              
+    vertices << -handleWidth/2 << -guardHeight << thickness/2 << -1 << 0 << 0 << 0.0f << 0.0f;               
+    vertices << -handleWidth/2 << -handleLength-guardHeight << thickness/2 << -1 << 0 << 0 << 0.0f << 1.0f;  
+
+    vertices << handleWidth/2 << -handleLength-guardHeight << thickness/2 << 1 << 0 << 0 << 1.0f << 1.0f;   
+    vertices << handleWidth/2 << -guardHeight << -thickness/2 << 1 << 0 << 0 << 0.0f << 0.0f;               
+    vertices << handleWidth/2 << -handleLength-guardHeight << -thickness/2 << 1 << 0 << 0 << 0.0f << 1.0f;  
+
+    vertices << handleWidth/2 << -guardHeight << -thickness/2 << 1 << 0 << 0 << 0.0f << 0.0f;               
+    vertices << handleWidth/2 << -handleLength-guardHeight << thickness/2 << 1 << 0 << 0 << 1.0f << 1.0f;   
+    vertices << handleWidth/2 << -guardHeight << thickness/2 << 1 << 0 << 0 << 1.0f << 0.0f;                
+
+    const int bladeVertexCount = 24; 
+    const int guardVertexCount = 30; 
+    const int handleVertexCount = 30; 
+
+    MeshData data;
+    data.vertices.assign(vertices.begin(), vertices.end());
+    for (GLuint i = 0; i < GLuint(vertices.size() / MeshData::VERTEX_SIZE); ++i) {
+        data.indices.push_back(i);
+    }
+    data.parts.push_back({ 0, bladeVertexCount });
+    data.parts.push_back({ bladeVertexCount, guardVertexCount });
+    data.parts.push_back({ bladeVertexCount + guardVertexCount, handleVertexCount });
+    return data;
+}
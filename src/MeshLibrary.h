@@ -0,0 +1,84 @@
+/**
+ * @file MeshLibrary.h
+ * @brief Maillages statiques du jeu, lus dans le fichier précalculé ou générés en secours
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef MESHLIBRARY_H
+#define MESHLIBRARY_H
+
+#include <QFile>
+#include <QString>
+#include "Mesh.h"
+#include "MeshAssetFormat.h"
+#include <memory>
+
+/**
+ * @class MeshLibrary
+ * @brief Accès aux maillages produits par mesh_baker (projectiles et épée)
+ *
+ * Le fichier « meshes.bin » à côté de l'exécutable est projeté en mémoire et
+ * chaque maillage est envoyé directement depuis la projection : ni génération
+ * trigonométrique ni copie au démarrage. Sans fichier (ou pour un maillage qui
+ * n'y figure pas), la géométrie est générée comme avant.
+ */
+class MeshLibrary {
+public:
+    MeshLibrary() = default;
+
+    MeshLibrary(const MeshLibrary&) = delete;
+    MeshLibrary& operator=(const MeshLibrary&) = delete;
+
+    /**
+     * @brief Projette le fichier précalculé et vérifie sa table (tout thread)
+     * @param path Fichier à ouvrir
+     * @return false si le fichier est absent ou invalide (génération en secours)
+     */
+    bool open(const QString& path = bakedPath());
+
+    /**
+     * @brief Indique si le maillage figure dans le fichier projeté
+     */
+    bool contains(MeshAsset::Kind kind, int lod) const;
+
+    /**
+     * @brief Envoie un maillage, depuis le fichier s'il y figure, sinon généré (contexte courant requis)
+     * @param mesh Maillage à remplir
+     * @param kind Objet
+     * @param lod Niveau de détail
+     */
+    void upload(Mesh& mesh, MeshAsset::Kind kind, int lod) const;
+
+    /**
+     * @brief Génère la géométrie d'un maillage, réordonnée pour le cache de sommets (outil de précalcul et secours)
+     */
+    static MeshData generate(MeshAsset::Kind kind, int lod);
+
+    /**
+     * @brief Nombre de niveaux de détail d'un objet (un seul pour le cube et l'épée)
+     */
+    static int lodCount(MeshAsset::Kind kind);
+
+    /**
+     * @brief Fichier précalculé à côté de l'exécutable
+     */
+    static QString bakedPath();
+
+private:
+    const MeshAsset::Entry* find(MeshAsset::Kind kind, int lod) const;
+    bool isValid(const MeshAsset::Entry& entry) const;
+
+    /**
+     * @brief Construit le maillage de l'épée (lame, garde, poignée)
+     */
+    static MeshData buildSword();
+
+    std::unique_ptr<QFile> m_file;                    ///< Fichier ouvert (garde la projection valide)
+    const uchar* m_data = nullptr;                    ///< Début de la projection
+    qint64 m_size = 0;
+    const MeshAsset::Entry* m_entries = nullptr;      ///< Table des maillages, dans la projection
+    quint32 m_entryCount = 0;
+};
+
+#endif
@@ -0,0 +1,395 @@
+#include "MeshSlicer.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int STRIDE = MeshData::VERTEX_SIZE;
+
+// Mélange splitmix64 : des clés voisines tombent loin les unes des autres dans la table
+quint64 mix(quint64 key) {
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+// Table vide d'au moins deux fois expected entrées (puissance de deux) : jamais pleine
+void resetTable(std::vector<MeshSlicer::Arena::Slot>& table, size_t expected) {
+    size_t size = 16;
+    while (size < expected * 2) {
+        size <<= 1;
+    }
+    table.assign(size, MeshSlicer::Arena::Slot());
+}
+
+float cross(const float* a, const float* b, const float* c) {
+    return (b[0] - a[0]) * (c[1] - a[1]) - (b[1] - a[1]) * (c[0] - a[0]);
+}
+
+}
+
+int MeshSlicer::slice(MeshData& data, const QVector3D& planeNormal, int side, Arena& arena) {
+    if (data.parts.empty()) return 0;
+
+    const size_t vertexCount = data.vertices.size() / STRIDE;
+    const QVector3D normal = planeNormal.normalized();
+    const float sign = side < 0 ? -1.0f : 1.0f;
+    const MeshPart body = data.parts[0];
+
+    // Le plan passe par le centre du corps tel qu'il est (déjà découpé pour un fragment de fragment)
+    QVector3D planePoint;
+    int bodyVertexCount = 0;
+    arena.inBody.assign(vertexCount, 0);
+    for (GLsizei i = body.firstIndex; i < body.firstIndex + body.indexCount; ++i) {
+        const GLuint index = data.indices[i];
+        if (!arena.inBody[index]) {
+            arena.inBody[index] = 1;
+            planePoint += QVector3D(data.vertices[index * STRIDE], data.vertices[index * STRIDE + 1],
+                                    data.vertices[index * STRIDE + 2]);
+            bodyVertexCount++;
+        }
+    }
+    if (bodyVertexCount > 0) {
+        planePoint /= float(bodyVertexCount);
+    }
+
+    arena.distances.resize(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) {
+        const QVector3D position(data.vertices[v * STRIDE], data.vertices[v * STRIDE + 1], data.vertices[v * STRIDE + 2]);
+        const float distance = QVector3D::dotProduct(position - planePoint, normal) * sign;
+        arena.distances[v] = std::abs(distance) < PLANE_EPSILON ? 0.0f : distance;
+    }
+
+    // Deux arêtes coupées au plus par triangle à cheval : la table des arêtes est dimensionnée d'après eux
+    size_t straddling = 0;
+    for (const MeshPart& part : data.parts) {
+        if (part.mode != GL_TRIANGLES) continue;
+        for (GLsizei i = part.firstIndex; i + 2 < part.firstIndex + part.indexCount; i += 3) {
+            const float d0 = arena.distances[data.indices[i]];
+            const float d1 = arena.distances[data.indices[i + 1]];
+            const float d2 = arena.distances[data.indices[i + 2]];
+            if (std::min({ d0, d1, d2 }) < 0.0f && std::max({ d0, d1, d2 }) > 0.0f) {
+                straddling++;
+            }
+        }
+    }
+    resetTable(arena.edges, 2 * straddling);
+
+    arena.indices.clear();
+    arena.parts.clear();
+    arena.segments.clear();
+
+    int capTriangles = 0;
+    for (size_t p = 0; p < data.parts.size(); ++p) {
+        const MeshPart part = data.parts[p];
+        const size_t partStart = arena.indices.size();
+
+        if (part.mode == GL_TRIANGLES) {
+            for (GLsizei i = part.firstIndex; i + 2 < part.firstIndex + part.indexCount; i += 3) {
+                clipTriangle(data, &data.indices[i], p == 0, arena);
+            }
+        } else {
+            for (GLsizei i = part.firstIndex; i + 1 < part.firstIndex + part.indexCount; i += 2) {
+                const GLuint a = data.indices[i], b = data.indices[i + 1];
+                if (arena.distances[a] >= 0.0f && arena.distances[b] >= 0.0f) {
+                    arena.indices.insert(arena.indices.end(), { a, b });
+                }
+            }
+        }
+
+        if (p == 0) {
+            capTriangles = closeCut(data, normal, side, arena);
+        }
+        arena.parts.push_back({ GLsizei(partStart), GLsizei(arena.indices.size() - partStart), part.mode });
+    }
+
+    // Échange plutôt que copie : l'arène récupère les anciens tampons et leur capacité
+    data.indices.swap(arena.indices);
+    data.parts.swap(arena.parts);
+    compact(data, arena);
+    return capTriangles;
+}
+
+void MeshSlicer::clipTriangle(MeshData& data, const GLuint* triangle, bool body, Arena& arena) {
+    GLuint kept[4];
+    GLuint onPlane[3];
+    int keptCount = 0;
+    int onPlaneCount = 0;
+    bool anyOutside = false;
+
+    // Sutherland-Hodgman sur les trois arêtes, dans l'ordre : l'orientation est conservée
+    for (int k = 0; k < 3; ++k) {
+        const GLuint a = triangle[k];
+        const GLuint b = triangle[(k + 1) % 3];
+        const float da = arena.distances[a];
+        const float db = arena.distances[b];
+
+        if (da >= 0.0f) {
+            kept[keptCount++] = a;
+            if (da == 0.0f) {
+                onPlane[onPlaneCount++] = a;
+            }
+        } else {
+            anyOutside = true;
+        }
+        if ((da > 0.0f && db < 0.0f) || (da < 0.0f && db > 0.0f)) {
+            const GLuint cut = edgeVertex(data, a, b, arena);
+            kept[keptCount++] = cut;
+            onPlane[onPlaneCount++] = cut;
+        }
+    }
+
+    for (int k = 1; k + 1 < keptCount; ++k) {
+        arena.indices.insert(arena.indices.end(), { kept[0], kept[k], kept[k + 1] });
+    }
+
+    // Un triangle en partie retiré apporte un segment du contour ; celui posé sur le plan ne compte qu'une fois
+    if (body && anyOutside && keptCount > 0 && onPlaneCount == 2) {
+        arena.segments.insert(arena.segments.end(), { onPlane[0], onPlane[1] });
+    }
+}
+
+GLuint MeshSlicer::edgeVertex(MeshData& data, GLuint a, GLuint b, Arena& arena) {
+    if (a > b) std::swap(a, b);
+    const quint64 key = (quint64(a) << 32) | b;   // b > a : jamais nulle
+
+    const size_t mask = arena.edges.size() - 1;
+    for (size_t slot = mix(key) & mask;; slot = (slot + 1) & mask) {
+        Arena::Slot& entry = arena.edges[slot];
+        if (entry.key == key) return entry.value;
+        if (entry.key != 0) continue;
+
+        // Interpolé toujours dans le même sens : les deux triangles voisins partagent le sommet
+        const float t = arena.distances[a] / (arena.distances[a] - arena.distances[b]);
+        GLfloat vertex[STRIDE];
+        for (int k = 0; k < STRIDE; ++k) {
+            const GLfloat from = data.vertices[a * STRIDE + k];
+            vertex[k] = from + (data.vertices[b * STRIDE + k] - from) * t;
+        }
+        const QVector3D normal = QVector3D(vertex[3], vertex[4], vertex[5]).normalized();
+        vertex[3] = normal.x();
+        vertex[4] = normal.y();
+        vertex[5] = normal.z();
+
+        const GLuint index = GLuint(data.vertices.size() / STRIDE);
+        data.vertices.insert(data.vertices.end(), vertex, vertex + STRIDE);
+        arena.distances.push_back(0.0f);
+
+        entry.key = key;
+        entry.value = index;
+        return index;
+    }
+}
+
+int MeshSlicer::contourNode(const MeshData& data, GLuint vertex, Arena& arena) {
+    const GLfloat* position = &data.vertices[vertex * STRIDE];
+    const qint32 cell[3] = {
+        qint32(std::lround(position[0] / WELD_CELL)),
+        qint32(std::lround(position[1] / WELD_CELL)),
+        qint32(std::lround(position[2] / WELD_CELL))
+    };
+    const quint64 key = mix((quint64(quint32(cell[0])) << 42) ^ (quint64(quint32(cell[1])) << 21) ^ quint32(cell[2])) | 1;
+
+    const size_t mask = arena.nodeSlots.size() - 1;
+    for (size_t slot = key & mask;; slot = (slot + 1) & mask) {
+        Arena::Slot& entry = arena.nodeSlots[slot];
+        if (entry.key == key) {
+            const Arena::Node& node = arena.nodes[entry.value];
+            if (std::equal(cell, cell + 3, node.cell)) return int(entry.value);
+            continue;
+        }
+        if (entry.key != 0) continue;
+
+        Arena::Node node;
+        std::copy(cell, cell + 3, node.cell);
+        node.position = QVector3D(position[0], position[1], position[2]);
+        node.links[0] = node.links[1] = -1;
+        node.capVertex = -1;
+        node.visited = false;
+
+        entry.key = key;
+        entry.value = quint32(arena.nodes.size());
+        arena.nodes.push_back(node);
+        return int(entry.value);
+    }
+}
+
+int MeshSlicer::closeCut(MeshData& data, const QVector3D& planeNormal, int side, Arena& arena) {
+    if (arena.segments.empty()) return 0;
+
+    arena.nodes.clear();
+    resetTable(arena.nodeSlots, arena.segments.size());
+
+    auto link = [&arena](int from, int to) {
+        int* links = arena.nodes[from].links;
+        if (links[0] == to || links[1] == to) return;
+        // Plus de deux voisins : contour non manifold, le lien supplémentaire est ignoré
+        if (links[0] < 0) {
+            links[0] = to;
+        } else if (links[1] < 0) {
+            links[1] = to;
+        }
+    };
+    for (size_t i = 0; i + 1 < arena.segments.size(); i += 2) {
+        const int a = contourNode(data, arena.segments[i], arena);
+        const int b = contourNode(data, arena.segments[i + 1], arena);
+        if (a == b) continue;
+        link(a, b);
+        link(b, a);
+    }
+
+    QVector3D tangent;
+    if (std::abs(planeNormal.y()) < 0.9f) {
+        tangent = QVector3D::crossProduct(planeNormal, QVector3D(0, 1, 0)).normalized();
+    } else {
+        tangent = QVector3D::crossProduct(planeNormal, QVector3D(1, 0, 0)).normalized();
+    }
+    const QVector3D bitangent = QVector3D::crossProduct(planeNormal, tangent).normalized();
+    const QVector3D capNormal = planeNormal * (side < 0 ? 1.0f : -1.0f);
+
+    // Le shader colore les faces arrière en couleur de coupe : le couvercle tourne sa face avant
+    // vers l'intérieur du fragment. (tangent, bitangent) est direct autour de planeNormal.
+    const bool reverse = side < 0;
+
+    int triangles = 0;
+    // Chaînes ouvertes (corps ouvert, soudure manquée) depuis une extrémité, puis boucles fermées
+    for (int pass = 0; pass < 2; ++pass) {
+        for (size_t start = 0; start < arena.nodes.size(); ++start) {
+            const Arena::Node& first = arena.nodes[start];
+            if (first.visited) continue;
+            const int degree = (first.links[0] >= 0) + (first.links[1] >= 0);
+            if (pass == 0 && degree != 1) continue;
+
+            arena.polygon.clear();
+            int previous = -1;
+            int current = int(start);
+            while (current >= 0 && !arena.nodes[current].visited) {
+                Arena::Node& node = arena.nodes[current];
+                node.visited = true;
+                arena.polygon.push_back(current);
+                const int next = node.links[0] != previous ? node.links[0] : node.links[1];
+                previous = current;
+                current = next;
+            }
+
+            if (arena.polygon.size() >= 3) {
+                triangles += triangulate(data, tangent, bitangent, capNormal, reverse, arena);
+            }
+        }
+    }
+    return triangles;
+}
+
+int MeshSlicer::triangulate(MeshData& data, const QVector3D& tangent, const QVector3D& bitangent,
+                            const QVector3D& capNormal, bool reverse, Arena& arena) {
+    const int count = int(arena.polygon.size());
+    const QVector3D origin = arena.nodes[arena.polygon[0]].position;
+
+    arena.points.resize(size_t(count) * 2);
+    float area = 0.0f;
+    for (int i = 0; i < count; ++i) {
+        const QVector3D offset = arena.nodes[arena.polygon[i]].position - origin;
+        arena.points[i * 2] = QVector3D::dotProduct(offset, tangent);
+        arena.points[i * 2 + 1] = QVector3D::dotProduct(offset, bitangent);
+    }
+    for (int i = 0; i < count; ++i) {
+        const float* a = &arena.points[i * 2];
+        const float* b = &arena.points[((i + 1) % count) * 2];
+        area += a[0] * b[1] - b[0] * a[1];
+    }
+
+    // Contour rendu direct pour que les oreilles soient les sommets convexes
+    arena.ring.resize(count);
+    for (int i = 0; i < count; ++i) {
+        arena.ring[i] = area >= 0.0f ? i : count - 1 - i;
+    }
+
+    auto capVertex = [&](int position) {
+        Arena::Node& node = arena.nodes[arena.polygon[position]];
+        if (node.capVertex < 0) {
+            node.capVertex = int(data.addVertex(node.position, capNormal, 0.5f, 0.5f));
+        }
+        return GLuint(node.capVertex);
+    };
+    int triangles = 0;
+    auto addTriangle = [&](int a, int b, int c) {
+        if (reverse) std::swap(b, c);
+        arena.indices.insert(arena.indices.end(), { capVertex(a), capVertex(b), capVertex(c) });
+        triangles++;
+    };
+    auto point = [&arena](int position) { return &arena.points[position * 2]; };
+
+    const float areaEpsilon = 1e-12f;
+    std::vector<int>& ring = arena.ring;
+    while (ring.size() > 3) {
+        const int size = int(ring.size());
+        int ear = -1;
+        for (int k = 0; k < size && ear < 0; ++k) {
+            const int a = ring[(k + size - 1) % size], b = ring[k], c = ring[(k + 1) % size];
+            if (cross(point(a), point(b), point(c)) <= areaEpsilon) continue;
+
+            bool blocked = false;
+            for (int other : ring) {
+                if (other == a || other == b || other == c) continue;
+                const float* p = point(other);
+                if (cross(point(a), point(b), p) > 0.0f && cross(point(b), point(c), p) > 0.0f
+                    && cross(point(c), point(a), p) > 0.0f) {
+                    blocked = true;
+                    break;
+                }
+            }
+            if (!blocked) {
+                ear = k;
+            }
+        }
+
+        if (ear >= 0) {
+            addTriangle(ring[(ear + size - 1) % size], ring[ear], ring[(ear + 1) % size]);
+            ring.erase(ring.begin() + ear);
+            continue;
+        }
+
+        // Aucune oreille : un sommet aligné avec ses voisins est retiré sans triangle
+        int flat = -1;
+        for (int k = 0; k < size && flat < 0; ++k) {
+            const int a = ring[(k + size - 1) % size], b = ring[k], c = ring[(k + 1) % size];
+            if (std::abs(cross(point(a), point(b), point(c))) <= areaEpsilon) {
+                flat = k;
+            }
+        }
+        if (flat >= 0) {
+            ring.erase(ring.begin() + flat);
+            continue;
+        }
+
+        // Contour qui se recoupe : éventail sur le reste plutôt qu'un trou
+        for (int k = 1; k + 1 < size; ++k) {
+            addTriangle(ring[0], ring[k], ring[k + 1]);
+        }
+        ring.clear();
+    }
+    if (ring.size() == 3 && cross(point(ring[0]), point(ring[1]), point(ring[2])) > areaEpsilon) {
+        addTriangle(ring[0], ring[1], ring[2]);
+    }
+    return triangles;
+}
+
+void MeshSlicer::compact(MeshData& data, Arena& arena) {
+    const GLuint unused = GLuint(-1);
+    arena.remap.assign(data.vertices.size() / STRIDE, unused);
+    arena.vertices.clear();
+
+    GLuint next = 0;
+    for (GLuint& index : data.indices) {
+        if (arena.remap[index] == unused) {
+            arena.remap[index] = next++;
+            arena.vertices.insert(arena.vertices.end(), data.vertices.begin() + index * STRIDE,
+                                  data.vertices.begin() + (index + 1) * STRIDE);
+        }
+        index = arena.remap[index];
+    }
+    data.vertices.swap(arena.vertices);
+}
@@ -0,0 +1,97 @@
+/**
+ * @file MeshSlicer.h
+ * @brief Découpe exacte d'un maillage par un plan et fermeture de la coupe
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef MESHSLICER_H
+#define MESHSLICER_H
+
+#include <QVector3D>
+#include "Mesh.h"
+#include <vector>
+
+/**
+ * @class MeshSlicer
+ * @brief Coupe triangle par triangle et couvercle tracé sur le contour réel de la coupe
+ *
+ * Les triangles à cheval sur le plan sont découpés : les sommets créés sur une
+ * arête sont partagés par les deux triangles voisins, si bien que la surface
+ * reste fermée. Chaque triangle coupé du corps (partie 0) apporte un segment du
+ * contour ; les segments sont soudés par position (coutures de texture) et
+ * chaînés en polygones, puis triangulés par découpage d'oreilles dans le plan
+ * de coupe. Les autres parties (feuilles, couronne) sont découpées sans
+ * couvercle. Les sommets qui ne servent plus sont retirés.
+ *
+ * Le résultat d'une découpe peut être découpé à nouveau : le plan suivant passe
+ * par le centre du fragment obtenu, et le couvercle précédent, rangé dans la
+ * partie 0, est coupé et refermé avec le reste du corps.
+ *
+ * Toute la mémoire de travail vient d'une Arena fournie par l'appelant et
+ * réutilisée d'une découpe à l'autre : une fois sa capacité atteinte, une
+ * découpe n'alloue plus que le résultat.
+ */
+class MeshSlicer {
+public:
+    /**
+     * @struct Arena
+     * @brief Mémoire de travail d'une découpe ; vidée à chaque appel, capacité conservée
+     *
+     * Une arène par thread : elle ne doit pas servir à deux découpes simultanées.
+     */
+    struct Arena {
+        /// Entrée d'une table à adressage ouvert (clé 0 : libre)
+        struct Slot {
+            quint64 key = 0;
+            quint32 value = 0;
+        };
+
+        /// Point du contour, soudé par position
+        struct Node {
+            qint32 cell[3];             ///< Position quantifiée (clé de soudure)
+            QVector3D position;
+            int links[2];               ///< Voisins sur le contour (-1 : aucun)
+            int capVertex;              ///< Sommet du couvercle (-1 : pas encore créé)
+            bool visited;
+        };
+
+        std::vector<float> distances;   ///< Distance signée au plan de chaque sommet, côté conservé positif
+        std::vector<quint8> inBody;     ///< Sommets lus par la partie 0
+        std::vector<Slot> edges;        ///< Arête coupée -> sommet créé
+        std::vector<Slot> nodeSlots;    ///< Position quantifiée -> point du contour
+        std::vector<Node> nodes;
+        std::vector<GLuint> segments;   ///< Paires de sommets sur le plan, une par triangle coupé du corps
+        std::vector<GLuint> indices;
+        std::vector<MeshPart> parts;
+        std::vector<int> polygon;       ///< Contour en cours de triangulation
+        std::vector<int> ring;          ///< Sommets du contour restant pendant le découpage d'oreilles
+        std::vector<float> points;      ///< Contour projeté dans le plan (x, y)
+        std::vector<GLuint> remap;      ///< Renumérotation des sommets conservés
+        std::vector<GLfloat> vertices;  ///< Sommets compactés
+    };
+
+    /**
+     * @brief Coupe la géométrie par le plan passant par le centre du corps et garde un côté
+     * @param data Géométrie complète, modifiée en place
+     * @param planeNormal Normale du plan dans le repère du modèle
+     * @param side Côté conservé : 1 dans le sens de la normale, -1 à l'opposé
+     * @param arena Mémoire de travail du thread appelant
+     * @return Nombre de triangles du couvercle
+     */
+    static int slice(MeshData& data, const QVector3D& planeNormal, int side, Arena& arena);
+
+private:
+    static constexpr float PLANE_EPSILON = 1e-4f;   ///< Sommets plus proches du plan considérés dessus
+    static constexpr float WELD_CELL = 1e-4f;       ///< Pas de la grille de soudure du contour
+
+    static void clipTriangle(MeshData& data, const GLuint* triangle, bool body, Arena& arena);
+    static GLuint edgeVertex(MeshData& data, GLuint a, GLuint b, Arena& arena);
+    static int contourNode(const MeshData& data, GLuint vertex, Arena& arena);
+    static int closeCut(MeshData& data, const QVector3D& planeNormal, int side, Arena& arena);
+    static int triangulate(MeshData& data, const QVector3D& tangent, const QVector3D& bitangent,
+                           const QVector3D& capNormal, bool reverse, Arena& arena);
+    static void compact(MeshData& data, Arena& arena);
+};
+
+#endif
@@ -0,0 +1,21 @@
+#include "MeshUploadQueue.h"
+#include <QMutexLocker>
+
+void MeshUploadQueue::expect(quint32 ownerId) {
+    QMutexLocker locker(&m_mutex);
+    m_awaited.insert(ownerId);
+}
+
+void MeshUploadQueue::post(MeshUploadRequest&& request) {
+    QMutexLocker locker(&m_mutex);
+    m_awaited.remove(request.ownerId);
+    m_pending.push_back(std::move(request));
+}
+
+void MeshUploadQueue::takeAll(std::vector<MeshUploadRequest>& requests, QSet<quint32>& awaited) {
+    requests.clear();
+    // Sous le même verrou : une demande est soit récupérée, soit encore annoncée
+    QMutexLocker locker(&m_mutex);
+    requests.swap(m_pending);
+    awaited = m_awaited;
+}
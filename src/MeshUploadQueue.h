@@ -0,0 +1,63 @@
+/**
+ * @file MeshUploadQueue.h
+ * @brief Géométries construites hors du thread OpenGL, en attente d'envoi au GPU
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef MESHUPLOADQUEUE_H
+#define MESHUPLOADQUEUE_H
+
+#include <QMutex>
+#include <QSet>
+#include "Mesh.h"
+#include <vector>
+
+/**
+ * @struct MeshUploadRequest
+ * @brief Maillages d'un objet, un par niveau de détail
+ */
+struct MeshUploadRequest {
+    quint32 ownerId = 0;                  ///< Identifiant de l'objet propriétaire
+    std::vector<PackedMeshData> levels;   ///< Géométrie compactée de chaque niveau de détail
+};
+
+/**
+ * @class MeshUploadQueue
+ * @brief File des créations de maillages demandées par la simulation
+ *
+ * La simulation ne possède pas de contexte OpenGL : elle construit la géométrie
+ * côté CPU (fragments découpés) et la dépose ici. Le thread de rendu vide la
+ * file au début de chaque image et crée les objets OpenGL correspondants.
+ *
+ * Une construction confiée à un autre thread est annoncée par expect() : tant
+ * que sa demande n'est pas déposée, le rendu sait qu'elle est en route et
+ * n'a pas à la refaire lui-même.
+ */
+class MeshUploadQueue {
+public:
+    /**
+     * @brief Annonce une demande en cours de construction (n'importe quel thread)
+     * @param ownerId Identifiant de l'objet dont les maillages seront déposés par post()
+     */
+    void expect(quint32 ownerId);
+
+    /**
+     * @brief Dépose une demande (n'importe quel thread)
+     */
+    void post(MeshUploadRequest&& request);
+
+    /**
+     * @brief Récupère toutes les demandes en attente (thread OpenGL)
+     * @param requests Vidé puis rempli ; sa capacité est réutilisée
+     * @param awaited Remplacé par les objets annoncés dont la demande n'est pas encore déposée
+     */
+    void takeAll(std::vector<MeshUploadRequest>& requests, QSet<quint32>& awaited);
+
+private:
+    QMutex m_mutex;
+    std::vector<MeshUploadRequest> m_pending;
+    QSet<quint32> m_awaited;   ///< Annoncés par expect(), retirés par post()
+};
+
+#endif
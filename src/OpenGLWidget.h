@@ -12,7 +12,15 @@
 #include <QVector>
 #include <QVector3D>
 #include <QElapsedTimer>
+#include <QLabel>
 #include "Projectile.h"
+#include "PalmCalibrationModel.h"
+#include "MeshUploadQueue.h"
+#include "SceneRenderer.h"
+#include "DynamicResolution.h"
+#include "GameSimulation.h"
+#include <memory>
+#include <vector>
 
 #include <opencv2/opencv.hpp>
 #include <opencv2/objdetect.hpp>
@@ -46,6 +54,14 @@ public:
      */
     ~OpenGLWidget();
 
+    /**
+     * @brief Règle la résolution dynamique de la scène
+     * @param minScale Échelle minimale de chaque côté de la fenêtre
+     * @param maxScale Échelle maximale de chaque côté de la fenêtre
+     * @param budgetMs Temps GPU visé par image (ms)
+     */
+    void setRenderScaling(float minScale, float maxScale, float budgetMs);
+
     /**
      * @brief Définit la position de la main en coordonnées normalisées
      * @param normX Coordonnée X normalisée (entre 0 et 1)
@@ -70,12 +86,16 @@ public:
 
     /**
      * @brief Calibre la détection de la paume
-     * @param frame Image de la webcam pour la calibration
-     * @return true si la calibration a réussi, false sinon
+     * @param gray Image de la webcam en niveaux de gris
+     * @param cascade Cascade de détection des paumes déjà chargée par la webcam
+     * @return true si une vue de la paume a été ajoutée, false sinon
      * 
-     * Détecte la paume dans l'image et extrait ses caractéristiques pour le suivi
+     * Détecte la paume dans l'image et extrait ses caractéristiques à plusieurs
+     * échelles. Après CALIBRATION_VIEWS vues (poses différentes de la main), le
+     * modèle est dédoublonné, enregistré sur disque et calibrationComplete est émis.
+     * Appelée dans le thread de la webcam (WebcamHandler::calibrationViewReady).
      */
-    bool calibratePalmDetection(const cv::Mat& frame);
+    bool calibratePalmDetection(const cv::Mat& gray, cv::CascadeClassifier& cascade);
     
     /**
      * @brief Traite la détection de la paume en continu
@@ -106,6 +126,11 @@ signals:
      * @param success Indique si la calibration a réussi
      */
     void calibrationComplete(bool success); 
+
+    /**
+     * @brief Signal émis lorsque le joueur demande une calibration (touche C)
+     */
+    void calibrationRequested();
     
     /**
      * @brief Signal émis lorsque la partie est terminée
@@ -139,12 +164,12 @@ protected:
     void paintGL() override;
     
     /**
-     * @brief Gère les événements de minuterie
-     * @param event Événement de minuterie
+     * @brief Met à jour la caméra après chaque image affichée, puis demande la suivante
      * 
-     * Met à jour la physique et la logique du jeu à intervalles réguliers
+     * Reliée à frameSwapped : le rendu suit la synchronisation verticale, la
+     * simulation avance indépendamment dans son thread
      */
-    void timerEvent(QTimerEvent* event) override;
+    void advanceFrame();
     
     /**
      * @brief Gère les événements d'appui sur les touches
@@ -169,132 +194,36 @@ private:
     float cylinderHeight = 2.0f;                     ///< Hauteur du cylindre (épée)
     bool handSet = false;                            ///< Indique si la position de la main est définie
 
-    // Ressources OpenGL
-    QOpenGLShaderProgram *shaderProgram;            ///< Programme shader pour le rendu
-    QOpenGLBuffer vbo;                              ///< Vertex Buffer Object pour les données de géométrie
+    // Rendu de la scène
+    SceneRenderer scene{cylinderRadius, cylinderHeight}; ///< Ressources OpenGL et passes de rendu
+    DynamicResolution resolution;                   ///< Cible réduite selon le temps GPU, agrandie vers la fenêtre
+    int renderedFrames = 0;                         ///< Nombre d'images rendues (journal périodique)
+    QLabel* profilerOverlay = nullptr;              ///< Affichage des mesures (touche F3)
+
+    // Simulation du jeu (projectiles, collisions), dans son propre thread
+    MeshUploadQueue meshUploads;                   ///< Maillages de fragments construits par la simulation
+    std::unique_ptr<GameSimulation> simulation;    ///< Apparitions, physique et collisions à pas fixe
 
-    // Gestion des projectiles
-    QVector<Projectile> projectiles;                ///< Projectiles actifs
-    QVector<Projectile> pendingProjectiles;         ///< Projectiles en attente d'ajout
-    
-    /**
-     * @brief Génère un nouveau projectile
-     * 
-     * Crée un projectile avec une position et une vitesse aléatoires
-     */
-    void spawnProjectile();
-    
-    /**
-     * @brief Met à jour la position et l'état des projectiles
-     * @param deltaTime Temps écoulé depuis la dernière mise à jour
-     * 
-     * Applique la physique et supprime les projectiles inactifs
-     */
-    void updateProjectiles(float deltaTime);
-    
     /**
-     * @brief Vérifie les collisions entre l'épée et les projectiles
-     * 
-     * Détecte si l'épée a touché un projectile et le découpe si c'est le cas
+     * @brief Transmet la position courante de la main à la simulation
      */
-    void checkCollisions();
-    
+    void forwardHandPosition();
+
     /**
-     * @brief Dessine la zone de génération des projectiles
-     * 
-     * Représentation visuelle de la zone d'où proviennent les projectiles
+     * @brief Ligne du rapport de mesures décrivant la résolution de rendu courante
      */
-    void drawSpawningZone(); 
+    QString renderScaleReport() const;
 
-    // Gestion du temps et de l'état du jeu
-    int timerId;                                   ///< ID du timer pour les mises à jour régulières
+    // Gestion du temps
     QElapsedTimer elapsedTimer;                    ///< Chronomètre pour mesurer le temps écoulé
-    float gameTime = 0.0f;                         ///< Temps total de jeu en secondes
     float deltaTime = 0.0f;                        ///< Temps écoulé entre deux frames
-    float lastSpawnTime = 0.0f;                    ///< Moment du dernier spawn de projectile
-    float spawnInterval = 2.0f;                    ///< Intervalle entre deux spawns de projectiles
-    int score = 0;                                 ///< Score actuel du joueur
-
-    bool isGameRunning = true;                     ///< Indique si le jeu est en cours
-    bool gameOverEffect = false;                   ///< Indique si l'effet de fin de jeu est actif
-    float gameOverEffectTime = 0.0f;               ///< Temps écoulé depuis le début de l'effet de fin de jeu
-
-    // Méthodes de rendu
-    /**
-     * @brief Dessine un cylindre (l'épée)
-     * 
-     * Crée la géométrie d'un cylindre et le rend avec les textures appropriées
-     */
-    void drawCylinder();
-    
-    /**
-     * @brief Dessine une sphère
-     * @param radius Rayon de la sphère
-     * @param lats Nombre de latitudes
-     * @param longs Nombre de longitudes
-     * 
-     * Crée la géométrie d'une sphère avec le niveau de détail spécifié
-     */
-    void drawSphere(float radius, int lats, int longs);
-    
-    /**
-     * @brief Dessine l'épée
-     * 
-     * Rend l'épée complète (lame et poignée)
-     */
-    void drawSword(); 
-    
-    /**
-     * @brief Dessine l'ombre de l'épée
-     * 
-     * Projette une ombre de l'épée sur le sol
-     */
-    void drawSwordShadow(); 
-    
-    /**
-     * @brief Dessine le sol
-     * 
-     * Rend le sol avec sa texture
-     */
-    void drawGround();  
-    
-    /**
-     * @brief Dessine les murs
-     * 
-     * Rend les murs avec leurs textures
-     */
-    void drawWalls();  
-    
-    /**
-     * @brief Dessine le plafond
-     * 
-     * Rend le plafond avec sa texture
-     */
-    void drawRoof();  
-    
-    /**
-     * @brief Dessine une source de lumière
-     * @param position Position de la source de lumière
-     * 
-     * Représentation visuelle d'une source de lumière dans la scène
-     */
-    void drawLightSource(const QVector3D& position); 
-
-    // Textures
-    QOpenGLTexture* bladeTexture = nullptr;        ///< Texture pour la lame de l'épée
-    QOpenGLTexture* handleTexture = nullptr;       ///< Texture pour la poignée de l'épée
-    QOpenGLTexture* groundTexture = nullptr;       ///< Texture pour le sol
-    QOpenGLTexture* wallTexture = nullptr;         ///< Texture pour les murs
-    QOpenGLTexture* backWallTexture = nullptr;     ///< Texture pour le mur du fond
-    QOpenGLTexture* roofTexture = nullptr;         ///< Texture pour le plafond
+    bool firstFrameShown = false;                  ///< Indique si la première image a été affichée
 
     // Matrices de transformation
     QMatrix4x4 projection;                         ///< Matrice de projection
     QMatrix4x4 view;                               ///< Matrice de vue
 
     // Détection et suivi de la paume
-    cv::CascadeClassifier palmCascade;             ///< Classificateur en cascade pour la détection des paumes
-    bool palmCascadeLoaded = false;                ///< Indique si le classificateur a été chargé
     bool isCalibrated = false;                     ///< Indique si la calibration a été effectuée
     cv::Rect calibratedPalmRegion;                 ///< Région contenant la paume calibrée
 
@@ -303,14 +232,16 @@ private:
     cv::Ptr<cv::FlannBasedMatcher> flannMatcher;          ///< Algorithme de mise en correspondance
     std::vector<cv::KeyPoint> calibrationKeypoints;       ///< Points caractéristiques de référence
     cv::Mat calibrationDescriptors;                       ///< Descripteurs des points caractéristiques de référence
+    PalmCalibrationModel calibrationModel;                ///< Vues collectées pendant la calibration
+    static constexpr int CALIBRATION_VIEWS = 5;           ///< Nombre de poses de la main à collecter
 
     /**
      * @brief Initialise les détecteurs de paume
-     * @return true si l'initialisation a réussi, false sinon
      * 
-     * Charge le classificateur en cascade et initialise les détecteurs de caractéristiques
+     * Crée les détecteurs de caractéristiques ORB et l'index de recherche LSH ;
+     * la cascade est celle de la webcam
      */
-    bool initializePalmDetection();
+    void initializePalmDetection();
     
     /**
      * @brief Suit le mouvement de la paume
@@ -335,6 +266,7 @@ private:
     float cameraYaw = 0.0f;                        ///< Rotation horizontale de la caméra
     float cameraPitch = 0.0f;                      ///< Rotation verticale de la caméra
     float cameraDistance = 5.0f;                   ///< Distance de la caméra au centre de la scène
+    float fieldOfView = 45.0f;                     ///< Angle de vue vertical en degrés
     bool keysPressed[4] = {false};                 ///< État des touches de contrôle de la caméra
 
     float cameraRotationSpeed = 70.0f;             ///< Vitesse de rotation de la caméra
@@ -346,6 +278,4 @@ private:
      * Applique les mouvements de caméra en fonction des touches pressées
      */
     void updateCamera();
-
-    QOpenGLBuffer zoneVBO;                         ///< Buffer pour la zone de génération des projectiles
 };
\ No newline at end of file
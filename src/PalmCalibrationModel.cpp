@@ -0,0 +1,157 @@
+#include "PalmCalibrationModel.h"
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+#include <QStandardPaths>
+#include <algorithm>
+#include <numeric>
+
+namespace {
+
+const float VIEW_SCALES[] = { 0.75f, 1.0f, 1.3f };
+
+}
+
+int PalmCalibrationModel::addView(const cv::Mat& gray, const cv::Rect& region, const cv::Ptr<cv::Feature2D>& extractor) {
+    cv::Rect roi = region & cv::Rect(0, 0, gray.cols, gray.rows);
+    if (roi.empty() || !extractor) {
+        return 0;
+    }
+
+    int collected = 0;
+
+    for (float scale : VIEW_SCALES) {
+        cv::Mat scaled;
+        cv::resize(gray(roi), scaled, cv::Size(), scale, scale, scale < 1.0f ? cv::INTER_AREA : cv::INTER_LINEAR);
+
+        std::vector<cv::KeyPoint> keypoints;
+        cv::Mat descriptors;
+        extractor->detectAndCompute(scaled, cv::noArray(), keypoints, descriptors);
+
+        if (keypoints.empty() || descriptors.empty()) {
+            continue;
+        }
+
+        for (auto& keypoint : keypoints) {
+            keypoint.pt /= scale;
+            keypoint.size /= scale;
+        }
+
+        m_candidateKeypoints.insert(m_candidateKeypoints.end(), keypoints.begin(), keypoints.end());
+        m_candidateDescriptors.push_back(descriptors);
+        collected += descriptors.rows;
+    }
+
+    if (collected > 0) {
+        m_region = roi;
+        m_viewCount++;
+    }
+
+    return collected;
+}
+
+void PalmCalibrationModel::finalize() {
+    if (m_candidateDescriptors.empty()) {
+        return;
+    }
+
+    std::vector<int> order(m_candidateKeypoints.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        return m_candidateKeypoints[a].response > m_candidateKeypoints[b].response;
+    });
+
+    m_keypoints.clear();
+    m_descriptors.release();
+
+    for (int index : order) {
+        if (m_descriptors.rows >= MAX_DESCRIPTORS) {
+            break;
+        }
+
+        cv::Mat candidate = m_candidateDescriptors.row(index);
+
+        bool duplicate = false;
+        for (int i = 0; i < m_descriptors.rows; ++i) {
+            if (cv::norm(candidate, m_descriptors.row(i), cv::NORM_HAMMING) < DUPLICATE_DISTANCE) {
+                duplicate = true;
+                break;
+            }
+        }
+
+        if (!duplicate) {
+            m_keypoints.push_back(m_candidateKeypoints[index]);
+            m_descriptors.push_back(candidate);
+        }
+    }
+
+    qDebug() << "Palm model:" << m_descriptors.rows << "descriptors kept out of"
+             << m_candidateDescriptors.rows << "from" << m_viewCount << "views";
+}
+
+bool PalmCalibrationModel::save(const QString& path) const {
+    if (isEmpty()) {
+        return false;
+    }
+
+    QDir().mkpath(QFileInfo(path).absolutePath());
+
+    cv::FileStorage fs(path.toStdString(), cv::FileStorage::WRITE);
+    if (!fs.isOpened()) {
+        qWarning() << "Could not write palm model:" << path;
+        return false;
+    }
+
+    fs << "version" << FORMAT_VERSION;
+    fs << "views" << m_viewCount;
+    fs << "region" << m_region;
+    cv::write(fs, "keypoints", m_keypoints);
+    fs << "descriptors" << m_descriptors;
+
+    return true;
+}
+
+bool PalmCalibrationModel::load(const QString& path) {
+    cv::FileStorage fs;
+    try {
+        if (!fs.open(path.toStdString(), cv::FileStorage::READ)) {
+            return false;
+        }
+    } catch (const cv::Exception& e) {
+        qWarning() << "Could not read palm model:" << e.what();
+        return false;
+    }
+
+    if (int(fs["version"]) != FORMAT_VERSION) {
+        qWarning() << "Unsupported palm model version in" << path;
+        return false;
+    }
+
+    clear();
+
+    m_viewCount = int(fs["views"]);
+    fs["region"] >> m_region;
+    cv::read(fs["keypoints"], m_keypoints);
+    fs["descriptors"] >> m_descriptors;
+
+    if (m_descriptors.empty() || m_descriptors.type() != CV_8U || m_descriptors.rows != int(m_keypoints.size())) {
+        qWarning() << "Invalid palm model:" << path;
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+void PalmCalibrationModel::clear() {
+    m_region = cv::Rect();
+    m_viewCount = 0;
+    m_candidateKeypoints.clear();
+    m_candidateDescriptors.release();
+    m_keypoints.clear();
+    m_descriptors.release();
+}
+
+QString PalmCalibrationModel::defaultPath() {
+    return QDir(QStandardPaths::writableLocation(QStandardPaths::AppDataLocation)).filePath("palm_model.yml");
+}
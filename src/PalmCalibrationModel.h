@@ -0,0 +1,92 @@
+/**
+ * @file PalmCalibrationModel.h
+ * @brief Modèle de calibration de la paume construit à partir de plusieurs vues
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef PALMCALIBRATIONMODEL_H
+#define PALMCALIBRATIONMODEL_H
+
+#include <QString>
+#include <opencv2/opencv.hpp>
+#include <opencv2/features2d.hpp>
+#include <vector>
+
+/**
+ * @class PalmCalibrationModel
+ * @brief Ensemble compact de descripteurs ORB représentant la paume du joueur
+ *
+ * Les descripteurs sont collectés sur plusieurs poses de la main et à plusieurs
+ * échelles, puis dédoublonnés (distance de Hamming) pour ne garder qu'un modèle
+ * compact. Le modèle est enregistré sur disque afin que le suivi fonctionne dès
+ * la première image au lancement suivant, sans nouvelle calibration.
+ */
+class PalmCalibrationModel {
+public:
+    static constexpr int MAX_DESCRIPTORS = 400;     ///< Taille maximale du modèle compact
+    static constexpr int DUPLICATE_DISTANCE = 24;   ///< Distance de Hamming en dessous de laquelle deux descripteurs sont redondants
+    static constexpr int FORMAT_VERSION = 1;        ///< Version du format de fichier
+
+    /**
+     * @brief Ajoute une vue de la paume au modèle
+     * @param gray Image en niveaux de gris
+     * @param region Région contenant la paume
+     * @param extractor Détecteur/extracteur ORB
+     * @return Nombre de descripteurs collectés pour cette vue
+     *
+     * La région est analysée à plusieurs échelles ; les points sont ramenés
+     * dans le repère de la région d'origine.
+     */
+    int addView(const cv::Mat& gray, const cv::Rect& region, const cv::Ptr<cv::Feature2D>& extractor);
+
+    /**
+     * @brief Dédoublonne les descripteurs collectés pour former le modèle compact
+     *
+     * Les points sont parcourus par réponse décroissante ; un descripteur n'est gardé
+     * que s'il est suffisamment éloigné de tous ceux déjà retenus.
+     */
+    void finalize();
+
+    /**
+     * @brief Enregistre le modèle compact sur disque
+     * @param path Chemin du fichier (YAML/XML OpenCV)
+     * @return true si l'écriture a réussi
+     */
+    bool save(const QString& path) const;
+
+    /**
+     * @brief Charge un modèle enregistré
+     * @param path Chemin du fichier
+     * @return true si un modèle valide a été lu
+     */
+    bool load(const QString& path);
+
+    /**
+     * @brief Efface les vues collectées et le modèle
+     */
+    void clear();
+
+    /**
+     * @brief Chemin par défaut du modèle dans le dossier de données de l'application
+     */
+    static QString defaultPath();
+
+    int viewCount() const { return m_viewCount; }
+    bool isEmpty() const { return m_descriptors.empty(); }
+    const cv::Rect& region() const { return m_region; }
+    const std::vector<cv::KeyPoint>& keypoints() const { return m_keypoints; }
+    const cv::Mat& descriptors() const { return m_descriptors; }
+
+private:
+    cv::Rect m_region;                              ///< Région de la dernière vue
+    int m_viewCount = 0;                            ///< Nombre de vues collectées
+
+    std::vector<cv::KeyPoint> m_candidateKeypoints; ///< Points collectés, avant dédoublonnage
+    cv::Mat m_candidateDescriptors;                 ///< Descripteurs collectés, avant dédoublonnage
+
+    std::vector<cv::KeyPoint> m_keypoints;          ///< Points du modèle compact
+    cv::Mat m_descriptors;                          ///< Descripteurs du modèle compact
+};
+
+#endif
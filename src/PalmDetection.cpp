@@ -1,34 +1,23 @@
 #include "OpenGLWidget.h"
 #include <QDebug>
-#include <QDir>
-
-bool OpenGLWidget::initializePalmDetection() {
-
-    QString cascadePath = QDir::currentPath() + "/palm.xml";
-    palmCascadeLoaded = palmCascade.load(cascadePath.toStdString());
-
-    if (!palmCascadeLoaded) {
-        qDebug() << "Failed to load palm cascade from:" << cascadePath;
-        return false;
-    }
+#include <limits>
 
+void OpenGLWidget::initializePalmDetection() {
     featureDetector = cv::ORB::create();
     descriptorExtractor = cv::ORB::create();
-    flannMatcher = cv::FlannBasedMatcher::create();
-
-    return true;
+    flannMatcher = cv::makePtr<cv::FlannBasedMatcher>(cv::makePtr<cv::flann::LshIndexParams>(12, 20, 2));
 }
 
-bool OpenGLWidget::calibratePalmDetection(const cv::Mat& frame) {
-    if (!palmCascadeLoaded && !initializePalmDetection()) {
+bool OpenGLWidget::calibratePalmDetection(const cv::Mat& gray, cv::CascadeClassifier& cascade) {
+    if (cascade.empty()) {
         return false;
     }
-
-    cv::Mat grayFrame;
-    cv::cvtColor(frame, grayFrame, cv::COLOR_BGR2GRAY);
+    if (!featureDetector) {
+        initializePalmDetection();
+    }
 
     std::vector<cv::Rect> palms;
-    palmCascade.detectMultiScale(grayFrame, palms, 1.1, 3, 0, cv::Size(30, 30));
+    cascade.detectMultiScale(gray, palms, 1.1, 3, 0, cv::Size(30, 30));
 
     if (palms.empty()) {
         qDebug() << "No palm detected during calibration";
@@ -38,16 +27,30 @@ bool OpenGLWidget::calibratePalmDetection(const cv::Mat& frame) {
     calibratedPalmRegion = *std::max_element(palms.begin(), palms.end(), 
         [](const cv::Rect& a, const cv::Rect& b) { return a.area() < b.area(); });
 
-    cv::Mat palmROI = grayFrame(calibratedPalmRegion);
-
-    featureDetector->detect(palmROI, calibrationKeypoints);
-    descriptorExtractor->compute(palmROI, calibrationKeypoints, calibrationDescriptors);
-
-    if (calibrationKeypoints.empty()) {
+    if (calibrationModel.addView(gray, calibratedPalmRegion, featureDetector) == 0) {
         qDebug() << "No keypoints found in palm region";
         return false;
     }
 
+    if (calibrationModel.viewCount() < CALIBRATION_VIEWS) {
+        qDebug() << "Palm view" << calibrationModel.viewCount() << "of" << CALIBRATION_VIEWS << "captured";
+        return true;
+    }
+
+    calibrationModel.finalize();
+    if (!calibrationModel.save(PalmCalibrationModel::defaultPath())) {
+        qWarning() << "Palm model could not be saved, calibration will be needed on next launch";
+    }
+
+    calibrationKeypoints = calibrationModel.keypoints();
+    calibrationDescriptors = calibrationModel.descriptors().clone();
+
+    flannMatcher->clear();
+    flannMatcher->add(std::vector<cv::Mat>{ calibrationDescriptors });
+    flannMatcher->train();
+
+    calibrationModel.clear();
+
     isCalibrated = true;
     emit calibrationComplete(true);
     return true;
@@ -82,10 +85,10 @@ cv::Point2f OpenGLWidget::trackPalmMovement(const cv::Mat& frame) {
     }
 
     std::vector<cv::DMatch> matches;
-    flannMatcher->match(calibrationDescriptors, currentDescriptors, matches);
+    flannMatcher->match(currentDescriptors, matches);
 
     double maxDist = 0;
-    double minDist = 100;
+    double minDist = std::numeric_limits<double>::max();
     for (const auto& match : matches) {
         double dist = match.distance;
         if (dist < minDist) minDist = dist;
@@ -105,7 +108,7 @@ cv::Point2f OpenGLWidget::trackPalmMovement(const cv::Mat& frame) {
 
     cv::Point2f center(0, 0);
     for (const auto& match : goodMatches) {
-        center += currentKeypoints[match.trainIdx].pt;
+        center += currentKeypoints[match.queryIdx].pt;
     }
     center.x /= goodMatches.size();
     center.y /= goodMatches.size();
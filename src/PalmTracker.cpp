@@ -1,60 +1,186 @@
 #include "PalmTracker.h"
+#include "PalmCalibrationModel.h"
 #include <QDebug>
+#include <QMutexLocker>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 PalmTracker::PalmTracker(QObject *parent) : QObject(parent) {
 
-    featureDetector = cv::ORB::create();
-    descriptorExtractor = cv::ORB::create();
-    flannMatcher = cv::FlannBasedMatcher::create();
+    orb = cv::ORB::create(VisionBufferPool::MAX_FEATURES, float(PYRAMID_SCALE_FACTOR), 1);
+    flannMatcher = cv::makePtr<cv::FlannBasedMatcher>(cv::makePtr<cv::flann::LshIndexParams>(12, 20, 2));
 }
 
 void PalmTracker::setCalibrationData(const cv::Rect& region, 
                                     const std::vector<cv::KeyPoint>& keypoints,
                                     const cv::Mat& descriptors) {
+    QMutexLocker locker(&mutex);
+
     palmRegion = region;
     calibrationKeypoints = keypoints;
     calibrationDescriptors = descriptors.clone();
     isInitialized = !keypoints.empty() && !descriptors.empty();
+
+    if (isInitialized) {
+        buildMatcherIndex();
+    }
+}
+
+void PalmTracker::setCalibrationModel(const PalmCalibrationModel& model) {
+    setCalibrationData(model.region(), model.keypoints(), model.descriptors());
+}
+
+void PalmTracker::buildMatcherIndex() {
+    flannMatcher->clear();
+    flannMatcher->add(std::vector<cv::Mat>{ calibrationDescriptors });
+    flannMatcher->train();
 }
 
 bool PalmTracker::trackPalm(const cv::Mat& frame) {
-    if (!isInitialized) {
-        return false;
+    QPointF position;
+    {
+        QMutexLocker locker(&mutex);
+
+        if (!isInitialized) {
+            return false;
+        }
+
+        if (!buffers.isConfiguredFor(frame.size())) {
+            buffers.configure(frame.size(), QSize());
+        }
+        if (!pyramid.isConfiguredFor(frame.size())) {
+            pyramid.configure(frame.size(), PYRAMID_SCALE_FACTOR, cv::Size(32, 32), ORB_LEVELS);
+        }
+
+        const cv::Mat* source = &frame;
+        if (frame.channels() != 1) {
+            cv::cvtColor(frame, buffers.gray(), cv::COLOR_BGR2GRAY);
+            source = &buffers.gray();
+        }
+        pyramid.build(*source);
+
+        if (!updatePosition(pyramid, position)) {
+            return false;
+        }
     }
 
-    lastFrameSize = frame.size();
+    emit palmPositionChanged(position.x(), position.y());
+    return true;
+}
 
-    cv::Mat grayFrame;
-    cv::cvtColor(frame, grayFrame, cv::COLOR_BGR2GRAY);
+bool PalmTracker::trackPalm(const ImagePyramid& sharedPyramid) {
+    QPointF position;
+    {
+        QMutexLocker locker(&mutex);
 
-    std::vector<cv::KeyPoint> currentKeypoints;
-    cv::Mat currentDescriptors;
-    featureDetector->detect(grayFrame, currentKeypoints);
-    if (currentKeypoints.empty()) {
+        if (!isInitialized || sharedPyramid.levelCount() == 0) {
+            return false;
+        }
+
+        if (!updatePosition(sharedPyramid, position)) {
+            return false;
+        }
+    }
+
+    emit palmPositionChanged(position.x(), position.y());
+    return true;
+}
+
+bool PalmTracker::updatePosition(const ImagePyramid& source, QPointF& position) {
+    lastFrameSize = source.baseSize();
+
+    if (!buffers.isConfiguredFor(lastFrameSize)) {
+        buffers.configure(lastFrameSize, QSize());
+    }
+
+    buffers.beginFrame();
+    bool found = locatePalm(source);
+    buffers.endFrame();
+
+    if (!found) {
         return false;
     }
 
-    descriptorExtractor->compute(grayFrame, currentKeypoints, currentDescriptors);
-    if (currentDescriptors.empty()) {
+    normalizedPosition.setX(currentPosition.x / lastFrameSize.width);
+    normalizedPosition.setY(currentPosition.y / lastFrameSize.height);
+    position = normalizedPosition;
+    return true;
+}
+
+void PalmTracker::extractFeatures(const ImagePyramid& source, std::vector<cv::KeyPoint>& keypoints, cv::Mat& descriptors) {
+    cv::Mat& storage = buffers.descriptors();
+    std::vector<cv::KeyPoint>& levelKeypoints = buffers.levelKeypoints();
+    const int levels = std::min(source.levelCount(), ORB_LEVELS);
+    const int maxFeatures = storage.rows;
+
+    keypoints.clear();
+    descriptors = storage.rowRange(0, 0);
+
+    const double factor = 1.0 / source.scaleFactor();
+    double desired = maxFeatures * (1.0 - factor) / (1.0 - std::pow(factor, levels));
+    int assigned = 0;
+    int rows = 0;
+
+    for (int i = 0; i < levels; ++i) {
+        int budget = (i == levels - 1) ? std::max(maxFeatures - assigned, 0) : cvRound(desired);
+        assigned += budget;
+        desired *= factor;
+
+        if (budget == 0) {
+            continue;
+        }
+
+        orb->setMaxFeatures(budget);
+        cv::Mat& levelDescriptors = buffers.levelDescriptors(i);
+        orb->detectAndCompute(source.level(i), cv::noArray(), levelKeypoints, levelDescriptors);
+
+        const int count = std::min(int(levelKeypoints.size()), maxFeatures - rows);
+        if (count <= 0 || levelDescriptors.empty()) {
+            continue;
+        }
+
+        const float scale = float(source.scale(i));
+        for (int k = 0; k < count; ++k) {
+            cv::KeyPoint keypoint = levelKeypoints[k];
+            keypoint.pt *= scale;
+            keypoint.size *= scale;
+            keypoint.octave = i;
+            keypoints.push_back(keypoint);
+        }
+
+        levelDescriptors.rowRange(0, count).copyTo(storage.rowRange(rows, rows + count));
+        rows += count;
+    }
+
+    descriptors = storage.rowRange(0, rows);
+}
+
+bool PalmTracker::locatePalm(const ImagePyramid& source) {
+    std::vector<cv::KeyPoint>& currentKeypoints = buffers.keypoints();
+    cv::Mat currentDescriptors;
+    extractFeatures(source, currentKeypoints, currentDescriptors);
+    if (currentKeypoints.empty() || currentDescriptors.empty()) {
         return false;
     }
 
-    std::vector<cv::DMatch> matches;
-    flannMatcher->match(calibrationDescriptors, currentDescriptors, matches);
+    std::vector<cv::DMatch>& matches = buffers.matches();
+    flannMatcher->match(currentDescriptors, matches);
 
     if (matches.empty()) {
         return false;
     }
 
     double maxDist = 0;
-    double minDist = 100;
+    double minDist = std::numeric_limits<double>::max();
     for (const auto& match : matches) {
         double dist = match.distance;
         if (dist < minDist) minDist = dist;
         if (dist > maxDist) maxDist = dist;
     }
 
-    std::vector<cv::DMatch> goodMatches;
+    std::vector<cv::DMatch>& goodMatches = buffers.goodMatches();
+    goodMatches.clear();
     for (const auto& match : matches) {
         if (match.distance < std::max(2*minDist, 0.02)) {
             goodMatches.push_back(match);
@@ -67,20 +193,16 @@ bool PalmTracker::trackPalm(const cv::Mat& frame) {
 
     cv::Point2f center(0, 0);
     for (const auto& match : goodMatches) {
-        center += currentKeypoints[match.trainIdx].pt;
+        center += currentKeypoints[match.queryIdx].pt;
     }
     center.x /= goodMatches.size();
     center.y /= goodMatches.size();
 
     currentPosition = center;
-
-    normalizedPosition.setX(currentPosition.x / lastFrameSize.width);
-    normalizedPosition.setY(currentPosition.y / lastFrameSize.height);
-
-    emit palmPositionChanged(normalizedPosition.x(), normalizedPosition.y());
     return true;
 }
 
 QPointF PalmTracker::getNormalizedPosition() const {
+    QMutexLocker locker(&mutex);
     return normalizedPosition;
 }
\ No newline at end of file
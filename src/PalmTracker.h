@@ -8,10 +8,15 @@
 #pragma once
 
 #include <QObject>
+#include <QMutex>
 #include <QPointF>  
 #include <opencv2/opencv.hpp>
 #include <opencv2/features2d.hpp>
 #include <opencv2/flann.hpp>
+#include "VisionBufferPool.h"
+#include "ImagePyramid.h"
+
+class PalmCalibrationModel;
 
 /**
  * @class PalmTracker
@@ -39,26 +44,60 @@ public:
      * @param descriptors Descripteurs des points caractéristiques
      * 
      * Cette méthode enregistre les informations de référence qui seront utilisées
-     * pour le suivi de la paume dans les images ultérieures.
+     * pour le suivi de la paume dans les images ultérieures. L'index de recherche
+     * (LSH, adapté aux descripteurs binaires ORB) est construit une seule fois ici.
      */
     void setCalibrationData(const cv::Rect& region, 
                            const std::vector<cv::KeyPoint>& keypoints,
                            const cv::Mat& descriptors);
 
+    /**
+     * @brief Utilise un modèle de calibration multi-vues
+     * @param model Modèle compact, typiquement rechargé depuis le disque au lancement
+     */
+    void setCalibrationModel(const PalmCalibrationModel& model);
+
+    /**
+     * @brief Indique si des données de calibration sont disponibles
+     */
+    bool isCalibrated() const { QMutexLocker locker(&mutex); return isInitialized; }
+
     /**
      * @brief Tente de localiser la paume dans une image
-     * @param frame Image dans laquelle chercher la paume
+     * @param frame Image dans laquelle chercher la paume (BGR, ou déjà en niveaux de gris)
      * @return true si la paume a été localisée avec succès, false sinon
      * 
+     * Une image en niveaux de gris issue du prétraitement partagé est utilisée
+     * telle quelle, sans nouvelle conversion.
+     *
      * Algorithme:
      * 1. Détecte les points caractéristiques dans l'image
      * 2. Extrait leurs descripteurs
-     * 3. Fait correspondre ces descripteurs avec ceux de calibration
+     * 3. Cherche leurs plus proches voisins dans l'index de calibration
      * 4. Estime la position actuelle de la paume
      * 5. Met à jour la position normalisée
      */
     bool trackPalm(const cv::Mat& frame);
 
+    /**
+     * @brief Tente de localiser la paume à partir d'une pyramide déjà construite
+     * @param pyramid Pyramide en niveaux de gris partagée avec la détection
+     * @return true si la paume a été localisée avec succès, false sinon
+     *
+     * Les points ORB sont extraits niveau par niveau sur la pyramide fournie,
+     * sans qu'ORB en reconstruise une.
+     */
+    bool trackPalm(const ImagePyramid& pyramid);
+
+    static constexpr double PYRAMID_SCALE_FACTOR = 1.189207115; ///< 2^(1/4) : un niveau sur quatre est une octave exacte
+    static constexpr int ORB_LEVELS = 8;                         ///< Nombre de niveaux utilisés par ORB
+    static_assert(ORB_LEVELS <= VisionBufferPool::MAX_LEVELS, "each ORB level needs its own pooled descriptors");
+
+    /**
+     * @brief Nombre total de tampons réalloués par le suivi (tout thread)
+     */
+    quint64 bufferAllocations() const { return buffers.allocationCount(); }
+
     /**
      * @brief Renvoie la position normalisée actuelle de la paume
      * @return Position normalisée (x,y dans l'intervalle [0,1])
@@ -74,16 +113,50 @@ signals:
     void palmPositionChanged(float normX, float normY);
 
 private:
+    /**
+     * @brief Localise la paume dans l'image à l'aide des tampons réutilisables
+     * @param frame Image dans laquelle chercher la paume
+     * @return true si une position a été trouvée (currentPosition est alors mise à jour)
+     */
+    bool locatePalm(const ImagePyramid& pyramid);
+
+    /**
+     * @brief Localise la paume et met à jour la position normalisée
+     * @param pyramid Pyramide de l'image courante
+     * @param position Position normalisée trouvée
+     * @return true si une position a été trouvée
+     *
+     * Doit être appelée avec le verrou pris.
+     */
+    bool updatePosition(const ImagePyramid& pyramid, QPointF& position);
+
+    /**
+     * @brief Extrait les points ORB de chaque niveau de la pyramide
+     * @param pyramid Pyramide de l'image courante
+     * @param keypoints Points ramenés dans le repère du niveau 0
+     * @param descriptors Descripteurs (en-tête sur les tampons réutilisables)
+     *
+     * Le nombre de points par niveau suit la répartition utilisée par ORB.
+     */
+    void extractFeatures(const ImagePyramid& pyramid, std::vector<cv::KeyPoint>& keypoints, cv::Mat& descriptors);
+
+    /**
+     * @brief Construit l'index de recherche sur les descripteurs de calibration
+     */
+    void buildMatcherIndex();
+
     cv::Rect palmRegion;            ///< Région d'intérêt contenant la paume
     std::vector<cv::KeyPoint> calibrationKeypoints;  ///< Points caractéristiques de référence
     cv::Mat calibrationDescriptors; ///< Descripteurs des points caractéristiques de référence
     bool isInitialized = false;     ///< Indicateur de l'état d'initialisation
 
-    cv::Ptr<cv::FeatureDetector> featureDetector;        ///< Détecteur de points caractéristiques
-    cv::Ptr<cv::DescriptorExtractor> descriptorExtractor; ///< Extracteur de descripteurs
+    cv::Ptr<cv::ORB> orb;           ///< Détecteur/extracteur ORB à un seul niveau, appliqué à chaque niveau de la pyramide
     cv::Ptr<cv::FlannBasedMatcher> flannMatcher;         ///< Algorithme de mise en correspondance
 
     cv::Point2f currentPosition;    ///< Position actuelle en pixels
     QPointF normalizedPosition;     ///< Position normalisée entre 0 et 1
     cv::Size lastFrameSize;         ///< Taille de la dernière image traitée
+    VisionBufferPool buffers;       ///< Tampons réutilisés d'une image à l'autre
+    ImagePyramid pyramid;           ///< Pyramide propre, lorsqu'aucune n'est fournie
+    mutable QMutex mutex;           ///< Protège l'état entre le thread de capture et l'interface
 };
\ No newline at end of file
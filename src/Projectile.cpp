@@ -1,28 +1,36 @@
 #include "Projectile.h"
+#include "MeshSlicer.h"
 #include <QtMath>
-#include <QOpenGLContext>
+#include <QDebug>
 #include <QRandomGenerator>
-#include <set>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace {
+
+quint32 nextProjectileId() {
+    static std::atomic<quint32> counter{ 1 };
+    return counter++;
+}
+
+}
 
 Projectile::Projectile(Type type, const QVector3D& position, const QVector3D& velocity)
-    : m_type(type), 
+    : m_id(nextProjectileId()),
+      m_type(type), 
       m_position(position), 
       m_velocity(velocity),
       m_rotationAngle(0.0f),
       m_rotationAxis(0.0f, 1.0f, 0.0f),
       m_active(true),
       m_scale(1.0f),
-      m_texture(nullptr),
-      m_hasTexture(false),
-      m_vao(0),
-      m_vbo(0),
-      m_ebo(0),
-      m_initialized(false),
       m_isFragment(false),
       m_causedGameOver(false)
 {
 
     m_rotationAngle = QRandomGenerator::global()->bounded(360);
+    storePreviousState();
 
     m_rotationAxis = QVector3D(
         QRandomGenerator::global()->bounded(-100, 100) / 100.0f,
@@ -33,76 +41,6 @@ Projectile::Projectile(Type type, const QVector3D& position, const QVector3D& ve
     limitVelocity();
 }
 
-Projectile::~Projectile() {
-    if (m_initialized) {
-        this->glDeleteBuffers(1, &m_vbo);
-        this->glDeleteBuffers(1, &m_ebo);
-
-        if (QOpenGLContext::currentContext()) {
-            QOpenGLContext::currentContext()->extraFunctions()->glDeleteVertexArrays(1, &m_vao);
-        }
-    }
-}
-
-void Projectile::initializeGL() {
-
-    if (m_initialized) return;
-
-    initializeOpenGLFunctions();
-
-    QOpenGLContext::currentContext()->extraFunctions()->glGenVertexArrays(1, &m_vao);
-    this->glGenBuffers(1, &m_vbo);
-    this->glGenBuffers(1, &m_ebo);
-
-    if (m_type == Type::APPLE) {   
-        if (m_texture) delete m_texture; 
-
-        m_texture = new QOpenGLTexture(QImage(":/new/prefix2/resources/images/apple_texture.jpg").flipped());
-        m_texture->setMinificationFilter(QOpenGLTexture::LinearMipMapLinear);
-        m_texture->setMagnificationFilter(QOpenGLTexture::Linear);
-        m_texture->setWrapMode(QOpenGLTexture::Repeat);
-        m_hasTexture = true;
-    }
-
-    else if (m_type == Type::BANANA) {
-        if (m_texture) delete m_texture;
-        m_texture = new QOpenGLTexture(QImage(":/new/prefix2/resources/images/banana4_texture.jpg").flipped());
-        m_texture->setMinificationFilter(QOpenGLTexture::LinearMipMapLinear);
-        m_texture->setMagnificationFilter(QOpenGLTexture::Linear);
-        m_texture->setWrapMode(QOpenGLTexture::Repeat);
-        m_hasTexture= true;
-    }
-
-    else if (m_type == Type::FRAISE) {
-        if (m_texture) delete m_texture;
-        m_texture = new QOpenGLTexture(QImage(":/new/prefix2/resources/images/Fraise_texture.jpg").flipped());
-        m_texture->setMinificationFilter(QOpenGLTexture::LinearMipMapLinear);
-        m_texture->setMagnificationFilter(QOpenGLTexture::Linear);
-        m_texture->setWrapMode(QOpenGLTexture::Repeat);
-        m_hasTexture = true;
-    }
-
-    else if (m_type == Type::ANANAS) {
-        if (m_texture) delete m_texture;
-        m_texture = new QOpenGLTexture(QImage(":/new/prefix2/resources/images/ananas2_texture.jpg").flipped());
-        m_texture->setMinificationFilter(QOpenGLTexture::LinearMipMapLinear);
-        m_texture->setMagnificationFilter(QOpenGLTexture::Linear);
-        m_texture->setWrapMode(QOpenGLTexture::Repeat);
-        m_hasTexture = true;
-    }
-
-    else if (m_type == Type::WOOD_CUBE) {
-        if (m_texture) delete m_texture;
-        m_texture = new QOpenGLTexture(QImage(":/new/prefix2/resources/images/wood_texture.jpg").flipped());
-        m_texture->setMinificationFilter(QOpenGLTexture::LinearMipMapLinear);
-        m_texture->setMagnificationFilter(QOpenGLTexture::Linear);
-        m_texture->setWrapMode(QOpenGLTexture::Repeat);
-        m_hasTexture = true;
-    }
-
-    m_initialized = true;
-}
-
 void Projectile::update(float deltaTime) {
     if (!m_active) return;
 
@@ -117,110 +55,48 @@ void Projectile::update(float deltaTime) {
         m_rotationAngle -= 360.0f;
     }
 
+    if (m_fadeDuration > 0.0f) {
+        m_fadeRemaining -= deltaTime;
+        m_scale = m_fadeScale * std::max(0.0f, m_fadeRemaining / m_fadeDuration);
+        if (m_fadeRemaining <= 0.0f) {
+            m_active = false;
+        }
+    }
+
     if (m_position.y() < -15.0f || m_position.z() > 5.0f) {
         m_active = false;
     }
 }
 
-void Projectile::render(QOpenGLShaderProgram* shaderProgram, const QMatrix4x4& projection, const QMatrix4x4& view) {
-    if (!m_active || !m_initialized) return;
-
-    shaderProgram->setUniformValue("useTexture", false);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    QMatrix4x4 model;
-    model.translate(m_position);
-    model.rotate(m_rotationAngle, m_rotationAxis);
-    model.scale(m_scale);
-
-    shaderProgram->setUniformValue("mvpMatrix", projection * view * model);
-    shaderProgram->setUniformValue("modelMatrix", model);
-    shaderProgram->setUniformValue("viewMatrix", view);
-    shaderProgram->setUniformValue("normalMatrix", model.normalMatrix());
-
-    shaderProgram->setUniformValue("useLighting", true);
-    shaderProgram->setUniformValue("ambientStrength", 0.3f);
-    shaderProgram->setUniformValue("specularStrength", 0.7f); 
-    shaderProgram->setUniformValue("shininess", 64.0f);       
-
-    QVector4D color;
+void Projectile::startFade(float duration) {
+    if (isFading()) return;
 
-    if (m_causedGameOver) {
-        color = QVector4D(1.0f, 0.0f, 0.0f, 1.0f); 
-
-        model.scale(1.2f);
-
-        shaderProgram->setUniformValue("mvpMatrix", projection * view * model);
-        shaderProgram->setUniformValue("modelMatrix", model);
-        shaderProgram->setUniformValue("normalMatrix", model.normalMatrix());
-    } else {
-
-        switch (m_type) {
-        case Type::BANANA:
-            color = m_isFragment ? QVector4D(1.0f, 0.98f, 0.8f, 1.0f) : QVector4D(1.0f, 0.9f, 0.0f, 1.0f);
-            break;
-        case Type::APPLE:
-            color = m_isFragment ? QVector4D(0.98f, 0.98f, 0.95f, 1.0f) : QVector4D(0.4f, 0.8f, 0.2f, 1.0f);
-            break;
-        case Type::ANANAS:
-            if (!m_hasTexture)
-                color = m_isFragment ? QVector4D(0.98f, 0.93f, 0.7f, 1.0f) : QVector4D(0.9f, 0.7f, 0.1f, 1.0f);
-            break;
-        case Type::WOOD_CUBE:
-            color = m_isFragment ? QVector4D(0.8f, 0.6f, 0.4f, 1.0f) : QVector4D(0.8f, 0.6f, 0.4f, 1.0f);
-            break;
-        case Type::FRAISE:
-            shaderProgram->setUniformValue("useTexture", true);
-            renderFraise(shaderProgram);
-            shaderProgram->setUniformValue("useTexture", false);
-            glBindTexture(GL_TEXTURE_2D, 0);
-            break;
-        }
-    }
-    shaderProgram->setUniformValue("color", color);
-
-    if (m_isFragment) {
-        shaderProgram->setUniformValue("isFragment", true);
-        shaderProgram->setUniformValue("sliceNormal", m_sliceNormal);
-        shaderProgram->setUniformValue("fragmentSide", m_fragmentSide);
+    m_fadeDuration = std::max(duration, 1e-3f);
+    m_fadeRemaining = m_fadeDuration;
+    m_fadeScale = m_scale;
+}
 
-        shaderProgram->setUniformValue("cutSurfaceColor", QVector4D(m_cutSurfaceColor, 1.0f));
-    } else {
-        shaderProgram->setUniformValue("isFragment", false);
-    }
+void Projectile::storePreviousState() {
+    m_previousPosition = m_position;
+    m_previousRotationAngle = m_rotationAngle;
+}
 
-    switch (m_type) {
-    case Type::BANANA:
-        shaderProgram->setUniformValue("useTexture", true);
-        renderBanana(shaderProgram);
-        shaderProgram->setUniformValue("useTexture", false);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        break;
-    case Type::APPLE:
-        shaderProgram->setUniformValue("useTexture", true);
-        renderApple(shaderProgram);
-        shaderProgram->setUniformValue("useTexture", false);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        break;
-    case Type::ANANAS:
-        shaderProgram->setUniformValue("useTexture", true);
-        renderAnanas(shaderProgram);
-        shaderProgram->setUniformValue("useTexture", false);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        break;
-    case Type::WOOD_CUBE:
-        shaderProgram->setUniformValue("useTexture", true);
-        renderWoodCube(shaderProgram);
-        shaderProgram->setUniformValue("useTexture", false);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        break;
-    case Type::FRAISE:
-        shaderProgram->setUniformValue("useTexture", true);
-        renderFraise(shaderProgram);
-        shaderProgram->setUniformValue("useTexture", false);
-        glBindTexture(GL_TEXTURE_2D, 0);
-        break;
-    }
+Projectile::State Projectile::state() const {
+    State state;
+    state.id = m_id;
+    state.type = m_type;
+    state.position = m_position;
+    state.previousPosition = m_previousPosition;
+    state.rotationAngle = m_rotationAngle;
+    state.previousRotationAngle = m_previousRotationAngle;
+    state.rotationAxis = m_rotationAxis;
+    state.scale = m_scale;
+    state.isFragment = m_isFragment;
+    state.causedGameOver = m_causedGameOver;
+    state.cuts = m_cuts;
+    state.cutCount = m_cutCount;
+    state.cutSurfaceColor = m_cutSurfaceColor;
+    return state;
 }
 
 bool Projectile::checkCollisionWithCylinder(float radius, float height, const QVector3D& cylinderPosition) {
@@ -249,7 +125,7 @@ bool Projectile::checkCollisionWithCylinder(float radius, float height, const QV
 }
 
 std::vector<Projectile> Projectile::slice() {
-    if (!m_active) return {};
+    if (!m_active || m_cutCount >= MAX_CUTS) return {};
 
     m_active = false; 
 
@@ -285,12 +161,11 @@ std::vector<Projectile> Projectile::slice() {
         fragment.limitVelocity(FRAGMENT_MAX_HORIZONTAL_VELOCITY, FRAGMENT_MAX_VERTICAL_VELOCITY);
         fragment.m_scale = m_scale * 0.9f; 
         fragment.m_isFragment = true;
-        fragment.m_sliceNormal = sliceNormal;
-        fragment.m_fragmentSide = direction > 0 ? 1 : -1;
-
-        fragment.initializeGL();
+        fragment.m_cuts = m_cuts;
+        fragment.m_cuts[m_cutCount] = { sliceNormal, direction > 0 ? 1 : -1 };
+        fragment.m_cutCount = m_cutCount + 1;
 
-        fragment.generateCutSurface(sliceNormal, direction);
+        fragment.assignCutSurfaceColor();
 
         fragments.push_back(fragment);
     }
@@ -298,37 +173,7 @@ std::vector<Projectile> Projectile::slice() {
     return fragments;
 }
 
-void Projectile::generateCutSurface(const QVector3D& sliceNormal, float ) {
-
-    m_cutVertices.clear();
-
-    QVector3D cutCenter = m_position; 
-    float radius = m_scale * 0.5f;    
-
-    QVector3D normal = sliceNormal.normalized();
-
-    QVector3D tangent1;
-    if (std::abs(normal.y()) < 0.9f) {
-        tangent1 = QVector3D::crossProduct(normal, QVector3D(0, 1, 0)).normalized();
-    } else {
-        tangent1 = QVector3D::crossProduct(normal, QVector3D(1, 0, 0)).normalized();
-    }
-    QVector3D tangent2 = QVector3D::crossProduct(normal, tangent1).normalized();
-
-    const int segments = 36;
-    for (int i = 0; i < segments; ++i) {
-        float angle = (2.0f * M_PI * i) / segments;
-        float cosA = std::cos(angle);
-        float sinA = std::sin(angle);
-
-        QVector3D offset = (tangent1 * cosA + tangent2 * sinA) * radius;
-        QVector3D vertex = cutCenter + offset;
-
-        m_cutVertices.push_back(vertex);
-    }
-
-    m_cutVertices.insert(m_cutVertices.begin(), cutCenter);
-
+void Projectile::assignCutSurfaceColor() {
     switch (m_type) {
         case Type::APPLE:
             m_cutSurfaceColor = QVector3D(1.0f, 0.95f, 0.85f); 
@@ -348,8 +193,43 @@ void Projectile::generateCutSurface(const QVector3D& sliceNormal, float ) {
     }
 }
 
-void Projectile::renderBanana(QOpenGLShaderProgram* shaderProgram) {
-    const int segments = 12;
+MeshData Projectile::buildMeshData(Type type, int lod) {
+    static_assert(LOD_COUNT == 3, "one case per level of detail");
+    switch (lod) {
+    case 0:
+        return buildLevel<0>(type);
+    case 1:
+        return buildLevel<1>(type);
+    default:
+        return buildLevel<2>(type);
+    }
+}
+
+template <int LOD>
+MeshData Projectile::buildLevel(Type type) {
+    switch (type) {
+    case Type::BANANA:
+        return buildBanana<LOD>();
+    case Type::APPLE:
+        return buildApple<LOD>();
+    case Type::ANANAS:
+        return buildAnanas<LOD>();
+    case Type::FRAISE:
+        return buildFraise<LOD>();
+    case Type::WOOD_CUBE:
+        return buildWoodCube();
+    }
+    return MeshData();
+}
+
+template <int LOD>
+MeshData Projectile::buildBanana() {
+    constexpr int segments = lodSteps(12, LOD);
+    constexpr int sides = lodSteps(16, LOD);
+    // Courbure sur 3/4 de demi-tour, épaisseur en sin(t * pi), section circulaire
+    constexpr const auto& bend = Trig::arc<segments, 3, 4>;
+    constexpr const auto& profile = Trig::halfCircle<segments>;
+    constexpr const auto& ring = Trig::circle<sides>;
     const float baseRadius = 0.08f;
     const float length = 0.7f;
 
@@ -358,36 +238,34 @@ void Projectile::renderBanana(QOpenGLShaderProgram* shaderProgram) {
 
     for (int i = 0; i <= segments; ++i) {
         float t = float(i) / float(segments);  
-        float angle = t * M_PI * 0.75f;
 
-        float centerX = length * 0.5f * std::sin(angle);
-        float centerY = length * 0.5f * (1.0f - std::cos(angle));
+        float centerX = length * 0.5f * bend.sin[i];
+        float centerY = length * 0.5f * (1.0f - bend.cos[i]);
         float centerZ = 0.0f;
 
-        float radiusFactor = std::sin(t * M_PI);
+        float radiusFactor = profile.sin[i];
         float currentRadius = baseRadius * radiusFactor;
 
-        for (int j = 0; j <= 16; ++j) {
-            float circleAngle = 2.0f * M_PI * float(j) / 16.0f;
-            float ovalFactor = 0.8f + 0.2f * std::cos(circleAngle);
+        // Normale tournée d'un quart de tour par rapport à la courbure
+        float normalFactorX = -bend.sin[i];
+        float normalFactorY = bend.cos[i];
 
-            float x = centerX + currentRadius * ovalFactor * std::cos(circleAngle);
-            float y = centerY;
-            float z = centerZ + currentRadius * std::sin(circleAngle);
+        for (int j = 0; j <= sides; ++j) {
+            float ovalFactor = 0.8f + 0.2f * ring.cos[j];
 
-            float nx = std::cos(circleAngle);
-            float nz = std::sin(circleAngle);
+            float x = centerX + currentRadius * ovalFactor * ring.cos[j];
+            float y = centerY;
+            float z = centerZ + currentRadius * ring.sin[j];
 
-            float normalAngle = angle + M_PI_2;
-            float normalFactorX = std::cos(normalAngle);
-            float normalFactorY = std::sin(normalAngle);
+            float nx = ring.cos[j];
+            float nz = ring.sin[j];
 
             float adjustedNx = nx * normalFactorX - normalFactorY;
             float adjustedNy = nx * normalFactorY + normalFactorX;
 
             float len = std::sqrt(adjustedNx * adjustedNx + adjustedNy * adjustedNy + nz * nz);
 
-            float u = float(j) / 16.0f;
+            float u = float(j) / float(sides);
             float v = t;
 
             vertices.push_back(x);
@@ -401,9 +279,9 @@ void Projectile::renderBanana(QOpenGLShaderProgram* shaderProgram) {
         }
     }
 
-    const int verticesPerRing = 17;
+    const int verticesPerRing = sides + 1;
     for (int i = 0; i < segments; ++i) {
-        for (int j = 0; j < 16; ++j) {
+        for (int j = 0; j < sides; ++j) {
             int current = i * verticesPerRing + j;
             int next = current + verticesPerRing;
 
@@ -417,47 +295,23 @@ void Projectile::renderBanana(QOpenGLShaderProgram* shaderProgram) {
         }
     }
 
-    if (m_isFragment) {
-        applyFragmentCutPlane(vertices, indices);
-    }
-
-    QOpenGLContext::currentContext()->extraFunctions()->glBindVertexArray(m_vao);
-
-    this->glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    this->glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STATIC_DRAW);
-
-    this->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-    this->glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
-
-    this->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);                
-    this->glEnableVertexAttribArray(0);
-
-    this->glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float))); 
-    this->glEnableVertexAttribArray(1);
-
-    this->glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float))); 
-    this->glEnableVertexAttribArray(2);
-
-    if (m_hasTexture && m_texture) {
-        shaderProgram->setUniformValue("useTexture", true);
-        m_texture->bind(0);
-        shaderProgram->setUniformValue("appleTexture", 0); 
-    } else {
-        shaderProgram->setUniformValue("useTexture", false);
-    }
-
-    this->glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
-
-    if (m_hasTexture && m_texture) {
-        m_texture->release();
-    }
-
-    QOpenGLContext::currentContext()->extraFunctions()->glBindVertexArray(0);
+    MeshData data;
+    data.vertices = std::move(vertices);
+    data.indices = std::move(indices);
+    data.closePart(0);
+    return data;
 }
 
-void Projectile::renderApple(QOpenGLShaderProgram* shaderProgram) {
-    const int stacks = 24;
-    const int slices = 36;
+template <int LOD>
+MeshData Projectile::buildApple() {
+    constexpr int stacks = lodSteps(24, LOD);
+    constexpr int slices = lodSteps(36, LOD);
+    constexpr const auto& meridian = Trig::halfCircle<stacks>;
+    constexpr const auto& ring = Trig::circle<slices>;
+    // Renflement du milieu du fruit, entre v = 0.3 et v = 0.7
+    constexpr auto bulge = Trig::sample<stacks>([](double v) {
+        return (v >= 0.3 && v <= 0.7) ? 1.0 + 0.08 * Trig::sin((v - 0.3) / 0.4 * Trig::PI) : 1.0;
+    });
     const float radius = 0.45f;
     const float heightFactor = 1.1f;
 
@@ -468,7 +322,6 @@ void Projectile::renderApple(QOpenGLShaderProgram* shaderProgram) {
 
     for (int i = 0; i <= stacks; ++i) {
         float v = float(i) / float(stacks);
-        float phi = M_PI * v;
         float r = radius;
 
         if (v < 0.2f)
@@ -476,17 +329,15 @@ void Projectile::renderApple(QOpenGLShaderProgram* shaderProgram) {
         else if (v > 0.8f)
             r = radius * (0.98f - 0.08f * (v - 0.8f) / 0.2f);
 
-        if (v >= 0.3f && v <= 0.7f)
-            r *= (1.0f + 0.08f * std::sin((v - 0.3f) / 0.4f * M_PI));
+        r *= bulge[i];
 
-        float sinPhi = std::sin(phi);
-        float cosPhi = std::cos(phi);
+        float sinPhi = meridian.sin[i];
+        float cosPhi = meridian.cos[i];
 
         for (int j = 0; j <= slices; ++j) {
             float u = float(j) / float(slices);
-            float theta = 2.0f * M_PI * u;
-            float sinTheta = std::sin(theta);
-            float cosTheta = std::cos(theta);
+            float sinTheta = ring.sin[j];
+            float cosTheta = ring.cos[j];
 
             float x = r * sinPhi * cosTheta;
             float y = r * cosPhi * heightFactor;
@@ -538,9 +389,8 @@ void Projectile::renderApple(QOpenGLShaderProgram* shaderProgram) {
                                               });
 
     auto rotateY45 = [](float x, float z) -> std::pair<float,float> {
-        float angle = M_PI / 4.0f; 
-        float cosA = std::cos(angle);
-        float sinA = std::sin(angle);
+        constexpr float cosA = float(Trig::cos(Trig::PI / 4.0));
+        constexpr float sinA = float(Trig::sin(Trig::PI / 4.0));
         return { x * cosA - z * sinA, x * sinA + z * cosA };
     };
 
@@ -570,55 +420,32 @@ void Projectile::renderApple(QOpenGLShaderProgram* shaderProgram) {
                                                   (GLuint)(baseIndex + 1), (GLuint)(baseIndex + 3), (GLuint)(baseIndex + 2)
                                               });
 
-    if (m_isFragment)
-        applyFragmentCutPlane(verticesBody, indicesBody);
-
-    QOpenGLContext::currentContext()->extraFunctions()->glBindVertexArray(m_vao);
-
-    this->glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    this->glBufferData(GL_ARRAY_BUFFER, verticesBody.size() * sizeof(GLfloat), verticesBody.data(), GL_STATIC_DRAW);
-
-    this->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-    this->glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicesBody.size() * sizeof(GLuint), indicesBody.data(), GL_STATIC_DRAW);
-
-    this->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    this->glEnableVertexAttribArray(0);
-
-    this->glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    this->glEnableVertexAttribArray(1);
+    MeshData data;
+    data.vertices = std::move(verticesBody);
+    data.indices = std::move(indicesBody);
+    data.closePart(0);
 
-    this->glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-    this->glEnableVertexAttribArray(2);
-
-    if (m_hasTexture && m_texture) {
-        shaderProgram->setUniformValue("useTexture", true);
-        m_texture->bind(0);
-        shaderProgram->setUniformValue("appleTexture", 0);
-    } else {
-        shaderProgram->setUniformValue("useTexture", false);
+    const GLuint leafOffset = GLuint(data.vertices.size() / MeshData::VERTEX_SIZE);
+    const size_t leavesStart = data.indices.size();
+    data.vertices.insert(data.vertices.end(), verticesLeaves.begin(), verticesLeaves.end());
+    for (GLuint index : indicesLeaves) {
+        data.indices.push_back(leafOffset + index);
     }
-
-    this->glDrawElements(GL_TRIANGLES, indicesBody.size(), GL_UNSIGNED_INT, 0);
-
-    if (m_hasTexture && m_texture) {
-        m_texture->release();
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
-
-    this->glBufferData(GL_ARRAY_BUFFER, verticesLeaves.size() * sizeof(GLfloat), verticesLeaves.data(), GL_STATIC_DRAW);
-    this->glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicesLeaves.size() * sizeof(GLuint), indicesLeaves.data(), GL_STATIC_DRAW);
-
-    shaderProgram->setUniformValue("useTexture", false);
-    shaderProgram->setUniformValue("color", QVector4D(0.0f, 0.4f, 0.0f, 1.0f)); 
-
-    this->glDrawElements(GL_TRIANGLES, indicesLeaves.size(), GL_UNSIGNED_INT, 0);
-
-    QOpenGLContext::currentContext()->extraFunctions()->glBindVertexArray(0);
+    data.closePart(leavesStart);
+    return data;
 }
 
-void Projectile::renderAnanas(QOpenGLShaderProgram* shaderProgram) {
-    const int slices = 32;
-    const int stacks = 16;
+template <int LOD>
+MeshData Projectile::buildAnanas() {
+    constexpr int slices = lodSteps(32, LOD);
+    constexpr int stacks = lodSteps(16, LOD);
+    constexpr int leafDetail = lodSteps(4, LOD, 1);
+    constexpr const auto& ring = Trig::circle<slices>;
+    // Écailles : produit de deux ondulations, le long du fruit et autour
+    constexpr auto bumpsV = Trig::sample<stacks>([](double v) { return Trig::sin(v * 40.0); });
+    constexpr auto bumpsU = Trig::sample<slices>([](double u) { return Trig::sin(u * 40.0); });
+    constexpr auto swell = Trig::sample<stacks>([](double v) { return Trig::sin((v - 0.2) / 0.6 * Trig::PI); });
+    constexpr const auto& leafCurve = Trig::halfCircle<leafDetail>;
     const float bodyHeight = 0.8f;
     const float bodyRadius = 0.3f;
     const float crownHeight = 0.4f;
@@ -637,18 +464,17 @@ void Projectile::renderAnanas(QOpenGLShaderProgram* shaderProgram) {
         } else if (v > 0.8f) {
             radiusFactor = 0.9f - 0.2f * (v - 0.8f) / 0.2f;
         } else {
-            radiusFactor = 1.0f + 0.05f * std::sin((v - 0.2f) / 0.6f * M_PI);
+            radiusFactor = 1.0f + 0.05f * swell[i];
         }
 
         float currentRadius = bodyRadius * radiusFactor;
 
         for (int j = 0; j <= slices; ++j) {
             float u = float(j) / float(slices);
-            float theta = 2.0f * M_PI * u;
-            float cosTheta = std::cos(theta);
-            float sinTheta = std::sin(theta);
+            float cosTheta = ring.cos[j];
+            float sinTheta = ring.sin[j];
 
-            float bumpDepth = 0.03f * std::sin(v * 40.0f) * std::sin(u * 40.0f);
+            float bumpDepth = 0.03f * bumpsV[i] * bumpsU[j];
             float bumpRadius = currentRadius + bumpDepth;
 
             float x = bumpRadius * cosTheta;
@@ -673,8 +499,8 @@ void Projectile::renderAnanas(QOpenGLShaderProgram* shaderProgram) {
         }
     }
 
-    const int leaves = 16;
-    const int leafDetail = 4;
+    constexpr int leaves = 16;
+    constexpr const auto& crown = Trig::circle<leaves>;
 
     vertices.push_back(0.0f);
     vertices.push_back(bodyHeight / 2);
@@ -686,30 +512,32 @@ void Projectile::renderAnanas(QOpenGLShaderProgram* shaderProgram) {
     vertices.push_back(0.5f); 
 
     for (int i = 0; i < leaves; ++i) {
-        float leafAngle = 2.0f * M_PI * float(i) / float(leaves);
-        float leafDirection = leafAngle + M_PI_4 * 0.5f * (float(i % 3) - 1.0f);
+        // Feuille inclinée d'un seizième de tour (pi / 8) de part et d'autre de sa base
+        const int direction = (i + i % 3 - 1 + leaves) % leaves;
+        float cosDirection = crown.cos[direction];
+        float sinDirection = crown.sin[direction];
 
-        float baseX = 0.15f * std::cos(leafAngle);
-        float baseZ = 0.15f * std::sin(leafAngle);
+        float baseX = 0.15f * crown.cos[i];
+        float baseZ = 0.15f * crown.sin[i];
         float baseY = bodyHeight / 2;
 
         float heightVar = 0.7f + 0.6f * float(i % 3) / 2.0f;
-        float tipX = baseX * 0.5f + 0.1f * std::cos(leafDirection);
-        float tipZ = baseZ * 0.5f + 0.1f * std::sin(leafDirection);
+        float tipX = baseX * 0.5f + 0.1f * cosDirection;
+        float tipZ = baseZ * 0.5f + 0.1f * sinDirection;
         float tipY = baseY + crownHeight * heightVar;
 
         for (int j = 0; j <= leafDetail; ++j) {
             float t = float(j) / float(leafDetail);
 
-            float curveOffset = 0.1f * std::sin(t * M_PI);
-            float px = baseX * (1.0f - t) + tipX * t + curveOffset * std::cos(leafDirection + M_PI_2);
-            float pz = baseZ * (1.0f - t) + tipZ * t + curveOffset * std::sin(leafDirection + M_PI_2);
+            // Décalage et largeur perpendiculaires à la feuille : angle leafDirection + pi / 2
+            float curveOffset = 0.1f * leafCurve.sin[j];
+            float px = baseX * (1.0f - t) + tipX * t - curveOffset * sinDirection;
+            float pz = baseZ * (1.0f - t) + tipZ * t + curveOffset * cosDirection;
             float py = baseY + (tipY - baseY) * (t * t);
 
             float width = 0.06f * (1.0f - t * 0.8f);
-            float widthAngle = leafDirection + M_PI_2;
-            float wx = width * std::cos(widthAngle);
-            float wz = width * std::sin(widthAngle);
+            float wx = -width * sinDirection;
+            float wz = width * cosDirection;
 
             vertices.push_back(px - wx);
             vertices.push_back(py);
@@ -771,68 +599,23 @@ void Projectile::renderAnanas(QOpenGLShaderProgram* shaderProgram) {
         indices.push_back(first + 1);
     }
 
-    if (m_isFragment) {
-        applyFragmentCutPlane(vertices, indices);
-    }
-
-    QOpenGLContext::currentContext()->extraFunctions()->glBindVertexArray(m_vao);
-
-    this->glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    this->glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STATIC_DRAW);
-
-    this->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-
-    std::vector<GLuint> allIndices;
-    allIndices.insert(allIndices.end(), indicesBody.begin(), indicesBody.end());
-    allIndices.insert(allIndices.end(), indices.begin(), indices.end());
-
-    this->glBufferData(GL_ELEMENT_ARRAY_BUFFER, allIndices.size() * sizeof(GLuint), allIndices.data(), GL_STATIC_DRAW);
-
-    this->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    this->glEnableVertexAttribArray(0);
-
-    this->glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    this->glEnableVertexAttribArray(1);
-
-    this->glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-    this->glEnableVertexAttribArray(2);
-
-    int bodyIndexCount = indicesBody.size();
+    MeshData data;
+    data.vertices = std::move(vertices);
+    data.indices = std::move(indicesBody);
+    data.closePart(0);
 
-    if (m_hasTexture && m_texture) {
-        shaderProgram->setUniformValue("useTexture", true);
-        m_texture->bind(0);
-        shaderProgram->setUniformValue("appleTexture", 0);
-
-        shaderProgram->setUniformValue("color", QVector4D(1.0f, 1.0f, 1.0f, 1.0f));
-    } else {
-        shaderProgram->setUniformValue("useTexture", false);
-        shaderProgram->setUniformValue("color", QVector4D(0.85f, 0.65f, 0.25f, 1.0f));  
-    }
-
-    glDrawElements(GL_TRIANGLES, bodyIndexCount, GL_UNSIGNED_INT, 0);
-
-    if (m_hasTexture && m_texture) {
-        m_texture->release();
-    }
-
-    int crownIndexCount = indices.size();
-    const void* crownIndicesOffset = (const void*)(bodyIndexCount * sizeof(GLuint));
-
-    shaderProgram->setUniformValue("useTexture", false);
-    shaderProgram->setUniformValue("color", QVector4D(0.05f, 0.3f, 0.05f, 1.0f));  
-    glDrawElements(GL_TRIANGLES, crownIndexCount, GL_UNSIGNED_INT, crownIndicesOffset);
-
-    if (m_hasTexture && m_texture) {
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
-
-    QOpenGLContext::currentContext()->extraFunctions()->glBindVertexArray(0);
+    const size_t crownStart = data.indices.size();
+    data.indices.insert(data.indices.end(), indices.begin(), indices.end());
+    data.closePart(crownStart);
+    return data;
 }
 
-void Projectile::renderFraise(QOpenGLShaderProgram* shaderProgram) {
-    const int stacks = 24;
-    const int slices = 36;
+template <int LOD>
+MeshData Projectile::buildFraise() {
+    constexpr int stacks = lodSteps(24, LOD);
+    constexpr int slices = lodSteps(36, LOD);
+    constexpr const auto& quarter = Trig::arc<stacks, 1, 2>;
+    constexpr const auto& ring = Trig::circle<slices>;
     const float radius = 0.32f;   
     const float height = 0.6f;   
 
@@ -843,16 +626,14 @@ void Projectile::renderFraise(QOpenGLShaderProgram* shaderProgram) {
 
     for (int i = 0; i <= stacks; ++i) {
         float v = float(i) / float(stacks);
-        float theta = M_PI * v / 2.0f;
-        float r = radius * (1.0f - v * 0.9f) * std::sin(theta);
+        float r = radius * (1.0f - v * 0.9f) * quarter.sin[i];
         float y = height * (1.0f - v);
 
         for (int j = 0; j <= slices; ++j) {
             float u = float(j) / float(slices);
-            float phi = 2.0f * M_PI * u;
 
-            float x = r * std::cos(phi);
-            float z = r * std::sin(phi);
+            float x = r * ring.cos[j];
+            float z = r * ring.sin[j];
 
             QVector3D normal = QVector3D(x, radius * 0.6f, z).normalized();
 
@@ -884,23 +665,22 @@ void Projectile::renderFraise(QOpenGLShaderProgram* shaderProgram) {
         }
     }
 
-    const int leafCount = 8;
+    constexpr int leafCount = 8;
+    // Bases des feuilles aux angles pairs, pointes aux angles impairs
+    constexpr const auto& sepals = Trig::circle<2 * leafCount>;
     const float leafRadius = radius * 0.2f;   
     const float leafHeight = 0.04f;            
     const float crownY = height;                
 
     for (int i = 0; i < leafCount; ++i) {
-        float angle = 2.0f * M_PI * i / leafCount;
-        float nextAngle = 2.0f * M_PI * (i + 1) / leafCount;
-
-        float x1 = leafRadius * std::cos(angle);
-        float z1 = leafRadius * std::sin(angle);
+        float x1 = leafRadius * sepals.cos[2 * i];
+        float z1 = leafRadius * sepals.sin[2 * i];
 
-        float x2 = leafRadius * std::cos(nextAngle);
-        float z2 = leafRadius * std::sin(nextAngle);
+        float x2 = leafRadius * sepals.cos[2 * i + 2];
+        float z2 = leafRadius * sepals.sin[2 * i + 2];
 
-        float tipX = (leafRadius + 0.02f) * std::cos(angle + M_PI / leafCount);  
-        float tipZ = (leafRadius + 0.02f) * std::sin(angle + M_PI / leafCount);
+        float tipX = (leafRadius + 0.02f) * sepals.cos[2 * i + 1];
+        float tipZ = (leafRadius + 0.02f) * sepals.sin[2 * i + 1];
         float tipY = crownY + leafHeight;
 
         QVector3D normalBase1 = QVector3D(x1, 0.0f, z1).normalized();
@@ -946,348 +726,25 @@ void Projectile::renderFraise(QOpenGLShaderProgram* shaderProgram) {
         indicesLeaves.push_back(idx + 2);
     }
 
-    if (m_isFragment)
-        applyFragmentCutPlane(verticesBody, indicesBody);
-
-    QOpenGLContext::currentContext()->extraFunctions()->glBindVertexArray(m_vao);
-
-    this->glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    this->glBufferData(GL_ARRAY_BUFFER, verticesBody.size() * sizeof(GLfloat), verticesBody.data(), GL_STATIC_DRAW);
-
-    this->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-    this->glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicesBody.size() * sizeof(GLuint), indicesBody.data(), GL_STATIC_DRAW);
-
-    this->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-    this->glEnableVertexAttribArray(0);
-
-    this->glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-    this->glEnableVertexAttribArray(1);
-
-    this->glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-    this->glEnableVertexAttribArray(2);
-
-    if (m_hasTexture && m_texture) {
-        shaderProgram->setUniformValue("useTexture", true);
-        m_texture->bind(0);
-        shaderProgram->setUniformValue("appleTexture", 0);
-    } else {
-        shaderProgram->setUniformValue("useTexture", false);
-        shaderProgram->setUniformValue("color", QVector4D(1.0f, 0.1f, 0.2f, 1.0f));  
-    }
-
-    this->glDrawElements(GL_TRIANGLES, indicesBody.size(), GL_UNSIGNED_INT, 0);
-
-    if (m_hasTexture && m_texture) {
-        m_texture->release();
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
-
-    this->glBufferData(GL_ARRAY_BUFFER, verticesLeaves.size() * sizeof(GLfloat), verticesLeaves.data(), GL_STATIC_DRAW);
-    this->glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicesLeaves.size() * sizeof(GLuint), indicesLeaves.data(), GL_STATIC_DRAW);
-
-    shaderProgram->setUniformValue("useTexture", false);
-    shaderProgram->setUniformValue("color", QVector4D(0.05f, 0.35f, 0.05f, 1.0f)); 
-
-    this->glDrawElements(GL_TRIANGLES, indicesLeaves.size(), GL_UNSIGNED_INT, 0);
-
-    QOpenGLContext::currentContext()->extraFunctions()->glBindVertexArray(0);
-}
-
-void Projectile::renderShadow(QOpenGLShaderProgram* shaderProgram, const QMatrix4x4& projection, const QMatrix4x4& view, float groundLevel) {
-    if (!m_active || !m_initialized) return;
-
-    float heightAboveGround = m_position.y() - groundLevel;
-    float maxShadowHeight = 5.0f; 
-    float shadowOpacity = 0.8f - (heightAboveGround / maxShadowHeight) * 0.5f;
-    shadowOpacity = std::max(0.2f, shadowOpacity); 
-
-    float shadowScale = m_scale * (0.9f - heightAboveGround * 0.05f);
-    shadowScale = std::max(0.5f, shadowScale); 
-
-    QMatrix4x4 shadowModel;
-    shadowModel.setToIdentity();
-
-    shadowModel.translate(m_position.x(), groundLevel + 0.02f, m_position.z()); 
-
-    shadowModel.scale(1.0f, 0.01f, 1.0f); 
-
-    shadowModel.rotate(m_rotationAngle, 0.0f, 1.0f, 0.0f);
-    shadowModel.scale(shadowScale); 
-
-    shaderProgram->setUniformValue("mvpMatrix", projection * view * shadowModel);
-    shaderProgram->setUniformValue("modelMatrix", shadowModel);
-    shaderProgram->setUniformValue("viewMatrix", view);
-    shaderProgram->setUniformValue("normalMatrix", shadowModel.normalMatrix());
-
-    shaderProgram->setUniformValue("useLighting", false);
-
-    shaderProgram->setUniformValue("useTexture", false);
-    shaderProgram->setUniformValue("color", QVector4D(0.0f, 0.0f, 0.0f, shadowOpacity));
-
-    shaderProgram->setUniformValue("isFragment", false);
-
-    switch (m_type) {
-    case Type::BANANA:
-        renderBananaShadow(shaderProgram);
-        break;
-    case Type::APPLE:
-        renderAppleShadow(shaderProgram);
-        break;
-    case Type::ANANAS:
-        renderAnanasShadow(shaderProgram);
-        break;
-    case Type::WOOD_CUBE:
-        renderWoodCubeShadow(shaderProgram);
-        break;
-    case Type::FRAISE:
-        renderFraiseShadow(shaderProgram);
-        break;
-    }
-}
-
-void Projectile::renderBananaShadow(QOpenGLShaderProgram* ) {
-
-    const int segments = 24;
-    std::vector<GLfloat> vertices;
-    std::vector<GLuint> indices;
-
-    float width = 0.3f;
-    float length = 0.7f;
-
-    vertices.push_back(0.0f);  
-    vertices.push_back(0.0f);  
-    vertices.push_back(0.0f);  
-
-    for (int i = 0; i <= segments; i++) {
-        float angle = 2.0f * M_PI * float(i) / float(segments);
-        float x = width * std::cos(angle);
-        float z = length * std::sin(angle);
-
-        vertices.push_back(x);
-        vertices.push_back(0.0f);
-        vertices.push_back(z);
-
-        if (i < segments) {
-            indices.push_back(0);  
-            indices.push_back(i+1);
-            indices.push_back(i+2);
-        }
-    }
-
-    this->glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    this->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-
-    this->glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STATIC_DRAW);
-    this->glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
-
-    this->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
-    this->glEnableVertexAttribArray(0);
-
-    this->glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
-}
-
-void Projectile::renderAppleShadow(QOpenGLShaderProgram* ) {
-
-    const int segments = 24;
-    std::vector<GLfloat> vertices;
-    std::vector<GLuint> indices;
-
-    vertices.push_back(0.0f);  
-    vertices.push_back(0.0f);  
-    vertices.push_back(0.0f);  
-
-    float radius = 0.4f;
-
-    for (int i = 0; i <= segments; i++) {
-        float angle = 2.0f * M_PI * float(i) / float(segments);
-        float x = radius * std::cos(angle);
-        float z = radius * std::sin(angle);
-
-        vertices.push_back(x);
-        vertices.push_back(0.0f);
-        vertices.push_back(z);
-
-        if (i < segments) {
-            indices.push_back(0);  
-            indices.push_back(i+1);
-            indices.push_back(i+2);
-        }
-    }
-
-    this->glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    this->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-
-    this->glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STATIC_DRAW);
-    this->glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
-
-    this->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
-    this->glEnableVertexAttribArray(0);
-
-    this->glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
-}
-
-void Projectile::renderAnanasShadow(QOpenGLShaderProgram* ) {
-
-    const int segments = 24;
-    std::vector<GLfloat> vertices;
-    std::vector<GLuint> indices;
-
-    vertices.push_back(0.0f);  
-    vertices.push_back(0.0f);  
-    vertices.push_back(0.0f);  
-
-    float radius = 0.35f;
-
-    for (int i = 0; i <= segments; i++) {
-        float angle = 2.0f * M_PI * float(i) / float(segments);
-        float x = radius * std::cos(angle);
-        float z = radius * std::sin(angle);
-
-        vertices.push_back(x);
-        vertices.push_back(0.0f);
-        vertices.push_back(z);
-
-        if (i < segments) {
-            indices.push_back(0);  
-            indices.push_back(i+1);
-            indices.push_back(i+2);
-        }
-    }
-
-    this->glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    this->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-
-    this->glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STATIC_DRAW);
-    this->glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
-
-    this->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
-    this->glEnableVertexAttribArray(0);
-
-    this->glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
-}
-
-void Projectile::renderFraiseShadow(QOpenGLShaderProgram* ) {
-
-    const int segments = 30;
-    std::vector<GLfloat> vertices;
-    std::vector<GLuint> indices;
-
-    vertices.push_back(0.0f);  
-    vertices.push_back(0.0f);  
-    vertices.push_back(0.0f);  
-
-    float radius = 0.3f;
-
-    for (int i = 0; i <= segments; i++) {
-        float angle = 2.0f * M_PI * float(i) / float(segments);
-        float x = radius * std::cos(angle);
-        float z = radius * std::sin(angle);
-
-        if (z > 0) {
-            z *= 1.2f;  
-        }
-
-        vertices.push_back(x);
-        vertices.push_back(0.0f);
-        vertices.push_back(z);
-
-        if (i < segments) {
-            indices.push_back(0);  
-            indices.push_back(i+1);
-            indices.push_back(i+2);
-        }
-    }
-
-    this->glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    this->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-
-    this->glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STATIC_DRAW);
-    this->glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
-
-    this->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
-    this->glEnableVertexAttribArray(0);
-
-    this->glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
-}
-
-void Projectile::applyFragmentCutPlane(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices) {
-
-    if (!m_isFragment) return;
-
-    QVector3D planeNormal = m_sliceNormal;
-    QVector3D planePoint = m_position;
-
-    std::vector<GLfloat> newVertices;
-    std::map<int, int> oldToNewIndex;
-    std::vector<GLuint> newIndices;
-
-    int vertexSize = 8;  
-    for (size_t i = 0; i < vertices.size(); i += vertexSize) {
-        QVector3D vertex(vertices[i], vertices[i + 1], vertices[i + 2]);
-        QVector3D toVertex = vertex - planePoint;
-
-        float side = float(m_fragmentSide);
-        if (QVector3D::dotProduct(toVertex, planeNormal) * side > -0.001f) {
-
-            oldToNewIndex[i/vertexSize] = newVertices.size()/vertexSize;
-
-            for (int j = 0; j < vertexSize; ++j) {
-                newVertices.push_back(vertices[i + j]);
-            }
-        }
-    }
-
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        GLuint idx1 = indices[i];
-        GLuint idx2 = indices[i + 1];
-        GLuint idx3 = indices[i + 2];
-
-        if (oldToNewIndex.find(idx1) != oldToNewIndex.end() && 
-            oldToNewIndex.find(idx2) != oldToNewIndex.end() && 
-            oldToNewIndex.find(idx3) != oldToNewIndex.end()) {
-
-            newIndices.push_back(oldToNewIndex[idx1]);
-            newIndices.push_back(oldToNewIndex[idx2]);
-            newIndices.push_back(oldToNewIndex[idx3]);
-        }
-    }
-
-    if (!m_cutVertices.empty()) {
-        int baseIdx = newVertices.size() / vertexSize;
-
-        for (const auto& cutVertex : m_cutVertices) {
-
-            newVertices.push_back(cutVertex.x());
-            newVertices.push_back(cutVertex.y());
-            newVertices.push_back(cutVertex.z());
+    MeshData data;
+    data.vertices = std::move(verticesBody);
+    data.indices = std::move(indicesBody);
+    data.closePart(0);
 
-            newVertices.push_back(planeNormal.x() * float(-m_fragmentSide));
-            newVertices.push_back(planeNormal.y() * float(-m_fragmentSide));
-            newVertices.push_back(planeNormal.z() * float(-m_fragmentSide));
-
-            newVertices.push_back(0.5f);
-            newVertices.push_back(0.5f);
-        }
-
-        for (size_t i = 1; i < m_cutVertices.size() - 1; ++i) {
-            newIndices.push_back(baseIdx);
-            newIndices.push_back(baseIdx + i);
-            newIndices.push_back(baseIdx + i + 1);
-        }
+    const GLuint leafOffset = GLuint(data.vertices.size() / MeshData::VERTEX_SIZE);
+    const size_t leavesStart = data.indices.size();
+    data.vertices.insert(data.vertices.end(), verticesLeaves.begin(), verticesLeaves.end());
+    for (GLuint index : indicesLeaves) {
+        data.indices.push_back(leafOffset + index);
     }
-
-    vertices = newVertices;
-    indices = newIndices;
+    data.closePart(leavesStart);
+    return data;
 }
 
-void Projectile::renderWoodCube(QOpenGLShaderProgram* ) {
+MeshData Projectile::buildWoodCube() {
 
     const float size = 0.4f; 
 
-    if (m_hasTexture && m_texture) {
-        m_texture->bind();
-    }
-
     std::vector<GLfloat> vertices = {
 
         -size, -size, size,   0.0f, 0.0f, 1.0f,   0.0f, 0.0f,  
@@ -1330,60 +787,22 @@ void Projectile::renderWoodCube(QOpenGLShaderProgram* ) {
         20, 21, 22, 22, 23, 20  
     };
 
-    this->glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    this->glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STATIC_DRAW);
-
-    this->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-    this->glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
-
-    this->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);                
-    this->glEnableVertexAttribArray(0);
-    this->glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float))); 
-    this->glEnableVertexAttribArray(1);
-    this->glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float))); 
-    this->glEnableVertexAttribArray(2);
-
-    this->glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
-
-    this->glDisableVertexAttribArray(0);
-    this->glDisableVertexAttribArray(1);
-    this->glDisableVertexAttribArray(2);
+    MeshData data;
+    data.vertices = std::move(vertices);
+    data.indices = std::move(indices);
+    data.closePart(0);
+    return data;
 }
 
-void Projectile::renderWoodCubeShadow(QOpenGLShaderProgram* shaderProgram) {
-
-    const float size = 0.4f;
+MeshData Projectile::buildFragmentMeshData(const State& state, int lod) {
+    // Une arène par thread : les découpes successives d'un même thread réutilisent sa mémoire
+    thread_local MeshSlicer::Arena arena;
 
-    shaderProgram->setUniformValue("color", QVector4D(0.0f, 0.0f, 0.0f, 0.5f));
-
-    std::vector<GLfloat> vertices = {
-
-        -size, 0.01f, -size,   0.0f, 1.0f, 0.0f,   0.0f, 0.0f,
-        size, 0.01f, -size,    0.0f, 1.0f, 0.0f,   1.0f, 0.0f,
-        size, 0.01f, size,     0.0f, 1.0f, 0.0f,   1.0f, 1.0f,
-        -size, 0.01f, size,    0.0f, 1.0f, 0.0f,   0.0f, 1.0f
-    };
-
-    std::vector<GLuint> indices = {
-        0, 1, 2, 2, 3, 0  
-    };
-
-    this->glBindBuffer(GL_ARRAY_BUFFER, m_vbo);
-    this->glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GLfloat), vertices.data(), GL_STATIC_DRAW);
-
-    this->glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_ebo);
-    this->glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), indices.data(), GL_STATIC_DRAW);
-
-    this->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);                
-    this->glEnableVertexAttribArray(0);
-    this->glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float))); 
-    this->glEnableVertexAttribArray(1);
-    this->glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float))); 
-    this->glEnableVertexAttribArray(2);
-
-    this->glDrawElements(GL_TRIANGLES, indices.size(), GL_UNSIGNED_INT, 0);
-
-    this->glDisableVertexAttribArray(0);
-    this->glDisableVertexAttribArray(1);
-    this->glDisableVertexAttribArray(2);
-}
\ No newline at end of file
+    // Découpes rejouées dans l'ordre : chacune coupe le fragment parent, couvercles précédents compris
+    MeshData data = buildMeshData(state.type, lod);
+    for (int i = 0; i < state.cutCount; ++i) {
+        MeshSlicer::slice(data, state.cuts[i].normal, state.cuts[i].side, arena);
+    }
+    data.optimizeVertexCache();
+    return data;
+}
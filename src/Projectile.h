@@ -8,12 +8,12 @@
 #ifndef PROJECTILE_H
 #define PROJECTILE_H
 
-#include <QOpenGLFunctions>
-#include <QOpenGLExtraFunctions>
 #include <QVector3D>
-#include <QMatrix4x4>
-#include <QOpenGLShaderProgram>
-#include <QOpenGLTexture>
+#include "Mesh.h"
+#include "TrigTables.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <vector>
 
 /// Vitesse horizontale maximale par défaut
@@ -25,16 +25,18 @@ const float FRAGMENT_MAX_HORIZONTAL_VELOCITY = 8.0f;
 /// Vitesse verticale maximale des fragments après découpe
 const float FRAGMENT_MAX_VERTICAL_VELOCITY = 10.0f;   
 
-class QOpenGLShaderProgram;
-
 /**
  * @class Projectile
  * @brief Classe représentant un objet en mouvement dans le jeu
  * 
- * Gère le rendu, la physique et les collisions des objets lancés
- * vers le joueur (fruits et autres projectiles).
+ * Gère la physique, les collisions et la géométrie des objets lancés
+ * vers le joueur (fruits et autres projectiles). Les projectiles vivent dans le
+ * thread de simulation ; le rendu ne reçoit que des copies de leur état (State).
+ *
+ * La géométrie de chaque type est générée côté CPU par niveau de détail. Un
+ * fragment possède sa propre géométrie, découpée selon son plan de coupe.
  */
-class Projectile : public QOpenGLFunctions {
+class Projectile {
 public:
     /**
      * @brief Types de projectiles disponibles
@@ -47,6 +49,44 @@ public:
         WOOD_CUBE ///< Cube en bois
     };
 
+    static constexpr int TYPE_COUNT = 5;   ///< Nombre de types de projectiles
+    static constexpr int LOD_COUNT = 3;    ///< Niveaux de détail précalculés par type
+    static constexpr int MAX_CUTS = 4;     ///< Découpes successives mémorisées par un fragment
+
+    /**
+     * @struct Cut
+     * @brief Plan d'une découpe, dans le repère du modèle
+     */
+    struct Cut {
+        QVector3D normal;                  ///< Normale du plan de coupe
+        int side = 0;                      ///< Côté conservé (1 dans le sens de la normale, -1 à l'opposé)
+    };
+
+    /**
+     * @struct State
+     * @brief Copie immuable de l'état utile au rendu, publiée à chaque pas
+     */
+    struct State {
+        quint32 id = 0;                    ///< Identifiant unique du projectile
+        Type type = Type::BANANA;
+        QVector3D position;
+        QVector3D previousPosition;        ///< Position au pas précédent (interpolation)
+        float rotationAngle = 0.0f;
+        float previousRotationAngle = 0.0f;
+        QVector3D rotationAxis;
+        float scale = 1.0f;
+        bool isFragment = false;
+        bool causedGameOver = false;
+        std::array<Cut, MAX_CUTS> cuts;    ///< Découpes subies, de la première à la dernière
+        int cutCount = 0;                  ///< Nombre d'entrées valides de cuts (0 : projectile entier)
+        QVector3D cutSurfaceColor;
+
+        /**
+         * @brief Découpe qui a produit ce fragment (cutCount > 0)
+         */
+        const Cut& lastCut() const { return cuts[cutCount - 1]; }
+    };
+
     /**
      * @brief Constructeur
      * @param type Type du projectile
@@ -56,13 +96,16 @@ public:
      * Initialise un nouveau projectile avec sa position et sa vitesse
      */
     Projectile(Type type, const QVector3D& position, const QVector3D& velocity);
-    
+
     /**
-     * @brief Destructeur
-     * 
-     * Libère les ressources OpenGL associées
+     * @brief Obtient l'identifiant unique du projectile
+     */
+    quint32 id() const { return m_id; }
+
+    /**
+     * @brief Copie l'état utile au rendu
      */
-    ~Projectile();
+    State state() const;
 
     /**
      * @brief Obtient la position du projectile
@@ -101,25 +144,13 @@ public:
      * Applique la physique (vitesse, gravité) et calcule la nouvelle position
      */
     void update(float deltaTime);
-    
+
     /**
-     * @brief Dessine le projectile
-     * @param shaderProgram Programme shader à utiliser
-     * @param projection Matrice de projection
-     * @param view Matrice de vue
+     * @brief Mémorise l'état courant comme état précédent, avant un pas de simulation
      * 
-     * Effectue le rendu du projectile avec sa texture appropriée
+     * Le rendu interpole ensuite entre cet état et celui produit par le pas
      */
-    void render(QOpenGLShaderProgram* shaderProgram, const QMatrix4x4& projection, const QMatrix4x4& view);
-    
-    /**
-     * @brief Dessine l'ombre du projectile
-     * @param shaderProgram Programme shader à utiliser
-     * @param projection Matrice de projection
-     * @param view Matrice de vue
-     * @param groundLevel Hauteur du sol
-     */
-    void renderShadow(QOpenGLShaderProgram* shaderProgram, const QMatrix4x4& projection, const QMatrix4x4& view, float groundLevel);
+    void storePreviousState();
     
     /**
      * @brief Vérifie la collision avec un cylindre (épée)
@@ -132,16 +163,44 @@ public:
     
     /**
      * @brief Divise le projectile en fragments
-     * @return Vecteur contenant les fragments résultants
+     * @return Vecteur contenant les fragments résultants, vide si le projectile
+     *         est inactif ou a déjà subi MAX_CUTS découpes
      * 
-     * Simule la découpe du projectile en plusieurs morceaux
+     * Simule la découpe du projectile en plusieurs morceaux. Chaque fragment
+     * hérite des plans de coupe de son parent et y ajoute le nouveau.
      */
     std::vector<Projectile> slice();
 
-    void initializeGL();
+    /**
+     * @brief Construit la géométrie d'un type
+     * @param type Type du projectile
+     * @param lod Niveau de détail (0 = le plus fin)
+     * @return Corps en partie 0, feuilles ou couronne éventuelles en partie 1
+     */
+    static MeshData buildMeshData(Type type, int lod = 0);
+
+    /**
+     * @brief Construit la géométrie découpée d'un fragment, réordonnée pour le cache de sommets
+     * @param state État du fragment (type, plans et côtés des découpes successives)
+     * @param lod Niveau de détail
+     */
+    static MeshData buildFragmentMeshData(const State& state, int lod);
 
     bool isFragment() const { return m_isFragment; }
 
+    /**
+     * @brief Nombre de découpes subies depuis le projectile entier (0 pour celui-ci)
+     */
+    int generation() const { return m_cutCount; }
+
+    /**
+     * @brief Fait disparaître le projectile en le réduisant jusqu'à une taille nulle
+     * @param duration Durée de la disparition en secondes, après quoi il devient inactif
+     */
+    void startFade(float duration);
+
+    bool isFading() const { return m_fadeDuration > 0.0f; }
+
     void markForGameOver() { m_causedGameOver = true; }
     bool causedGameOver() const { return m_causedGameOver; }
 
@@ -169,45 +228,56 @@ public:
 
 private:
 
-    void renderBanana(QOpenGLShaderProgram* shaderProgram);
-    void renderApple(QOpenGLShaderProgram* shaderProgram);
-    void renderAnanas(QOpenGLShaderProgram* shaderProgram);
-    void renderFraise(QOpenGLShaderProgram* shaderProgram);
-    void renderWoodCube(QOpenGLShaderProgram* shaderProgram);
+    /**
+     * @brief Géométrie d'un type au niveau LOD
+     *
+     * Chaque niveau est une instanciation distincte : ses nombres de segments
+     * sont des constantes et ses tables de sinus et cosinus sont calculées à la
+     * compilation (voir TrigTables.h).
+     */
+    template <int LOD> static MeshData buildLevel(Type type);
+
+    template <int LOD> static MeshData buildBanana();
+    template <int LOD> static MeshData buildApple();
+    template <int LOD> static MeshData buildAnanas();
+    template <int LOD> static MeshData buildFraise();
+    static MeshData buildWoodCube();
 
-    void renderBananaShadow(QOpenGLShaderProgram* shaderProgram);
-    void renderAppleShadow(QOpenGLShaderProgram* shaderProgram);
-    void renderAnanasShadow(QOpenGLShaderProgram* shaderProgram);
-    void renderFraiseShadow(QOpenGLShaderProgram* shaderProgram);
-    void renderWoodCubeShadow(QOpenGLShaderProgram* shaderProgram);
+    /**
+     * @brief Subdivisions d'un niveau de détail
+     * @param full Subdivisions du niveau le plus fin
+     * @param lod Niveau de détail
+     * @param minimum Valeur plancher
+     */
+    static constexpr int lodSteps(int full, int lod, int minimum = 4) {
+        return std::max(minimum, full >> lod);
+    }
 
-    void generateCutSurface(const QVector3D& sliceNormal, float direction);
+    void assignCutSurfaceColor();
 
+    quint32 m_id;                   ///< Identifiant unique, attribué à la construction
     Type m_type;
     QVector3D m_position;
+    QVector3D m_previousPosition;   ///< Position au pas de simulation précédent
     QVector3D m_velocity;
     float m_rotationAngle;
+    float m_previousRotationAngle;  ///< Angle au pas de simulation précédent
     QVector3D m_rotationAxis;
     bool m_active;
     float m_scale;
 
-    QOpenGLTexture* m_texture;
-    bool m_hasTexture;
-    GLuint m_vao;
-    GLuint m_vbo;
-    GLuint m_ebo;
-    bool m_initialized;
     bool m_isFragment;  
 
-    int m_fragmentSide = 0;         
-    QVector3D m_sliceNormal;        
+    std::array<Cut, MAX_CUTS> m_cuts;   ///< Découpes subies depuis le projectile entier
+    int m_cutCount = 0;
 
-    std::vector<QVector3D> m_cutVertices;
     QVector3D m_cutSurfaceColor;
 
     bool m_causedGameOver = false;  
 
-    void applyFragmentCutPlane(std::vector<GLfloat>& vertices, std::vector<GLuint>& indices);
+    float m_fadeDuration = 0.0f;    ///< Durée de la disparition (0 : aucune en cours)
+    float m_fadeRemaining = 0.0f;   ///< Temps restant avant de devenir inactif
+    float m_fadeScale = 0.0f;       ///< Échelle au début de la disparition
 
     static constexpr float GRAVITY = 8.5f; 
 
@@ -0,0 +1,268 @@
+#include "ProjectileRenderer.h"
+#include "TextureLoader.h"
+#include <QDebug>
+#include <QtConcurrent>
+#include <algorithm>
+
+namespace {
+
+const char* texturePath(Projectile::Type type) {
+    switch (type) {
+    case Projectile::Type::BANANA:
+        return ":/new/prefix2/resources/images/banana4_texture.jpg";
+    case Projectile::Type::APPLE:
+        return ":/new/prefix2/resources/images/apple_texture.jpg";
+    case Projectile::Type::ANANAS:
+        return ":/new/prefix2/resources/images/ananas2_texture.jpg";
+    case Projectile::Type::FRAISE:
+        return ":/new/prefix2/resources/images/Fraise_texture.jpg";
+    case Projectile::Type::WOOD_CUBE:
+        return ":/new/prefix2/resources/images/wood_texture.jpg";
+    }
+    return nullptr;
+}
+
+}
+
+void ProjectileRenderer::prefetchTextures() {
+    for (int index = 0; index < Projectile::TYPE_COUNT; ++index) {
+        const QString path = texturePath(Projectile::Type(index));
+        m_textureDecodes[index] = QtConcurrent::run([path]() { return TextureLoader::decode(path); });
+    }
+    m_texturesPrefetched = true;
+}
+
+void ProjectileRenderer::uploadSharedMeshes(const MeshLibrary& library) {
+    for (int type = 0; type < Projectile::TYPE_COUNT; ++type) {
+        const MeshAsset::Kind kind = MeshAsset::Kind(type);
+        for (int lod = 0; lod < MeshLibrary::lodCount(kind); ++lod) {
+            if (library.contains(kind, lod) && !m_sharedMeshes[type][lod]) {
+                m_sharedMeshes[type][lod] = std::make_shared<Mesh>();
+                library.upload(*m_sharedMeshes[type][lod], kind, lod);
+            }
+        }
+    }
+}
+
+void ProjectileRenderer::processUploads(MeshUploadQueue& queue) {
+    queue.takeAll(m_uploads, m_awaited);
+
+    for (const MeshUploadRequest& request : m_uploads) {
+        Entry& entry = m_entries[request.ownerId];
+        entry.lastFrame = m_frame;
+
+        const int levels = std::min(int(request.levels.size()), Projectile::LOD_COUNT);
+        for (int lod = 0; lod < levels; ++lod) {
+            entry.fragmentMeshes[lod] = std::make_shared<Mesh>();
+            entry.fragmentMeshes[lod]->upload(request.levels[lod].view());
+        }
+    }
+}
+
+void ProjectileRenderer::beginFrame() {
+    ++m_frame;
+}
+
+void ProjectileRenderer::endFrame() {
+    // Une image de grâce : un envoi peut précéder l'état qui contient son fragment
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (it->lastFrame + 1 < m_frame) {
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void ProjectileRenderer::releaseResources() {
+    m_entries.clear();
+    for (auto& levels : m_sharedMeshes) {
+        for (std::shared_ptr<Mesh>& mesh : levels) {
+            mesh.reset();
+        }
+    }
+    for (QOpenGLTexture*& texture : m_textures) {
+        delete texture;
+        texture = nullptr;
+    }
+    m_texturesLoaded.fill(false);
+}
+
+std::shared_ptr<Mesh> ProjectileRenderer::sharedMesh(Projectile::Type type, int lod) {
+    // Le cube n'a que douze triangles : un seul niveau
+    if (type == Projectile::Type::WOOD_CUBE) {
+        lod = 0;
+    }
+
+    std::shared_ptr<Mesh>& mesh = m_sharedMeshes[int(type)][lod];
+    if (!mesh) {
+        mesh = std::make_shared<Mesh>();
+        mesh->upload(MeshLibrary::generate(MeshAsset::Kind(type), lod));
+    }
+    return mesh;
+}
+
+QOpenGLTexture* ProjectileRenderer::sharedTexture(Projectile::Type type) {
+    const int index = int(type);
+    if (!m_texturesLoaded[index]) {
+        m_texturesLoaded[index] = true;
+
+        // N'attend que si le décodage lancé au démarrage n'est pas encore fini
+        m_textures[index] = m_texturesPrefetched ? TextureLoader::upload(m_textureDecodes[index].result())
+                                                 : TextureLoader::load(texturePath(type));
+        m_textureDecodes[index] = QFuture<TextureLoader::Decoded>();
+        if (!m_textures[index]) {
+            qWarning() << "Failed to load projectile texture" << texturePath(type);
+        }
+    }
+    return m_textures[index];
+}
+
+int ProjectileRenderer::selectLod(int current, float screenRadius) {
+    if (current < 0) {
+        int lod = 0;
+        while (lod < Projectile::LOD_COUNT - 1 && screenRadius < LOD_SWITCH_RADIUS[lod]) {
+            ++lod;
+        }
+        return lod;
+    }
+
+    int lod = current;
+    while (lod > 0 && screenRadius > LOD_SWITCH_RADIUS[lod - 1] * (1.0f + LOD_HYSTERESIS)) {
+        --lod;
+    }
+    while (lod < Projectile::LOD_COUNT - 1 && screenRadius < LOD_SWITCH_RADIUS[lod] * (1.0f - LOD_HYSTERESIS)) {
+        ++lod;
+    }
+    return lod;
+}
+
+QVector3D ProjectileRenderer::interpolatedPosition(const Projectile::State& state, float alpha) {
+    return state.previousPosition + (state.position - state.previousPosition) * alpha;
+}
+
+QMatrix4x4 ProjectileRenderer::modelMatrix(const Projectile::State& state, float alpha) {
+    // L'angle repasse à 0 après 360 : interpoler par le plus court chemin
+    float angleDelta = state.rotationAngle - state.previousRotationAngle;
+    if (angleDelta < -180.0f) {
+        angleDelta += 360.0f;
+    }
+
+    QMatrix4x4 model;
+    model.translate(interpolatedPosition(state, alpha));
+    model.rotate(state.previousRotationAngle + angleDelta * alpha, state.rotationAxis);
+    model.scale(state.scale);
+
+    if (state.causedGameOver) {
+        model.scale(1.2f);
+    }
+    return model;
+}
+
+QVector4D ProjectileRenderer::bodyColor(const Projectile::State& state) {
+    if (state.causedGameOver) {
+        return QVector4D(1.0f, 0.0f, 0.0f, 1.0f);
+    }
+
+    switch (state.type) {
+    case Projectile::Type::BANANA:
+        return state.isFragment ? QVector4D(1.0f, 0.98f, 0.8f, 1.0f) : QVector4D(1.0f, 0.9f, 0.0f, 1.0f);
+    case Projectile::Type::APPLE:
+        return state.isFragment ? QVector4D(0.98f, 0.98f, 0.95f, 1.0f) : QVector4D(0.4f, 0.8f, 0.2f, 1.0f);
+    case Projectile::Type::ANANAS:
+        return QVector4D(0.85f, 0.65f, 0.25f, 1.0f);
+    case Projectile::Type::WOOD_CUBE:
+        return QVector4D(0.8f, 0.6f, 0.4f, 1.0f);
+    case Projectile::Type::FRAISE:
+        return QVector4D(1.0f, 0.1f, 0.2f, 1.0f);
+    }
+    return QVector4D(1.0f, 1.0f, 1.0f, 1.0f);
+}
+
+QVector4D ProjectileRenderer::detailColor(const Projectile::State& state) {
+    switch (state.type) {
+    case Projectile::Type::APPLE:
+        return QVector4D(0.0f, 0.4f, 0.0f, 1.0f);
+    case Projectile::Type::ANANAS:
+        return QVector4D(0.05f, 0.3f, 0.05f, 1.0f);
+    case Projectile::Type::FRAISE:
+        return QVector4D(0.05f, 0.35f, 0.05f, 1.0f);
+    default:
+        return bodyColor(state);
+    }
+}
+
+void ProjectileRenderer::submit(RenderQueue& queue, const Projectile::State& state,
+                                const ProjectileView& view, CullingStats& stats) {
+    Entry& entry = m_entries[state.id];
+    entry.lastFrame = m_frame;
+
+    // Découpe encore en cours sur un thread de travail : le fragment apparaît à l'image suivante
+    if (state.isFragment && m_awaited.contains(state.id)) return;
+
+    const QVector3D center = interpolatedPosition(state, view.interpolation);
+
+    // Sphère englobante : maillage du niveau courant, ou du plus fin au premier rendu
+    const int currentLod = std::max(entry.lod, 0);
+    const std::shared_ptr<Mesh>& reference = state.isFragment ? entry.fragmentMeshes[currentLod] : sharedMesh(state.type, currentLod);
+    float radius = (reference ? reference->boundingRadius() : 0.5f) * state.scale;
+    if (state.causedGameOver) {
+        radius *= 1.2f;
+    }
+
+    // Une sphère hors champ peut encore projeter une ombre visible : les deux tests sont indépendants
+    const bool visible = view.camera.intersectsSphere(center, radius);
+    const bool castsShadow = view.light.intersectsSphere(center, radius);
+
+    visible ? ++stats.drawn : ++stats.culled;
+    castsShadow ? ++stats.shadowCasters : ++stats.shadowCulled;
+    if (!visible && !castsShadow) return;
+
+    // Le niveau n'évolue que pour les objets visibles, une ombre seule garde le dernier choisi
+    if (visible || entry.lod < 0) {
+        const float distance = std::max((center - view.eye).length(), 0.1f);
+        entry.lod = selectLod(entry.lod, radius * view.pixelsPerUnit / distance);
+    }
+
+    std::shared_ptr<Mesh> mesh;
+    if (state.isFragment) {
+        mesh = entry.fragmentMeshes[entry.lod];
+        if (!mesh) {
+            // Découpe ni reçue ni annoncée : construite ici à partir du plan publié
+            mesh = std::make_shared<Mesh>();
+            mesh->upload(Projectile::buildFragmentMeshData(state, entry.lod));
+            entry.fragmentMeshes[entry.lod] = mesh;
+        }
+    } else {
+        mesh = sharedMesh(state.type, entry.lod);
+    }
+
+    const QMatrix4x4 model = modelMatrix(state, view.interpolation);
+
+    DrawState drawState;
+    drawState.material = RenderUniforms::MATERIAL_PROJECTILE;
+    drawState.isFragment = state.isFragment;
+    drawState.cutSurfaceColor = QVector4D(state.cutSurfaceColor, 1.0f);
+    drawState.cullFace = false;
+    drawState.texture = sharedTexture(state.type);
+    drawState.color = bodyColor(state);
+
+    // La file ne garde que des pointeurs : l'entrée ou le tableau partagé maintient le maillage en vie
+    Mesh* target = mesh.get();
+    if (castsShadow) {
+        for (int part = 0; part < target->partCount(); ++part) {
+            queue.submit(RenderQueue::LAYER_SHADOW, target, part, model, drawState);
+        }
+    }
+
+    if (!visible) return;
+
+    queue.submit(RenderQueue::LAYER_OPAQUE, target, 0, model, drawState);
+
+    // Feuilles et couronne : même tampon, plage d'indices suivante
+    if (target->partCount() > 1) {
+        drawState.texture = nullptr;
+        drawState.color = detailColor(state);
+        queue.submit(RenderQueue::LAYER_OPAQUE, target, 1, model, drawState);
+    }
+}
@@ -0,0 +1,158 @@
+/**
+ * @file ProjectileRenderer.h
+ * @brief Rendu des projectiles à partir des états publiés par la simulation
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef PROJECTILERENDERER_H
+#define PROJECTILERENDERER_H
+
+#include <QFuture>
+#include <QHash>
+#include <QMatrix4x4>
+#include <QOpenGLTexture>
+#include <QSet>
+#include <QVector3D>
+#include <QVector4D>
+#include "Frustum.h"
+#include "Mesh.h"
+#include "MeshLibrary.h"
+#include "MeshUploadQueue.h"
+#include "Projectile.h"
+#include "RenderQueue.h"
+#include "TextureLoader.h"
+#include <array>
+#include <memory>
+#include <vector>
+
+/**
+ * @struct ProjectileView
+ * @brief Paramètres de l'image partagés par tous les projectiles soumis au rendu
+ */
+struct ProjectileView {
+    Frustum camera;                ///< Pyramide de vision de la caméra
+    Frustum light;                 ///< Volume couvert par la carte d'ombre
+    QVector3D eye;                 ///< Position de la caméra
+    float pixelsPerUnit = 0.0f;    ///< Pixels couverts par une unité monde à distance 1
+    float interpolation = 1.0f;    ///< Position entre l'avant-dernier (0) et le dernier pas (1)
+};
+
+/**
+ * @class ProjectileRenderer
+ * @brief Maillages, textures et niveaux de détail des projectiles (thread OpenGL)
+ *
+ * La géométrie de chaque type est envoyée une seule fois par niveau de détail et
+ * partagée par tous les projectiles de ce type, de même que leur texture. Les
+ * fragments ont leurs propres maillages, découpés par des tâches de fond et
+ * reçus par la file d'envoi ; un fragment n'est pas tracé tant que sa découpe
+ * est annoncée sans être arrivée. L'état propre au rendu (niveau de détail
+ * courant) est conservé par identifiant de projectile et oublié quand celui-ci
+ * disparaît.
+ */
+class ProjectileRenderer {
+public:
+    ProjectileRenderer() = default;
+
+    ProjectileRenderer(const ProjectileRenderer&) = delete;
+    ProjectileRenderer& operator=(const ProjectileRenderer&) = delete;
+
+    /**
+     * @brief Lance le décodage des textures des projectiles en arrière-plan (QtConcurrent)
+     *
+     * Les textures ne servent qu'à l'apparition du premier projectile : leur
+     * décodage ne retarde pas la première image, seul l'envoi se fait ensuite
+     * sur le thread OpenGL.
+     */
+    void prefetchTextures();
+
+    /**
+     * @brief Envoie les maillages partagés présents dans le fichier précalculé (contexte courant requis)
+     * @param library Maillages projetés en mémoire
+     *
+     * Ceux qui manquent restent générés à la première apparition de leur type.
+     */
+    void uploadSharedMeshes(const MeshLibrary& library);
+
+    /**
+     * @brief Crée les maillages des fragments déposés par la simulation (contexte courant requis)
+     * @param queue File d'envoi alimentée par le thread de simulation
+     */
+    void processUploads(MeshUploadQueue& queue);
+
+    /**
+     * @brief Démarre une image
+     */
+    void beginFrame();
+
+    /**
+     * @brief Ajoute les tracés d'un projectile à la file de rendu
+     * @param queue File de rendu de l'image
+     * @param state État publié par la simulation
+     * @param view Caméra, volume de la lumière et facteur d'interpolation de l'image
+     * @param stats Compteurs d'élimination de l'image
+     *
+     * Le projectile est placé entre ses deux derniers états simulés. Soumet le
+     * corps (texturé) et les feuilles dans la couche opaque si la sphère
+     * englobante est dans le champ de la caméra, et toutes les parties dans la
+     * couche d'ombre si elle est dans le volume de la lumière. Le maillage
+     * utilisé dépend du rayon projeté à l'écran.
+     */
+    void submit(RenderQueue& queue, const Projectile::State& state, const ProjectileView& view, CullingStats& stats);
+
+    /**
+     * @brief Termine une image : oublie les projectiles qui n'existent plus
+     */
+    void endFrame();
+
+    /**
+     * @brief Libère les maillages et textures (contexte courant requis)
+     */
+    void releaseResources();
+
+private:
+    static constexpr float LOD_SWITCH_RADIUS[Projectile::LOD_COUNT - 1] = { 60.0f, 25.0f }; ///< Rayons écran (px) entre deux niveaux
+    static constexpr float LOD_HYSTERESIS = 0.15f;   ///< Marge relative avant de changer de niveau
+
+    /**
+     * @struct Entry
+     * @brief État de rendu d'un projectile, conservé d'une image à l'autre
+     */
+    struct Entry {
+        int lod = -1;                  ///< Niveau courant (-1 : pas encore choisi)
+        quint64 lastFrame = 0;         ///< Dernière image où le projectile existait
+        std::array<std::shared_ptr<Mesh>, Projectile::LOD_COUNT> fragmentMeshes; ///< Maillages découpés
+    };
+
+    std::shared_ptr<Mesh> sharedMesh(Projectile::Type type, int lod);
+    QOpenGLTexture* sharedTexture(Projectile::Type type);
+
+    /**
+     * @brief Choisit le niveau de détail avec hystérésis autour des seuils
+     * @param current Niveau courant (-1 : aucun, choix direct)
+     * @param screenRadius Rayon projeté de la sphère englobante en pixels
+     */
+    static int selectLod(int current, float screenRadius);
+
+    /**
+     * @brief Matrice du modèle entre l'état précédent et l'état courant
+     * @param alpha 0 pour l'état précédent, 1 pour l'état courant
+     */
+    static QMatrix4x4 modelMatrix(const Projectile::State& state, float alpha);
+    static QVector3D interpolatedPosition(const Projectile::State& state, float alpha);
+    static QVector4D bodyColor(const Projectile::State& state);
+    static QVector4D detailColor(const Projectile::State& state);
+
+    std::array<std::array<std::shared_ptr<Mesh>, Projectile::LOD_COUNT>, Projectile::TYPE_COUNT> m_sharedMeshes;
+    std::array<QOpenGLTexture*, Projectile::TYPE_COUNT> m_textures{};
+    std::array<bool, Projectile::TYPE_COUNT> m_texturesLoaded{};
+    std::array<QFuture<TextureLoader::Decoded>, Projectile::TYPE_COUNT> m_textureDecodes;
+    bool m_texturesPrefetched = false;
+
+    QHash<quint32, Entry> m_entries;                 ///< État de rendu par identifiant de projectile
+    std::vector<MeshUploadRequest> m_uploads;        ///< Demandes récupérées, capacité réutilisée
+    QSet<quint32> m_awaited;                         ///< Fragments dont la découpe n'est pas encore reçue
+    quint64 m_frame = 0;
+};
+
+#endif
@@ -0,0 +1,142 @@
+#include "RenderQueue.h"
+#include <algorithm>
+
+namespace {
+
+const int LAYER_SHIFT = 62;
+const int SEQUENCE_BITS = 17;
+const int DEPTH_BITS = 20;
+const int MESH_BITS = 10;
+const int TEXTURE_BITS = 12;
+
+const float MAX_DEPTH = 64.0f;   // Au-delà, les tracés partagent la même profondeur
+
+quint64 field(quint64 value, int bits) {
+    return value & ((quint64(1) << bits) - 1);
+}
+
+}
+
+void RenderQueue::begin(const QMatrix4x4& view) {
+    m_commands.clear();
+    m_view = view;
+    m_stats = Stats();
+}
+
+void RenderQueue::submit(Layer layer, Mesh* mesh, int part, const QMatrix4x4& model, const DrawState& state) {
+    submit(layer, mesh, part, model, state, model.column(3).toVector3D());
+}
+
+void RenderQueue::submit(Layer layer, Mesh* mesh, int part, const QMatrix4x4& model, const DrawState& state,
+                         const QVector3D& center) {
+    if (!mesh || !mesh->isUploaded()) {
+        return;
+    }
+
+    const float depth = -m_view.map(center).z();
+    m_commands.push_back({ makeKey(layer, mesh, state, depth), mesh, part, model, state });
+}
+
+quint64 RenderQueue::makeKey(Layer layer, const Mesh* mesh, const DrawState& state, float depth) const {
+    const quint64 maxDepth = (quint64(1) << DEPTH_BITS) - 1;
+    quint64 quantized = quint64(std::clamp(depth / MAX_DEPTH, 0.0f, 1.0f) * float(maxDepth));
+
+    quint64 variant = 0;
+    quint64 texture = 0;
+    if (layer != LAYER_SHADOW) {
+        variant = quint64(RenderUniforms::variantIndex(state.texture != nullptr, state.material, state.isFragment));
+        texture = state.texture ? quint64(state.texture->textureId()) : 0;
+    }
+
+    quint64 key = quint64(layer) << LAYER_SHIFT;
+    quint64 stateBits = (field(variant, 3) << (TEXTURE_BITS + MESH_BITS))
+                      | (field(texture, TEXTURE_BITS) << MESH_BITS)
+                      | field(mesh->id(), MESH_BITS);
+
+    if (layer == LAYER_TRANSPARENT) {
+        key |= (maxDepth - quantized) << (3 + TEXTURE_BITS + MESH_BITS + SEQUENCE_BITS);
+        key |= stateBits << SEQUENCE_BITS;
+    } else {
+        key |= stateBits << (DEPTH_BITS + SEQUENCE_BITS);
+        key |= quantized << SEQUENCE_BITS;
+    }
+
+    return key | field(m_commands.size(), SEQUENCE_BITS);
+}
+
+void RenderQueue::sort() {
+    std::sort(m_commands.begin(), m_commands.end(), [](const DrawCommand& a, const DrawCommand& b) {
+        return a.key < b.key;
+    });
+}
+
+void RenderQueue::execute(RenderUniforms& uniforms, Layer layer) {
+    if (!m_initialized) {
+        initializeOpenGLFunctions();
+        m_initialized = true;
+    }
+
+    const quint64 layerBits = quint64(layer);
+    auto first = std::lower_bound(m_commands.begin(), m_commands.end(), layerBits,
+                                  [](const DrawCommand& command, quint64 bits) {
+                                      return (command.key >> LAYER_SHIFT) < bits;
+                                  });
+
+    Mesh* currentMesh = nullptr;
+    QOpenGLTexture* currentTexture = nullptr;
+    bool cullFace = true;
+
+    if (layer == LAYER_TRANSPARENT) {
+        glDepthMask(GL_FALSE);
+    }
+
+    for (auto it = first; it != m_commands.end() && (it->key >> LAYER_SHIFT) == layerBits; ++it) {
+        const DrawCommand& command = *it;
+        const DrawState& state = command.state;
+
+        if (state.cullFace != cullFace) {
+            cullFace = state.cullFace;
+            cullFace ? glEnable(GL_CULL_FACE) : glDisable(GL_CULL_FACE);
+            m_stats.stateChanges++;
+        }
+
+        if (command.mesh != currentMesh) {
+            command.mesh->bind();
+            currentMesh = command.mesh;
+            m_stats.meshBinds++;
+        }
+
+        uniforms.setModel(command.model);
+
+        if (layer != LAYER_SHADOW) {
+            uniforms.setMaterial(state.material);
+            uniforms.setFragment(state.isFragment, state.cutSurfaceColor);
+            uniforms.setTexture(state.texture != nullptr);
+            uniforms.setColor(state.color);
+
+            if (state.texture && state.texture != currentTexture) {
+                state.texture->bind(0);
+                currentTexture = state.texture;
+                m_stats.textureBinds++;
+            }
+        }
+
+        uniforms.apply();
+        command.mesh->drawPart(command.part);
+        m_stats.draws++;
+    }
+
+    if (currentMesh) {
+        currentMesh->release();
+    }
+    if (currentTexture) {
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    if (!cullFace) {
+        glEnable(GL_CULL_FACE);
+    }
+    if (layer == LAYER_TRANSPARENT) {
+        glDepthMask(GL_TRUE);
+    }
+    uniforms.setTexture(false);
+}
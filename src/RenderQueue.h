@@ -0,0 +1,126 @@
+/**
+ * @file RenderQueue.h
+ * @brief File de rendu triée par clé pour limiter les changements d'état
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <QOpenGLFunctions>
+#include <QOpenGLTexture>
+#include <QMatrix4x4>
+#include <QVector3D>
+#include <QVector4D>
+#include "Mesh.h"
+#include "RenderUniforms.h"
+#include <vector>
+
+/**
+ * @struct DrawState
+ * @brief État de rendu d'un tracé (matériau, couleur, texture, découpe)
+ */
+struct DrawState {
+    RenderUniforms::Material material = RenderUniforms::MATERIAL_DEFAULT;
+    QVector4D color = QVector4D(1.0f, 1.0f, 1.0f, 1.0f);
+    QOpenGLTexture* texture = nullptr;   ///< nullptr : couleur unie
+    bool isFragment = false;
+    QVector4D cutSurfaceColor;
+    bool cullFace = true;                ///< Élimination des faces arrière
+};
+
+/**
+ * @class RenderQueue
+ * @brief Collecte les tracés d'une image, les trie une fois puis les exécute
+ *
+ * Chaque tracé reçoit une clé de 64 bits. Les bits de poids fort désignent la
+ * couche (ombre, opaque, transparent) ; viennent ensuite, pour les couches
+ * ombre et opaque, la variante de shader, la texture, le maillage puis la
+ * profondeur (de l'avant vers l'arrière). Pour la couche transparente, la
+ * profondeur inversée passe avant l'état afin de tracer de l'arrière vers
+ * l'avant. Les bits de poids faible conservent l'ordre de soumission à état égal.
+ *
+ * À l'exécution, le VAO, la texture et les états fixes ne sont changés que
+ * lorsqu'ils diffèrent du tracé précédent ; RenderUniforms élimine déjà les
+ * changements de programme et d'uniformes redondants.
+ */
+class RenderQueue : protected QOpenGLFunctions {
+public:
+    /**
+     * @brief Couches de rendu, dans l'ordre d'exécution
+     */
+    enum Layer {
+        LAYER_SHADOW = 0,      ///< Carte d'ombre (profondeur seule)
+        LAYER_OPAQUE = 1,      ///< Objets opaques, écriture de la profondeur
+        LAYER_TRANSPARENT = 2  ///< Objets translucides, sans écriture de la profondeur
+    };
+
+    /**
+     * @brief Compteurs des couches exécutées depuis begin()
+     */
+    struct Stats {
+        int draws = 0;          ///< Tracés émis
+        int meshBinds = 0;      ///< Changements de VAO
+        int textureBinds = 0;   ///< Changements de texture
+        int stateChanges = 0;   ///< Changements d'élimination des faces ou de masque de profondeur
+    };
+
+    /**
+     * @brief Vide la file et définit la vue utilisée pour la profondeur des tracés
+     * @param view Matrice de vue de l'image
+     */
+    void begin(const QMatrix4x4& view);
+
+    /**
+     * @brief Ajoute un tracé
+     * @param layer Couche du tracé
+     * @param mesh Maillage (doit rester valide jusqu'à l'exécution)
+     * @param part Plage d'indices du maillage
+     * @param model Matrice de modèle
+     * @param state État de rendu
+     *
+     * La profondeur est mesurée à l'origine du modèle.
+     */
+    void submit(Layer layer, Mesh* mesh, int part, const QMatrix4x4& model, const DrawState& state);
+
+    /**
+     * @brief Ajoute un tracé dont la profondeur est mesurée en un point donné
+     * @param center Point de référence en coordonnées monde (centre de l'objet)
+     */
+    void submit(Layer layer, Mesh* mesh, int part, const QMatrix4x4& model, const DrawState& state,
+                const QVector3D& center);
+
+    /**
+     * @brief Trie les tracés par clé (une fois par image)
+     */
+    void sort();
+
+    /**
+     * @brief Exécute les tracés d'une couche
+     * @param uniforms État uniforme de la scène (passe déjà choisie)
+     * @param layer Couche à exécuter
+     */
+    void execute(RenderUniforms& uniforms, Layer layer);
+
+    int size() const { return int(m_commands.size()); }
+    const Stats& stats() const { return m_stats; }
+
+private:
+    struct DrawCommand {
+        quint64 key;
+        Mesh* mesh;
+        int part;
+        QMatrix4x4 model;
+        DrawState state;
+    };
+
+    quint64 makeKey(Layer layer, const Mesh* mesh, const DrawState& state, float depth) const;
+
+    std::vector<DrawCommand> m_commands;
+    QMatrix4x4 m_view;
+    bool m_initialized = false;
+    Stats m_stats;
+};
+
+#endif
@@ -0,0 +1,204 @@
+#include "RenderUniforms.h"
+#include "ShaderLibrary.h"
+#include "StreamBuffer.h"
+#include <QDebug>
+#include <cstring>
+
+namespace {
+
+void copyMatrix(float* destination, const QMatrix4x4& matrix) {
+    std::memcpy(destination, matrix.constData(), 16 * sizeof(float));
+}
+
+}
+
+bool RenderUniforms::initialize(const ShaderLibrary& library) {
+    initializeOpenGLFunctions();
+
+    const MaterialParams materials[MATERIAL_COUNT] = {
+        { 0.3f,  0.5f,  32.0f, 0.0f },  // MATERIAL_DEFAULT
+        { 0.4f,  0.1f,  8.0f,  0.0f },  // MATERIAL_GROUND
+        { 0.35f, 0.2f,  16.0f, 0.0f },  // MATERIAL_WALL
+        { 0.45f, 0.15f, 12.0f, 0.0f },  // MATERIAL_ROOF
+        { 0.3f,  0.7f,  64.0f, 0.0f },  // MATERIAL_PROJECTILE
+        { 0.0f,  0.0f,  1.0f,  0.0f }   // MATERIAL_UNLIT
+    };
+
+    glGenBuffers(1, &m_frameBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_frameBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameBlock), nullptr, GL_DYNAMIC_DRAW);
+
+    glGenBuffers(1, &m_materialBuffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, m_materialBuffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(materials), materials, GL_STATIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_BINDING, m_frameBuffer);
+    glBindBufferBase(GL_UNIFORM_BUFFER, MATERIAL_BINDING, m_materialBuffer);
+
+    bool ok = true;
+    for (int index = 0; index < int(m_variants.size()); ++index) {
+        Variant& variant = m_variants[index];
+        variant = Variant();
+        variant.program = index == DEPTH_VARIANT ? library.depthProgram() : library.program(index);
+        if (!variant.program) {
+            ok = false;
+            continue;
+        }
+
+        const GLuint id = variant.program->programId();
+        GLuint frameIndex = glGetUniformBlockIndex(id, "FrameBlock");
+        if (frameIndex == GL_INVALID_INDEX) {
+            qWarning() << "FrameBlock not found in shader variant" << index;
+            ok = false;
+        } else {
+            glUniformBlockBinding(id, frameIndex, FRAME_BINDING);
+        }
+
+        // Absent des variantes sans éclairage
+        GLuint materialIndex = glGetUniformBlockIndex(id, "MaterialBlock");
+        if (materialIndex != GL_INVALID_INDEX) {
+            glUniformBlockBinding(id, materialIndex, MATERIAL_BINDING);
+        }
+
+        variant.locations.modelMatrix = variant.program->uniformLocation("modelMatrix");
+        variant.locations.materialIndex = variant.program->uniformLocation("materialIndex");
+        variant.locations.color = variant.program->uniformLocation("color");
+        variant.locations.cutSurfaceColor = variant.program->uniformLocation("cutSurfaceColor");
+
+        variant.program->bind();
+        variant.program->setUniformValue("appleTexture", 0);
+        variant.program->setUniformValue("shadowMap", GLint(SHADOW_TEXTURE_UNIT));
+        variant.program->release();
+    }
+
+    m_current = nullptr;
+    m_pass = PASS_COLOR;
+    m_serials.fill(1);
+    return ok;
+}
+
+void RenderUniforms::destroy() {
+    if (m_frameBuffer) {
+        glDeleteBuffers(1, &m_frameBuffer);
+        m_frameBuffer = 0;
+    }
+    if (m_materialBuffer) {
+        glDeleteBuffers(1, &m_materialBuffer);
+        m_materialBuffer = 0;
+    }
+    m_variants = {};
+    m_current = nullptr;
+}
+
+void RenderUniforms::updateFrame(StreamBuffer& stream, const QMatrix4x4& view, const QMatrix4x4& projection,
+                                 const QVector3D& lightPosition, const QVector3D& lightColor,
+                                 const QMatrix4x4& lightViewProjection) {
+    FrameBlock block;
+    copyMatrix(block.view, view);
+    copyMatrix(block.viewProjection, projection * view);
+    copyMatrix(block.lightViewProjection, lightViewProjection);
+    block.lightPosition[0] = lightPosition.x();
+    block.lightPosition[1] = lightPosition.y();
+    block.lightPosition[2] = lightPosition.z();
+    block.lightPosition[3] = 1.0f;
+    block.lightColor[0] = lightColor.x();
+    block.lightColor[1] = lightColor.y();
+    block.lightColor[2] = lightColor.z();
+    block.lightColor[3] = 1.0f;
+
+    const GLintptr offset = stream.write(&block, sizeof(FrameBlock), stream.uniformAlignment());
+    if (offset >= 0) {
+        glBindBufferRange(GL_UNIFORM_BUFFER, FRAME_BINDING, stream.buffer(), offset, sizeof(FrameBlock));
+        return;
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, m_frameBuffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameBlock), &block);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_BINDING, m_frameBuffer);
+    m_uploadedBytes += sizeof(FrameBlock);
+}
+
+void RenderUniforms::setModel(const QMatrix4x4& model) {
+    m_model = model;
+    touch(FIELD_MODEL);
+}
+
+void RenderUniforms::setMaterial(Material material) {
+    if (material != m_material) {
+        m_material = material;
+        touch(FIELD_MATERIAL);
+    }
+}
+
+void RenderUniforms::setColor(const QVector4D& color) {
+    if (color != m_color) {
+        m_color = color;
+        touch(FIELD_COLOR);
+    }
+}
+
+void RenderUniforms::setTexture(bool useTexture) {
+    m_useTexture = useTexture;
+}
+
+void RenderUniforms::setFragment(bool isFragment, const QVector4D& cutSurfaceColor) {
+    m_isFragment = isFragment;
+    if (isFragment && cutSurfaceColor != m_cutSurfaceColor) {
+        m_cutSurfaceColor = cutSurfaceColor;
+        touch(FIELD_CUT_COLOR);
+    }
+}
+
+int RenderUniforms::variantIndex(bool useTexture, Material material, bool isFragment) {
+    int flags = 0;
+    if (useTexture) flags |= ShaderLibrary::USE_TEXTURE;
+    if (material != MATERIAL_UNLIT) flags |= ShaderLibrary::USE_LIGHTING;
+    if (isFragment) flags |= ShaderLibrary::IS_FRAGMENT;
+    return ShaderLibrary::normalize(flags);
+}
+
+void RenderUniforms::apply() {
+    Variant& variant = m_pass == PASS_SHADOW ? m_variants[DEPTH_VARIANT]
+                                             : m_variants[variantIndex(m_useTexture, m_material, m_isFragment)];
+    if (!variant.program) {
+        return;
+    }
+
+    if (m_current != &variant) {
+        variant.program->bind();
+        m_current = &variant;
+    }
+
+    QOpenGLShaderProgram* program = variant.program;
+    const Locations& locations = variant.locations;
+
+    if (variant.uploaded[FIELD_MODEL] != m_serials[FIELD_MODEL]) {
+        program->setUniformValue(locations.modelMatrix, m_model);
+        variant.uploaded[FIELD_MODEL] = m_serials[FIELD_MODEL];
+        m_uploadedBytes += 16 * sizeof(GLfloat);
+    }
+    if (locations.materialIndex >= 0 && variant.uploaded[FIELD_MATERIAL] != m_serials[FIELD_MATERIAL]) {
+        program->setUniformValue(locations.materialIndex, int(m_material));
+        variant.uploaded[FIELD_MATERIAL] = m_serials[FIELD_MATERIAL];
+        m_uploadedBytes += sizeof(GLint);
+    }
+    if (locations.color >= 0 && variant.uploaded[FIELD_COLOR] != m_serials[FIELD_COLOR]) {
+        program->setUniformValue(locations.color, m_color);
+        variant.uploaded[FIELD_COLOR] = m_serials[FIELD_COLOR];
+        m_uploadedBytes += 4 * sizeof(GLfloat);
+    }
+    if (locations.cutSurfaceColor >= 0 && variant.uploaded[FIELD_CUT_COLOR] != m_serials[FIELD_CUT_COLOR]) {
+        program->setUniformValue(locations.cutSurfaceColor, m_cutSurfaceColor);
+        variant.uploaded[FIELD_CUT_COLOR] = m_serials[FIELD_CUT_COLOR];
+        m_uploadedBytes += 4 * sizeof(GLfloat);
+    }
+}
+
+void RenderUniforms::release() {
+    if (m_current) {
+        m_current->program->release();
+        m_current = nullptr;
+    }
+}
@@ -0,0 +1,193 @@
+/**
+ * @file RenderUniforms.h
+ * @brief Blocs uniformes (UBO) partagés par tous les objets de la scène
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef RENDERUNIFORMS_H
+#define RENDERUNIFORMS_H
+
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLShaderProgram>
+#include <QMatrix4x4>
+#include <QVector3D>
+#include <QVector4D>
+#include <array>
+
+class ShaderLibrary;
+class StreamBuffer;
+
+/**
+ * @class RenderUniforms
+ * @brief État uniforme de la scène réparti entre UBO et emplacements mis en cache
+ *
+ * Les données communes à une image (vue, projection, lumière) sont regroupées
+ * dans un bloc std140 écrit une seule fois par image dans le tampon circulaire
+ * de la scène, puis lié par glBindBufferRange. Les paramètres
+ * d'éclairage des matériaux sont placés dans un second bloc, envoyé une fois à
+ * l'initialisation : chaque objet ne fournit plus qu'un index de matériau.
+ *
+ * Les setters ne font que mémoriser l'état ; apply(), appelée juste avant chaque
+ * tracé, choisit la variante de shader correspondante (texture, éclairage,
+ * fragment) et n'envoie que les valeurs que ce programme n'a pas encore reçues.
+ * Pendant la passe d'ombre, toutes les variantes sont remplacées par le
+ * programme de profondeur et seule la matrice du modèle est utilisée.
+ */
+class RenderUniforms : protected QOpenGLExtraFunctions {
+public:
+    /**
+     * @brief Matériaux disponibles dans le bloc MaterialBlock
+     */
+    enum Material {
+        MATERIAL_DEFAULT = 0,  ///< Éclairage par défaut (épée, repères)
+        MATERIAL_GROUND,       ///< Sol
+        MATERIAL_WALL,         ///< Murs
+        MATERIAL_ROOF,         ///< Plafond
+        MATERIAL_PROJECTILE,   ///< Fruits et cubes
+        MATERIAL_UNLIT,        ///< Sans éclairage (source de lumière)
+        MATERIAL_COUNT
+    };
+
+    static constexpr GLuint FRAME_BINDING = 0;     ///< Point de liaison du bloc FrameBlock
+    static constexpr GLuint MATERIAL_BINDING = 1;  ///< Point de liaison du bloc MaterialBlock
+    static constexpr GLuint SHADOW_TEXTURE_UNIT = 1; ///< Unité de texture de la carte d'ombre
+
+    /**
+     * @brief Passe de rendu en cours
+     */
+    enum Pass {
+        PASS_COLOR,   ///< Rendu de la scène
+        PASS_SHADOW   ///< Profondeur vue depuis la lumière
+    };
+
+    /**
+     * @brief Crée les UBO et résout les emplacements des uniformes de chaque variante
+     * @param library Variantes de shader déjà liées
+     * @return true si le bloc FrameBlock a été trouvé dans toutes les variantes
+     *
+     * Doit être appelée avec le contexte OpenGL courant.
+     */
+    bool initialize(const ShaderLibrary& library);
+
+    /**
+     * @brief Libère les UBO (contexte courant requis)
+     */
+    void destroy();
+
+    /**
+     * @brief Écrit le bloc de l'image courante et le lie au point FRAME_BINDING
+     * @param stream Tampon circulaire de l'image (bloc mis à jour en place s'il est plein)
+     * @param view Matrice de vue
+     * @param projection Matrice de projection
+     * @param lightPosition Position de la lumière
+     * @param lightColor Couleur de la lumière
+     * @param lightViewProjection Projection de la carte d'ombre
+     */
+    void updateFrame(StreamBuffer& stream, const QMatrix4x4& view, const QMatrix4x4& projection,
+                     const QVector3D& lightPosition, const QVector3D& lightColor,
+                     const QMatrix4x4& lightViewProjection);
+
+    /**
+     * @brief Choisit la passe de rendu
+     * @param pass PASS_SHADOW pour utiliser le programme de profondeur
+     */
+    void setPass(Pass pass) { m_pass = pass; }
+    Pass pass() const { return m_pass; }
+
+    void setModel(const QMatrix4x4& model);
+    void setMaterial(Material material);
+    void setColor(const QVector4D& color);
+    void setTexture(bool useTexture);
+
+    /**
+     * @brief Définit l'état de découpe d'un fragment
+     * @param isFragment true pour un fragment découpé
+     * @param cutSurfaceColor Couleur de la surface de coupe
+     */
+    void setFragment(bool isFragment, const QVector4D& cutSurfaceColor = QVector4D());
+
+    /**
+     * @brief Index de la variante de shader utilisée pour un état donné
+     * @param useTexture Couleur lue dans la texture
+     * @param material Matériau (MATERIAL_UNLIT désactive l'éclairage)
+     * @param isFragment Fragment découpé
+     * @return Index normalisé de la variante (voir ShaderLibrary)
+     */
+    static int variantIndex(bool useTexture, Material material, bool isFragment);
+
+    /**
+     * @brief Active la variante adaptée à l'état courant et envoie les valeurs modifiées
+     *
+     * À appeler immédiatement avant chaque glDraw*.
+     */
+    void apply();
+
+    /**
+     * @brief Désactive le programme courant
+     */
+    void release();
+
+    /**
+     * @brief Octets envoyés depuis la création hors tampon circulaire (uniformes des objets)
+     */
+    quint64 uploadedBytes() const { return m_uploadedBytes; }
+
+private:
+    /// Contenu du bloc FrameBlock, disposition std140
+    struct FrameBlock {
+        float view[16];
+        float viewProjection[16];
+        float lightViewProjection[16];
+        float lightPosition[4];
+        float lightColor[4];
+    };
+
+    /// Un matériau du bloc MaterialBlock, disposition std140 (un vec4)
+    struct MaterialParams {
+        float ambientStrength;
+        float specularStrength;
+        float shininess;
+        float padding;
+    };
+
+    /// Valeurs suivies individuellement
+    enum Field { FIELD_MODEL, FIELD_MATERIAL, FIELD_COLOR, FIELD_CUT_COLOR, FIELD_COUNT };
+
+    /// Emplacements des uniformes propres à chaque objet
+    struct Locations {
+        int modelMatrix = -1;
+        int materialIndex = -1;
+        int color = -1;
+        int cutSurfaceColor = -1;
+    };
+
+    /// Programme d'une variante et valeurs déjà envoyées
+    struct Variant {
+        QOpenGLShaderProgram* program = nullptr;
+        Locations locations;
+        std::array<quint32, FIELD_COUNT> uploaded{};
+    };
+
+    void touch(Field field) { m_serials[field]++; }
+
+    static constexpr int DEPTH_VARIANT = 8;   ///< Index du programme de profondeur
+
+    std::array<Variant, DEPTH_VARIANT + 1> m_variants;
+    Variant* m_current = nullptr;
+    Pass m_pass = PASS_COLOR;
+
+    QMatrix4x4 m_model;
+    Material m_material = MATERIAL_DEFAULT;
+    QVector4D m_color;
+    QVector4D m_cutSurfaceColor;
+    bool m_useTexture = false;
+    bool m_isFragment = false;
+    std::array<quint32, FIELD_COUNT> m_serials{};
+
+    GLuint m_frameBuffer = 0;                 ///< Bloc de l'image si le tampon circulaire est indisponible
+    GLuint m_materialBuffer = 0;
+    quint64 m_uploadedBytes = 0;
+};
+
+#endif
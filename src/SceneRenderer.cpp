@@ -0,0 +1,477 @@
+#include "SceneRenderer.h"
+#include "TrigTables.h"
+#include <QtConcurrent>
+#include <QtMath>
+#include <QDebug>
+#include <cmath>
+
+SceneRenderer::SceneRenderer(float cylinderRadius, float cylinderHeight)
+    : m_cylinderRadius(cylinderRadius),
+      m_cylinderHeight(cylinderHeight)
+{
+}
+
+void SceneRenderer::prefetchTextures() {
+    decodeTextureAsync(&m_groundTexture, ":/new/prefix2/resources/images/floor_texture.jpg", "ground");
+    decodeTextureAsync(&m_wallTexture, ":/new/prefix2/resources/images/wall_text.jpg", "wall");
+    decodeTextureAsync(&m_backWallTexture, ":/new/prefix2/resources/images/door_texture.jpg", "door");
+    decodeTextureAsync(&m_roofTexture, ":/new/prefix2/resources/images/roof_texture.jpg", "roof");
+    decodeTextureAsync(&m_bladeTexture, ":/new/prefix2/resources/images/blade2_texture.jpg", "blade");
+    decodeTextureAsync(&m_handleTexture, ":/new/prefix2/resources/images/handle_texture.jpg", "handle");
+    m_projectileRenderer.prefetchTextures();
+}
+
+void SceneRenderer::decodeTextureAsync(QOpenGLTexture** target, const QString& path, const char* name) {
+    m_pendingTextures.push_back({ QtConcurrent::run([path]() { return TextureLoader::decode(path); }), target, name });
+}
+
+void SceneRenderer::initialize() {
+    initializeOpenGLFunctions();
+
+    glEnable(GL_DEPTH_TEST);
+    glEnable(GL_CULL_FACE);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+    if (!m_shaders.initialize()) {
+        qWarning("Failed to build shader variants");
+    }
+    m_stream.initialize();
+    m_uniforms.initialize(m_shaders);
+
+    if (!m_shadowMap.initialize()) {
+        qWarning("Failed to create shadow map");
+    }
+
+    m_gpuProfiler.initialize();
+
+    if (!m_juice.initialize()) {
+        qWarning("Failed to build juice particle shaders");
+    }
+
+    m_meshLibrary.open();
+    m_projectileRenderer.uploadSharedMeshes(m_meshLibrary);
+    buildSwordMesh();
+    buildArenaMeshes();
+
+    // L'arène et l'épée figurent sur la première image : on attend le reste de leur décodage
+    for (PendingTexture& pending : m_pendingTextures) {
+        *pending.target = TextureLoader::upload(pending.decoded.result());
+        if (!*pending.target) {
+            qWarning("Failed to load %s texture", pending.name);
+        }
+    }
+    m_pendingTextures.clear();
+}
+
+void SceneRenderer::destroy() {
+    m_projectileRenderer.releaseResources();
+    m_swordMesh.reset();
+    m_arenaMesh.reset();
+    m_lightMesh.reset();
+    Mesh::collectGarbage();
+    m_gpuProfiler.destroy();
+    m_juice.destroy();
+    m_shadowMap.destroy();
+    m_uniforms.destroy();
+    m_stream.destroy();
+    m_shaders.destroy();
+
+    QOpenGLTexture** textures[] = {
+        &m_bladeTexture, &m_handleTexture, &m_groundTexture, &m_wallTexture, &m_backWallTexture, &m_roofTexture
+    };
+    for (QOpenGLTexture** texture : textures) {
+        delete *texture;
+        *texture = nullptr;
+    }
+}
+
+void SceneRenderer::beginFrame(MeshUploadQueue& uploads) {
+    m_gpuProfiler.beginFrame();
+    m_stream.beginFrame();
+    Mesh::collectGarbage();
+
+    m_projectileRenderer.beginFrame();
+    m_projectileRenderer.processUploads(uploads);
+}
+
+void SceneRenderer::render(const SceneFrame& frame) {
+    float lightTime = frame.time * 0.5f;
+    QVector3D lightPosition(
+        3.0f * sin(lightTime),
+        5.0f + 1.0f * sin(lightTime * 0.5f),
+        3.0f * cos(lightTime)
+    );
+
+    const QVector3D arenaCenter(0.0f, -m_cylinderHeight/2.0f - 0.3f, -2.25f);
+    const QMatrix4x4& lightViewProjection = m_shadowMap.update(lightPosition, arenaCenter);
+
+    m_uniforms.updateFrame(m_stream, frame.view, frame.projection, lightPosition, QVector3D(1.0f, 1.0f, 0.9f), lightViewProjection);
+
+    m_renderQueue.begin(frame.view);
+    submitArena(lightPosition);
+    if (frame.showSword) {
+        submitSword(frame.handPosition);
+    }
+
+    ProjectileView projectileView;
+    projectileView.camera.setMatrix(frame.projection * frame.view);
+    projectileView.light.setMatrix(lightViewProjection);
+    // Les fragments passés sous le sol ne peuvent plus ombrer la scène, la lumière restant au-dessus
+    projectileView.light.addPlane(QVector3D(0.0f, 1.0f, 0.0f), -arenaCenter.y());
+    projectileView.eye = frame.eye;
+    // Rayon projeté en pixels = rayon * pixelsPerUnit / distance
+    projectileView.pixelsPerUnit = float(frame.viewportHeight) / (2.0f * qTan(qDegreesToRadians(frame.fieldOfView) / 2.0f));
+    projectileView.interpolation = frame.interpolation;
+
+    m_cullingStats = CullingStats();
+    if (frame.projectiles) {
+        for (const Projectile::State& state : *frame.projectiles) {
+            m_projectileRenderer.submit(m_renderQueue, state, projectileView, m_cullingStats);
+        }
+    }
+    m_renderQueue.sort();
+
+    if (m_shadowMap.isValid()) {
+        m_gpuProfiler.beginPass(GpuProfiler::PASS_SHADOW);
+        m_shadowMap.begin();
+        m_uniforms.setPass(RenderUniforms::PASS_SHADOW);
+        m_renderQueue.execute(m_uniforms, RenderQueue::LAYER_SHADOW);
+        m_gpuProfiler.endPass();
+        m_uniforms.setPass(RenderUniforms::PASS_COLOR);
+
+        m_shadowMap.end(frame.targetFramebuffer, frame.viewportWidth, frame.viewportHeight);
+        m_shadowMap.bindTexture(RenderUniforms::SHADOW_TEXTURE_UNIT);
+    } else {
+        glBindFramebuffer(GL_FRAMEBUFFER, frame.targetFramebuffer);
+        glViewport(0, 0, frame.viewportWidth, frame.viewportHeight);
+    }
+
+    m_gpuProfiler.beginPass(GpuProfiler::PASS_OPAQUE);
+    glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    m_renderQueue.execute(m_uniforms, RenderQueue::LAYER_OPAQUE);
+    m_gpuProfiler.endPass();
+
+    m_gpuProfiler.beginPass(GpuProfiler::PASS_TRANSPARENT);
+    m_renderQueue.execute(m_uniforms, RenderQueue::LAYER_TRANSPARENT);
+    m_gpuProfiler.endPass();
+
+    m_uniforms.release();
+
+    // Un retour en arrière du temps (nouvelle partie) ne fait pas reculer les particules
+    const float deltaTime = qBound(0.0f, frame.time - m_previousTime, 0.1f);
+    m_previousTime = frame.time;
+    if (frame.bursts) {
+        m_juice.launch(*frame.bursts);
+    }
+    if (m_juice.isActive()) {
+        m_gpuProfiler.beginPass(GpuProfiler::PASS_PARTICLES);
+        m_juice.update(deltaTime, arenaCenter.y());
+        m_juice.draw(frame.view, frame.projection);
+        m_gpuProfiler.endPass();
+    }
+
+    m_projectileRenderer.endFrame();
+    m_stream.endFrame();
+    m_gpuProfiler.endFrame();
+}
+
+QMatrix4x4 SceneRenderer::swordModel(const QVector3D& handPosition) {
+    QMatrix4x4 model;
+
+    float angle = atan2(handPosition.z(), handPosition.x()) * 180.0f / M_PI;
+
+    model.translate(handPosition.x(), handPosition.y() - 0.3f, handPosition.z() + 2.5f);
+
+    model.rotate(angle, 0.0f, 1.0f, 0.0f);
+
+    model.scale(1.2f, 1.2f, 1.2f);
+
+    return model;
+}
+
+void SceneRenderer::buildSwordMesh() {
+    m_swordMesh = std::make_unique<Mesh>();
+    m_meshLibrary.upload(*m_swordMesh, MeshAsset::KIND_SWORD, 0);
+}
+
+void SceneRenderer::buildArenaMeshes() {
+    const float groundWidth = 8.0f;
+    const float wallHeight = 4.0f;
+    const float groundLevel = -m_cylinderHeight/2.0f - 0.3f;
+    const float roofLevel = groundLevel + wallHeight;
+    const float front = 2.5f + 1.0f;
+    const float back = -5.0f - 3.0f;
+
+    MeshData data;
+
+    // Triangles non indexés hérités des anciennes fonctions de dessin
+    auto appendTriangles = [&data](const float* vertices, int vertexCount) {
+        const size_t first = data.indices.size();
+        const GLuint base = GLuint(data.vertices.size() / MeshData::VERTEX_SIZE);
+        data.vertices.insert(data.vertices.end(), vertices, vertices + vertexCount * MeshData::VERTEX_SIZE);
+        for (int i = 0; i < vertexCount; ++i) {
+            data.indices.push_back(base + i);
+        }
+        data.closePart(first);
+    };
+
+    auto appendGrid = [&](float y, const QVector3D& normal) {
+        const size_t first = data.indices.size();
+        const float gridSpacing = 1.0f;
+        const float lineWidth = 0.01f;
+
+        for (float x = -groundWidth/2.0f; x <= groundWidth/2.0f; x += gridSpacing) {
+            data.indices.push_back(data.addVertex(QVector3D(x, y + lineWidth, front), normal));
+            data.indices.push_back(data.addVertex(QVector3D(x, y + lineWidth, back), normal));
+        }
+        for (float z = front; z >= back; z -= gridSpacing) {
+            data.indices.push_back(data.addVertex(QVector3D(-groundWidth/2.0f, y + lineWidth, z), normal));
+            data.indices.push_back(data.addVertex(QVector3D(groundWidth/2.0f, y + lineWidth, z), normal));
+        }
+        data.closePart(first, GL_LINES);
+    };
+
+    float groundVertices[] = {
+
+        -groundWidth/2.0f, groundLevel, 2.5f + 1.0f,      0.0f, 1.0f, 0.0f,     0.0f, 0.0f,   
+        groundWidth/2.0f, groundLevel, 2.5f + 1.0f,       0.0f, 1.0f, 0.0f,     4.0f, 0.0f,   
+        groundWidth/2.0f, groundLevel, -5.0f - 3.0f,      0.0f, 1.0f, 0.0f,     4.0f, 4.0f,   
+
+        groundWidth/2.0f, groundLevel, -5.0f - 3.0f,      0.0f, 1.0f, 0.0f,     4.0f, 4.0f,   
+        -groundWidth/2.0f, groundLevel, -5.0f - 3.0f,     0.0f, 1.0f, 0.0f,     0.0f, 4.0f,   
+        -groundWidth/2.0f, groundLevel, 2.5f + 1.0f,      0.0f, 1.0f, 0.0f,     0.0f, 0.0f    
+    };
+    appendTriangles(groundVertices, 6);
+    appendGrid(groundLevel, QVector3D(0.0f, 1.0f, 0.0f));
+
+    float wallVertices[] = {
+
+        -groundWidth / 2.0f, groundLevel, -5.0f - 3.0f,        0.0f, 0.0f, 1.0f,        0.0f, 0.0f,  
+         groundWidth / 2.0f, groundLevel, -5.0f - 3.0f,        0.0f, 0.0f, 1.0f,        1.0f, 0.0f,  
+         groundWidth / 2.0f, groundLevel + wallHeight, -5.0f - 3.0f,  0.0f, 0.0f, 1.0f,  1.0f, 1.0f,  
+
+         groundWidth / 2.0f, groundLevel + wallHeight, -5.0f - 3.0f,  0.0f, 0.0f, 1.0f,  1.0f, 1.0f,  
+        -groundWidth / 2.0f, groundLevel + wallHeight, -5.0f - 3.0f,  0.0f, 0.0f, 1.0f,  0.0f, 1.0f,  
+        -groundWidth / 2.0f, groundLevel, -5.0f - 3.0f,        0.0f, 0.0f, 1.0f,        0.0f, 0.0f,  
+
+        -groundWidth / 2.0f, groundLevel, 2.5f + 1.0f,         1.0f, 0.0f, 0.0f,        0.0f, 0.0f,  
+        -groundWidth / 2.0f, groundLevel, -5.0f - 3.0f,        1.0f, 0.0f, 0.0f,        1.0f, 0.0f,  
+        -groundWidth / 2.0f, groundLevel + wallHeight, -5.0f - 3.0f,   1.0f, 0.0f, 0.0f,   1.0f, 1.0f,  
+
+        -groundWidth / 2.0f, groundLevel + wallHeight, -5.0f - 3.0f,   1.0f, 0.0f, 0.0f,   1.0f, 1.0f,  
+        -groundWidth / 2.0f, groundLevel + wallHeight, 2.5f + 1.0f,    1.0f, 0.0f, 0.0f,    0.0f, 1.0f,  
+        -groundWidth / 2.0f, groundLevel, 2.5f + 1.0f,         1.0f, 0.0f, 0.0f,        0.0f, 0.0f,  
+
+         groundWidth / 2.0f, groundLevel, 2.5f + 1.0f,         -1.0f, 0.0f, 0.0f,        0.0f, 0.0f,  
+         groundWidth / 2.0f, groundLevel + wallHeight, -5.0f - 3.0f,   -1.0f, 0.0f, 0.0f,   1.0f, 1.0f,  
+         groundWidth / 2.0f, groundLevel, -5.0f - 3.0f,        -1.0f, 0.0f, 0.0f,        1.0f, 0.0f,  
+
+         groundWidth / 2.0f, groundLevel + wallHeight, -5.0f - 3.0f,   -1.0f, 0.0f, 0.0f,   1.0f, 1.0f,  
+         groundWidth / 2.0f, groundLevel, 2.5f + 1.0f,         -1.0f, 0.0f, 0.0f,        0.0f, 0.0f,  
+         groundWidth / 2.0f, groundLevel + wallHeight, 2.5f + 1.0f,    -1.0f, 0.0f, 0.0f,    0.0f, 1.0f   
+    };
+    appendTriangles(wallVertices, 6);
+    appendTriangles(wallVertices + 6 * MeshData::VERTEX_SIZE, 12);
+
+    float roofVertices[] = {
+
+        -groundWidth/2.0f, roofLevel, 2.5f+1.0f,        0.0f, -1.0f, 0.0f,    0.0f, 0.0f,   
+        -groundWidth/2.0f, roofLevel, -5.0f-3.0f,       0.0f, -1.0f, 0.0f,    0.0f, 4.0f,   
+        groundWidth/2.0f, roofLevel, -5.0f-3.0f,        0.0f, -1.0f, 0.0f,    4.0f, 4.0f,   
+
+        groundWidth/2.0f, roofLevel, -5.0f-3.0f,        0.0f, -1.0f, 0.0f,    4.0f, 4.0f,   
+        groundWidth/2.0f, roofLevel, 2.5f+1.0f,         0.0f, -1.0f, 0.0f,    4.0f, 0.0f,   
+        -groundWidth/2.0f, roofLevel, 2.5f+1.0f,        0.0f, -1.0f, 0.0f,    0.0f, 0.0f    
+    };
+    appendTriangles(roofVertices, 6);
+    appendGrid(roofLevel, QVector3D(0.0f, -1.0f, 0.0f));
+
+    const float skylightSize = groundWidth/4.0f;
+    const float skylightY = roofLevel + 0.05f;
+    const QVector3D down(0.0f, -1.0f, 0.0f);
+    size_t first = data.indices.size();
+    GLuint a = data.addVertex(QVector3D(-skylightSize, skylightY, -skylightSize), down);
+    GLuint b = data.addVertex(QVector3D(-skylightSize, skylightY, skylightSize - 5.0f), down);
+    GLuint c = data.addVertex(QVector3D(skylightSize, skylightY, skylightSize - 5.0f), down);
+    GLuint d = data.addVertex(QVector3D(skylightSize, skylightY, -skylightSize), down);
+    data.indices.insert(data.indices.end(), { a, b, c, c, d, a });
+    data.closePart(first);
+
+    // Contour de la zone de génération (boucle convertie en segments)
+    first = data.indices.size();
+    const QVector3D zoneNormal(0.0f, 0.0f, 1.0f);
+    const QVector3D zoneCorners[4] = {
+        QVector3D(-2.0f, -1.5f, -5.0f),
+        QVector3D(2.0f, -1.5f, -5.0f),
+        QVector3D(2.0f, 0.5f, -5.0f),
+        QVector3D(-2.0f, 0.5f, -5.0f)
+    };
+    const GLuint zoneBase = data.addVertex(zoneCorners[0], zoneNormal);
+    for (int i = 1; i < 4; ++i) {
+        data.addVertex(zoneCorners[i], zoneNormal);
+    }
+    for (GLuint i = 0; i < 4; ++i) {
+        data.indices.push_back(zoneBase + i);
+        data.indices.push_back(zoneBase + (i + 1) % 4);
+    }
+    data.closePart(first, GL_LINES);
+
+    // Cylindre de jeu : cercles bas et haut, et montants
+    first = data.indices.size();
+    constexpr int slices = 48;
+    constexpr const auto& circle = Trig::circle<slices>;
+    const float radius = m_cylinderRadius;
+    GLuint bottomBase = 0, topBase = 0;
+    for (int ring = 0; ring < 2; ++ring) {
+        const float y = ring == 0 ? groundLevel : roofLevel;
+        for (int i = 0; i < slices; ++i) {
+            QVector3D normal(circle.cos[i], 0.0f, circle.sin[i]);
+            GLuint index = data.addVertex(QVector3D(radius * normal.x(), y, radius * normal.z()), normal);
+            if (i == 0) {
+                (ring == 0 ? bottomBase : topBase) = index;
+            }
+        }
+    }
+    for (int i = 0; i < slices; ++i) {
+        GLuint next = (i + 1) % slices;
+        data.indices.insert(data.indices.end(), { bottomBase + i, bottomBase + next, topBase + i, topBase + next });
+    }
+    for (int i = 0; i < slices; i += 4) {
+        data.indices.push_back(bottomBase + i);
+        data.indices.push_back(topBase + i);
+    }
+    data.closePart(first, GL_LINES);
+
+    m_arenaMesh = std::make_unique<Mesh>();
+    data.optimizeVertexCache();
+    m_arenaMesh->upload(data);
+
+    const float lightRadius = 0.2f;
+    constexpr int lats = 16;
+    constexpr int longs = 16;
+    constexpr const auto& meridian = Trig::halfCircle<lats>;
+    constexpr const auto& parallel = Trig::circle<longs>;
+    MeshData light;
+    for (int i = 0; i <= lats; ++i) {
+        // Latitude de -pi/2 à pi/2 : cos(lat) = sin(pi * i / lats), sin(lat) = -cos(pi * i / lats)
+        const float cosLat = meridian.sin[i];
+        const float sinLat = -meridian.cos[i];
+        for (int j = 0; j <= longs; ++j) {
+            QVector3D normal(parallel.cos[j] * cosLat, parallel.sin[j] * cosLat, sinLat);
+            light.addVertex(normal * lightRadius, normal);
+        }
+    }
+    for (int i = 0; i < lats; ++i) {
+        for (int j = 0; j < longs; ++j) {
+            GLuint current = i * (longs + 1) + j;
+            GLuint above = current + longs + 1;
+            light.indices.insert(light.indices.end(), { current, current + 1, above, above, current + 1, above + 1 });
+        }
+    }
+    light.closePart(0);
+
+    m_lightMesh = std::make_unique<Mesh>();
+    light.optimizeVertexCache();
+    m_lightMesh->upload(light);
+}
+
+void SceneRenderer::submitArena(const QVector3D& lightPosition) {
+    const float groundLevel = -m_cylinderHeight/2.0f - 0.3f;
+    const float roofLevel = groundLevel + 4.0f;
+    Mesh* arena = m_arenaMesh.get();
+    const QMatrix4x4 identity;
+
+    auto layerFor = [](const DrawState& state) {
+        return (!state.texture && state.color.w() < 1.0f) ? RenderQueue::LAYER_TRANSPARENT
+                                                           : RenderQueue::LAYER_OPAQUE;
+    };
+    auto submitPart = [&](int part, const DrawState& state, const QVector3D& center) {
+        m_renderQueue.submit(layerFor(state), arena, part, identity, state, center);
+    };
+
+    DrawState lightState;
+    lightState.material = RenderUniforms::MATERIAL_UNLIT;
+    lightState.color = QVector4D(1.0f, 1.0f, 0.8f, 1.0f);
+    lightState.cullFace = false;
+    QMatrix4x4 lightModel;
+    lightModel.translate(lightPosition);
+    m_renderQueue.submit(RenderQueue::LAYER_OPAQUE, m_lightMesh.get(), 0, lightModel, lightState);
+
+    const QVector3D floorCenter(0.0f, groundLevel, -2.25f);
+    const QVector3D roofCenter(0.0f, roofLevel, -2.25f);
+
+    DrawState ground;
+    ground.material = RenderUniforms::MATERIAL_GROUND;
+    ground.texture = m_groundTexture;
+    ground.color = QVector4D(0.2f, 0.2f, 0.2f, 0.9f);
+    submitPart(ARENA_GROUND, ground, floorCenter);
+
+    ground.texture = nullptr;
+    ground.color = QVector4D(0.4f, 0.4f, 0.4f, 1.0f);
+    submitPart(ARENA_GROUND_GRID, ground, floorCenter);
+
+    const bool wallsTextured = m_wallTexture && m_backWallTexture;
+    DrawState walls;
+    walls.material = RenderUniforms::MATERIAL_WALL;
+    walls.texture = wallsTextured ? m_backWallTexture : nullptr;
+    walls.color = QVector4D(0.6f, 0.4f, 0.2f, 1.0f);
+    submitPart(ARENA_BACK_WALL, walls, QVector3D(0.0f, groundLevel + 2.0f, -8.0f));
+
+    walls.texture = wallsTextured ? m_wallTexture : nullptr;
+    walls.color = QVector4D(0.5f, 0.5f, 0.5f, 1.0f);
+    submitPart(ARENA_SIDE_WALLS, walls, QVector3D(0.0f, groundLevel + 2.0f, -2.25f));
+
+    DrawState roof;
+    roof.material = RenderUniforms::MATERIAL_ROOF;
+    roof.texture = m_roofTexture;
+    roof.color = QVector4D(0.3f, 0.4f, 0.5f, 0.8f);
+    submitPart(ARENA_ROOF, roof, roofCenter);
+
+    roof.texture = nullptr;
+    roof.color = QVector4D(0.5f, 0.6f, 0.7f, 0.9f);
+    submitPart(ARENA_ROOF_GRID, roof, roofCenter);
+
+    roof.color = QVector4D(0.1f, 0.6f, 0.8f, 0.6f);
+    submitPart(ARENA_SKYLIGHT, roof, QVector3D(0.0f, roofLevel + 0.05f, -3.0f));
+
+    DrawState zone;
+    zone.color = QVector4D(0.1f, 0.6f, 0.8f, 0.6f);
+    submitPart(ARENA_SPAWN_ZONE, zone, QVector3D(0.0f, -0.5f, -5.0f));
+
+    QMatrix4x4 cylinderModel;
+    cylinderModel.translate(0, -0.3f, 2.5f);
+    zone.color = QVector4D(0.2f, 0.7f, 1.0f, 0.4f);
+    m_renderQueue.submit(RenderQueue::LAYER_TRANSPARENT, arena, ARENA_CYLINDER, cylinderModel, zone,
+                       QVector3D(0.0f, 0.0f, 2.5f));
+}
+
+void SceneRenderer::submitSword(const QVector3D& handPosition) {
+    if (!m_swordMesh) return;
+
+    Mesh* sword = m_swordMesh.get();
+    const QMatrix4x4 model = swordModel(handPosition);
+
+    DrawState state;
+    state.material = RenderUniforms::MATERIAL_DEFAULT;
+
+    state.texture = m_bladeTexture;
+    state.color = QVector4D(0.8f, 0.8f, 0.9f, 1.0f);
+    m_renderQueue.submit(RenderQueue::LAYER_OPAQUE, sword, SWORD_BLADE, model, state);
+
+    state.texture = nullptr;
+    state.color = QVector4D(0.9f, 0.8f, 0.2f, 1.0f);
+    m_renderQueue.submit(RenderQueue::LAYER_OPAQUE, sword, SWORD_GUARD, model, state);
+
+    state.texture = m_handleTexture;
+    state.color = QVector4D(0.6f, 0.3f, 0.1f, 1.0f);
+    m_renderQueue.submit(RenderQueue::LAYER_OPAQUE, sword, SWORD_HANDLE, model, state);
+
+    state.cullFace = false;
+    for (int part = 0; part < sword->partCount(); ++part) {
+        m_renderQueue.submit(RenderQueue::LAYER_SHADOW, sword, part, model, state);
+    }
+}
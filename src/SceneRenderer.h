@@ -0,0 +1,203 @@
+/**
+ * @file SceneRenderer.h
+ * @brief Rendu de la scène (arène, épée, projectiles) indépendant du widget
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef SCENERENDERER_H
+#define SCENERENDERER_H
+
+#include <QOpenGLExtraFunctions>
+#include <QOpenGLTexture>
+#include <QFuture>
+#include <QMatrix4x4>
+#include <QVector3D>
+#include "Frustum.h"
+#include "GpuProfiler.h"
+#include "JuiceParticles.h"
+#include "Mesh.h"
+#include "MeshLibrary.h"
+#include "MeshUploadQueue.h"
+#include "Projectile.h"
+#include "ProjectileRenderer.h"
+#include "RenderQueue.h"
+#include "RenderUniforms.h"
+#include "ShaderLibrary.h"
+#include "ShadowMap.h"
+#include "StreamBuffer.h"
+#include "TextureLoader.h"
+#include <memory>
+#include <vector>
+
+/**
+ * @struct SceneFrame
+ * @brief Tout ce qui varie d'une image à l'autre : caméra, cible, temps et objets
+ */
+struct SceneFrame {
+    QMatrix4x4 view;                                          ///< Matrice de vue
+    QMatrix4x4 projection;                                    ///< Matrice de projection
+    QVector3D eye;                                            ///< Position de la caméra
+    float fieldOfView = 45.0f;                                ///< Angle vertical de la projection (degrés)
+    GLuint targetFramebuffer = 0;                             ///< Framebuffer de destination
+    int viewportWidth = 0;                                    ///< Largeur de la cible en pixels physiques
+    int viewportHeight = 0;                                   ///< Hauteur de la cible en pixels physiques
+    float time = 0.0f;                                        ///< Temps de jeu affiché (animation de la lumière)
+    float interpolation = 1.0f;                               ///< Position entre les deux derniers pas simulés
+    bool showSword = false;                                   ///< Indique si l'épée est tracée
+    QVector3D handPosition;                                   ///< Position de la main (épée)
+    const std::vector<Projectile::State>* projectiles = nullptr; ///< Projectiles à tracer
+    const std::vector<JuiceBurst>* bursts = nullptr;          ///< Découpes récentes (gerbes de jus)
+};
+
+/**
+ * @class SceneRenderer
+ * @brief Ressources OpenGL et passes de rendu de la scène du jeu
+ *
+ * Regroupe ce que paintGL faisait directement : maillages statiques, textures,
+ * carte d'ombre, file de rendu triée, projectiles et mesures GPU. Le widget ne
+ * fournit plus que la caméra, la cible et l'état publié par la simulation, ce
+ * qui permet de rendre exactement la même scène hors écran (render_benchmark).
+ */
+class SceneRenderer : protected QOpenGLExtraFunctions {
+public:
+    /**
+     * @brief Constructeur
+     * @param cylinderRadius Rayon du cylindre parcouru par l'épée
+     * @param cylinderHeight Hauteur du cylindre parcouru par l'épée
+     */
+    SceneRenderer(float cylinderRadius, float cylinderHeight);
+
+    SceneRenderer(const SceneRenderer&) = delete;
+    SceneRenderer& operator=(const SceneRenderer&) = delete;
+
+    /**
+     * @brief Lance le décodage de toutes les textures sur le pool de QtConcurrent
+     *
+     * À appeler au plus tôt, avant que le contexte OpenGL n'existe.
+     */
+    void prefetchTextures();
+
+    /**
+     * @brief Crée les shaders, la carte d'ombre, les maillages statiques et les textures (contexte courant requis)
+     *
+     * N'attend que la fin des décodages de l'arène et de l'épée, nécessaires à la première image.
+     */
+    void initialize();
+
+    /**
+     * @brief Libère toutes les ressources OpenGL (contexte courant requis)
+     */
+    void destroy();
+
+    /**
+     * @brief Démarre une image : libère les maillages détruits et envoie ceux des fragments
+     * @param uploads File alimentée par la simulation
+     *
+     * L'état des projectiles doit être lu avant cet appel : tout fragment qu'il
+     * contient a alors déjà déposé ses maillages.
+     */
+    void beginFrame(MeshUploadQueue& uploads);
+
+    /**
+     * @brief Trace la scène et termine l'image
+     * @param frame Caméra, cible, temps et projectiles de l'image
+     */
+    void render(const SceneFrame& frame);
+
+    const CullingStats& cullingStats() const { return m_cullingStats; }
+    const RenderQueue::Stats& queueStats() const { return m_renderQueue.stats(); }
+
+    /**
+     * @brief Octets envoyés au GPU depuis le début (maillages, tampon circulaire et uniformes)
+     */
+    quint64 uploadedBytes() const {
+        return Mesh::uploadedBytes() + m_stream.writtenBytes() + m_uniforms.uploadedBytes();
+    }
+
+    const StreamBuffer& streamBuffer() const { return m_stream; }
+
+    const GpuProfiler& profiler() const { return m_gpuProfiler; }
+
+private:
+    /// Plages d'indices du maillage de l'épée
+    enum SwordPart { SWORD_BLADE = 0, SWORD_GUARD, SWORD_HANDLE };
+
+    /// Plages d'indices du maillage de l'arène
+    enum ArenaPart {
+        ARENA_GROUND = 0, ARENA_GROUND_GRID, ARENA_BACK_WALL, ARENA_SIDE_WALLS,
+        ARENA_ROOF, ARENA_ROOF_GRID, ARENA_SKYLIGHT, ARENA_SPAWN_ZONE, ARENA_CYLINDER
+    };
+
+    /**
+     * @struct PendingTexture
+     * @brief Texture en cours de décodage, envoyée par initialize()
+     */
+    struct PendingTexture {
+        QFuture<TextureLoader::Decoded> decoded;
+        QOpenGLTexture** target;
+        const char* name;
+    };
+
+    /**
+     * @brief Lance le décodage d'une texture sur le pool de QtConcurrent
+     * @param target Texture à créer une fois le décodage terminé
+     * @param path Image source
+     * @param name Nom utilisé dans les messages d'erreur
+     */
+    void decodeTextureAsync(QOpenGLTexture** target, const QString& path, const char* name);
+
+    /**
+     * @brief Envoie le maillage de l'épée (lame, garde, poignée), précalculé ou généré
+     */
+    void buildSwordMesh();
+
+    /**
+     * @brief Matrice de modèle de l'épée à la position de la main
+     */
+    static QMatrix4x4 swordModel(const QVector3D& handPosition);
+
+    /**
+     * @brief Ajoute les tracés de l'épée (couleur et ombre) à la file de rendu
+     */
+    void submitSword(const QVector3D& handPosition);
+
+    /**
+     * @brief Construit les maillages statiques de l'arène et de la source de lumière
+     */
+    void buildArenaMeshes();
+
+    /**
+     * @brief Ajoute les tracés de l'arène et de la source de lumière à la file de rendu
+     * @param lightPosition Position courante de la lumière
+     */
+    void submitArena(const QVector3D& lightPosition);
+
+    float m_cylinderRadius;                         ///< Rayon du cylindre (épée)
+    float m_cylinderHeight;                         ///< Hauteur du cylindre (épée)
+
+    MeshLibrary m_meshLibrary;                      ///< Maillages précalculés projetés en mémoire
+    ShaderLibrary m_shaders;                        ///< Variantes spécialisées du shader de la scène
+    StreamBuffer m_stream;                          ///< Données dynamiques de l'image (triple tampon)
+    RenderUniforms m_uniforms;                      ///< Blocs uniformes de l'image et emplacements mis en cache
+    ShadowMap m_shadowMap;                          ///< Carte d'ombre rendue depuis la lumière
+    std::unique_ptr<Mesh> m_swordMesh;              ///< Géométrie de l'épée, construite une seule fois
+    std::unique_ptr<Mesh> m_arenaMesh;              ///< Sol, murs, plafond, zone de génération et cylindre
+    std::unique_ptr<Mesh> m_lightMesh;              ///< Sphère représentant la source de lumière
+    RenderQueue m_renderQueue;                      ///< Tracés de l'image, triés par clé
+    ProjectileRenderer m_projectileRenderer;        ///< Maillages, textures et niveaux de détail des projectiles
+    CullingStats m_cullingStats;                    ///< Projectiles tracés et écartés sur la dernière image
+    GpuProfiler m_gpuProfiler;                      ///< Temps GPU des passes et temps CPU des images
+    JuiceParticles m_juice;                         ///< Gerbes de jus simulées sur le GPU
+    float m_previousTime = 0.0f;                    ///< Temps de l'image précédente (pas des particules)
+
+    std::vector<PendingTexture> m_pendingTextures;  ///< Décodages lancés par prefetchTextures()
+    QOpenGLTexture* m_bladeTexture = nullptr;       ///< Texture pour la lame de l'épée
+    QOpenGLTexture* m_handleTexture = nullptr;      ///< Texture pour la poignée de l'épée
+    QOpenGLTexture* m_groundTexture = nullptr;      ///< Texture pour le sol
+    QOpenGLTexture* m_wallTexture = nullptr;        ///< Texture pour les murs
+    QOpenGLTexture* m_backWallTexture = nullptr;    ///< Texture pour le mur du fond
+    QOpenGLTexture* m_roofTexture = nullptr;        ///< Texture pour le plafond
+};
+
+#endif
@@ -0,0 +1,210 @@
+#include "ShaderLibrary.h"
+#include <QDebug>
+#include <QElapsedTimer>
+
+namespace {
+
+const char* VERTEX_SOURCE = R"(
+layout(location = 0) in vec3 position;
+layout(location = 1) in vec3 normal;
+layout(location = 2) in vec2 texCoord;
+
+layout(std140) uniform FrameBlock {
+    mat4 viewMatrix;
+    mat4 viewProjection;
+    mat4 lightViewProjection;
+    vec4 lightPosition;
+    vec4 lightColor;
+};
+
+uniform mat4 modelMatrix;
+
+#if defined(DEPTH_ONLY)
+void main() {
+    gl_Position = lightViewProjection * modelMatrix * vec4(position, 1.0);
+}
+#else
+out vec2 vTexCoord;
+out vec3 vNormal;
+out vec3 vPosition;
+out vec3 vViewPosition;
+out vec4 vLightSpace;
+
+void main() {
+    vec4 worldPosition = modelMatrix * vec4(position, 1.0);
+    gl_Position = viewProjection * worldPosition;
+    vLightSpace = lightViewProjection * worldPosition;
+    vTexCoord = texCoord;
+    // Échelles uniformes pour les objets éclairés : mat3(modelMatrix) suffit
+    vNormal = normalize(mat3(modelMatrix) * normal);
+    vPosition = worldPosition.xyz;
+    vViewPosition = vec3(viewMatrix * worldPosition);
+}
+#endif
+)";
+
+const char* FRAGMENT_SOURCE = R"(
+in vec2 vTexCoord;
+in vec3 vNormal;
+in vec3 vPosition;
+in vec3 vViewPosition;
+in vec4 vLightSpace;
+
+out vec4 fragColor;
+
+layout(std140) uniform FrameBlock {
+    mat4 viewMatrix;
+    mat4 viewProjection;
+    mat4 lightViewProjection;
+    vec4 lightPosition;
+    vec4 lightColor;
+};
+
+// x : ambiante, y : spéculaire, z : brillance
+layout(std140) uniform MaterialBlock {
+    vec4 materials[6];
+};
+
+uniform int materialIndex;
+uniform vec4 color;
+uniform sampler2D appleTexture;
+uniform vec4 cutSurfaceColor;
+
+#if defined(USE_LIGHTING)
+uniform sampler2DShadow shadowMap;
+
+// Filtrage PCF 3x3 ; hors de la carte d'ombre, la surface est éclairée
+float shadowFactor(vec3 normal, vec3 lightDir) {
+    vec3 coords = vLightSpace.xyz / vLightSpace.w * 0.5 + 0.5;
+    if (coords.z > 1.0 || any(lessThan(coords.xy, vec2(0.0))) || any(greaterThan(coords.xy, vec2(1.0)))) {
+        return 1.0;
+    }
+
+    float bias = max(0.004 * (1.0 - dot(normal, lightDir)), 0.001);
+    vec2 texel = 1.0 / vec2(textureSize(shadowMap, 0));
+    float lit = 0.0;
+    for (int x = -1; x <= 1; ++x) {
+        for (int y = -1; y <= 1; ++y) {
+            lit += texture(shadowMap, vec3(coords.xy + vec2(x, y) * texel, coords.z - bias));
+        }
+    }
+    return lit / 9.0;
+}
+#endif
+
+void main() {
+#if defined(USE_TEXTURE)
+    vec4 baseColor = texture(appleTexture, vTexCoord);
+#elif defined(IS_FRAGMENT)
+    vec4 baseColor = gl_FrontFacing ? color : cutSurfaceColor;
+#else
+    vec4 baseColor = color;
+#endif
+
+#if defined(USE_LIGHTING)
+    vec4 material = materials[materialIndex];
+    vec3 normal = normalize(vNormal);
+
+    vec3 ambient = material.x * lightColor.rgb;
+
+    vec3 lightDir = normalize(lightPosition.xyz - vPosition);
+    float diff = max(dot(normal, lightDir), 0.0);
+    vec3 diffuse = diff * lightColor.rgb;
+
+    vec3 viewDir = normalize(-vViewPosition);
+    vec3 halfwayDir = normalize(lightDir + viewDir);
+    float spec = pow(max(dot(normal, halfwayDir), 0.0), material.z);
+    vec3 specular = material.y * spec * lightColor.rgb;
+
+    float shadow = shadowFactor(normal, lightDir);
+    fragColor = vec4((ambient + shadow * (diffuse + specular)) * baseColor.rgb, baseColor.a);
+#else
+    fragColor = baseColor;
+#endif
+}
+)";
+
+const char* DEPTH_FRAGMENT_SOURCE = R"(
+void main() {
+}
+)";
+
+QByteArray header(int flags) {
+    QByteArray source("#version 330 core\n");
+    if (flags & ShaderLibrary::USE_TEXTURE) source += "#define USE_TEXTURE\n";
+    if (flags & ShaderLibrary::USE_LIGHTING) source += "#define USE_LIGHTING\n";
+    if (flags & ShaderLibrary::IS_FRAGMENT) source += "#define IS_FRAGMENT\n";
+    return source;
+}
+
+}
+
+ShaderLibrary::~ShaderLibrary() {
+    for (QOpenGLShaderProgram* program : m_programs) {
+        delete program;
+    }
+    delete m_depthProgram;
+}
+
+int ShaderLibrary::normalize(int flags) {
+    return (flags & USE_TEXTURE) ? (flags & ~IS_FRAGMENT) : flags;
+}
+
+bool ShaderLibrary::initialize() {
+    QElapsedTimer timer;
+    timer.start();
+
+    bool ok = true;
+    for (int flags = 0; flags < VARIANT_COUNT; ++flags) {
+        if (normalize(flags) != flags) {
+            continue;
+        }
+        m_programs[flags] = build(flags);
+        ok = ok && m_programs[flags];
+    }
+
+    m_depthProgram = buildDepth();
+    ok = ok && m_depthProgram;
+
+    qDebug() << "Shader variants ready in" << timer.elapsed() << "ms";
+    return ok;
+}
+
+void ShaderLibrary::destroy() {
+    for (QOpenGLShaderProgram*& program : m_programs) {
+        delete program;
+        program = nullptr;
+    }
+    delete m_depthProgram;
+    m_depthProgram = nullptr;
+}
+
+QOpenGLShaderProgram* ShaderLibrary::build(int flags) {
+    auto* program = new QOpenGLShaderProgram;
+    const QByteArray defines = header(flags);
+
+    program->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, defines + VERTEX_SOURCE);
+    program->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, defines + FRAGMENT_SOURCE);
+
+    if (!program->link()) {
+        qWarning() << "Shader variant" << flags << "failed to link:" << program->log();
+        delete program;
+        return nullptr;
+    }
+    return program;
+}
+
+QOpenGLShaderProgram* ShaderLibrary::buildDepth() {
+    auto* program = new QOpenGLShaderProgram;
+    const QByteArray defines("#version 330 core\n#define DEPTH_ONLY\n");
+
+    program->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, defines + VERTEX_SOURCE);
+    program->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, defines + DEPTH_FRAGMENT_SOURCE);
+
+    if (!program->link()) {
+        qWarning() << "Depth shader failed to link:" << program->log();
+        delete program;
+        return nullptr;
+    }
+    return program;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file ShaderLibrary.h
+ * @brief Variantes spécialisées du shader de la scène
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef SHADERLIBRARY_H
+#define SHADERLIBRARY_H
+
+#include <QOpenGLShaderProgram>
+#include <array>
+
+/**
+ * @class ShaderLibrary
+ * @brief Compile une variante du shader par combinaison d'options
+ *
+ * Les options (texture, éclairage, surface de coupe des fragments) sont
+ * injectées sous forme de #define au lieu d'être testées dans le fragment
+ * shader : chaque variante est sans branchement. Les sources sont ajoutées avec
+ * addCacheableShaderFromSourceCode, ce qui permet à Qt de conserver les binaires
+ * liés sur disque et de les recharger directement aux lancements suivants.
+ *
+ * Un programme supplémentaire, réduit à la transformation des sommets, sert à
+ * la passe de profondeur de la carte d'ombre.
+ */
+class ShaderLibrary {
+public:
+    /**
+     * @brief Options de compilation d'une variante
+     */
+    enum Flag {
+        USE_TEXTURE = 0x1,   ///< Couleur lue dans la texture
+        USE_LIGHTING = 0x2,  ///< Éclairage de Blinn-Phong
+        IS_FRAGMENT = 0x4    ///< Faces arrière colorées comme surface de coupe
+    };
+
+    static constexpr int VARIANT_COUNT = 8;
+
+    ShaderLibrary() = default;
+    ~ShaderLibrary();
+
+    ShaderLibrary(const ShaderLibrary&) = delete;
+    ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+
+    /**
+     * @brief Compile et lie toutes les variantes utiles
+     * @return true si toutes les variantes ont été liées
+     *
+     * Doit être appelée avec le contexte OpenGL courant.
+     */
+    bool initialize();
+
+    /**
+     * @brief Libère les programmes (contexte courant requis)
+     */
+    void destroy();
+
+    /**
+     * @brief Ramène une combinaison d'options à la variante équivalente
+     * @param flags Combinaison d'options
+     * @return Options réellement distinctes (la texture rend IS_FRAGMENT inutile)
+     */
+    static int normalize(int flags);
+
+    /**
+     * @brief Programme correspondant à une combinaison d'options
+     * @param flags Combinaison d'options
+     * @return Programme lié, ou nullptr si la compilation a échoué
+     */
+    QOpenGLShaderProgram* program(int flags) const { return m_programs[normalize(flags)]; }
+
+    /**
+     * @brief Programme de la passe de profondeur (carte d'ombre)
+     */
+    QOpenGLShaderProgram* depthProgram() const { return m_depthProgram; }
+
+private:
+    QOpenGLShaderProgram* build(int flags);
+    QOpenGLShaderProgram* buildDepth();
+
+    std::array<QOpenGLShaderProgram*, VARIANT_COUNT> m_programs{};
+    QOpenGLShaderProgram* m_depthProgram = nullptr;
+};
+
+#endif
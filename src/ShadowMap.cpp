@@ -0,0 +1,86 @@
+#include "ShadowMap.h"
+#include <QDebug>
+
+bool ShadowMap::initialize(int size) {
+    initializeOpenGLFunctions();
+    destroy();
+
+    m_size = size;
+
+    glGenTextures(1, &m_depthTexture);
+    glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, size, size, 0, GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    GLint previousFramebuffer = 0;
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+
+    glGenFramebuffers(1, &m_framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, m_depthTexture, 0);
+    glDrawBuffers(0, nullptr);
+    glReadBuffer(GL_NONE);
+
+    const bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, GLuint(previousFramebuffer));
+
+    if (!complete) {
+        qWarning("Shadow map framebuffer is incomplete");
+        destroy();
+        return false;
+    }
+    return true;
+}
+
+void ShadowMap::destroy() {
+    if (m_framebuffer) {
+        glDeleteFramebuffers(1, &m_framebuffer);
+        m_framebuffer = 0;
+    }
+    if (m_depthTexture) {
+        glDeleteTextures(1, &m_depthTexture);
+        m_depthTexture = 0;
+    }
+}
+
+const QMatrix4x4& ShadowMap::update(const QVector3D& lightPosition, const QVector3D& target) {
+    // La lumière reste au-dessus de l'arène : l'axe -Z ne peut pas être colinéaire à sa direction
+    QMatrix4x4 lightView;
+    lightView.lookAt(lightPosition, target, QVector3D(0.0f, 0.0f, -1.0f));
+
+    const float distance = (target - lightPosition).length();
+    QMatrix4x4 lightProjection;
+    lightProjection.ortho(-SCENE_EXTENT, SCENE_EXTENT, -SCENE_EXTENT, SCENE_EXTENT,
+                          0.1f, distance + SCENE_EXTENT);
+
+    m_lightViewProjection = lightProjection * lightView;
+    return m_lightViewProjection;
+}
+
+void ShadowMap::begin() {
+    glBindFramebuffer(GL_FRAMEBUFFER, m_framebuffer);
+    glViewport(0, 0, m_size, m_size);
+    glClear(GL_DEPTH_BUFFER_BIT);
+
+    // Évite l'acné d'ombre sur les surfaces tournées vers la lumière
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(2.0f, 4.0f);
+}
+
+void ShadowMap::end(GLuint targetFramebuffer, int viewportWidth, int viewportHeight) {
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glBindFramebuffer(GL_FRAMEBUFFER, targetFramebuffer);
+    glViewport(0, 0, viewportWidth, viewportHeight);
+}
+
+void ShadowMap::bindTexture(GLuint unit) {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, m_depthTexture);
+    glActiveTexture(GL_TEXTURE0);
+}
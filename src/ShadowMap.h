@@ -0,0 +1,85 @@
+/**
+ * @file ShadowMap.h
+ * @brief Carte d'ombre rendue depuis la lumière animée
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef SHADOWMAP_H
+#define SHADOWMAP_H
+
+#include <QOpenGLExtraFunctions>
+#include <QMatrix4x4>
+#include <QVector3D>
+
+/**
+ * @class ShadowMap
+ * @brief Texture de profondeur et framebuffer de la passe d'ombre
+ *
+ * Les objets qui projettent une ombre (épée, projectiles) sont tracés une fois
+ * par image dans cette texture, vue depuis la lumière avec une projection
+ * orthogonale couvrant l'arène. Les variantes éclairées du shader la lisent
+ * ensuite avec une comparaison matérielle (sampler2DShadow) et un filtrage PCF.
+ */
+class ShadowMap : protected QOpenGLExtraFunctions {
+public:
+    static constexpr int DEFAULT_SIZE = 2048;         ///< Résolution de la carte
+    static constexpr float SCENE_EXTENT = 7.5f;       ///< Demi-largeur couverte par la projection
+
+    ShadowMap() = default;
+    ~ShadowMap() = default;
+
+    ShadowMap(const ShadowMap&) = delete;
+    ShadowMap& operator=(const ShadowMap&) = delete;
+
+    /**
+     * @brief Crée la texture de profondeur et le framebuffer (contexte courant requis)
+     * @param size Résolution de la carte
+     * @return true si le framebuffer est complet
+     */
+    bool initialize(int size = DEFAULT_SIZE);
+
+    /**
+     * @brief Libère la texture et le framebuffer (contexte courant requis)
+     */
+    void destroy();
+
+    /**
+     * @brief Calcule la projection de la carte pour la position courante de la lumière
+     * @param lightPosition Position de la lumière
+     * @param target Centre de la zone couverte
+     * @return Matrice projection * vue de la lumière
+     */
+    const QMatrix4x4& update(const QVector3D& lightPosition, const QVector3D& target);
+
+    /**
+     * @brief Lie le framebuffer d'ombre et efface la profondeur
+     */
+    void begin();
+
+    /**
+     * @brief Rétablit le framebuffer et la zone d'affichage de la scène
+     * @param targetFramebuffer Framebuffer de destination (celui du widget)
+     * @param viewportWidth Largeur en pixels physiques
+     * @param viewportHeight Hauteur en pixels physiques
+     */
+    void end(GLuint targetFramebuffer, int viewportWidth, int viewportHeight);
+
+    /**
+     * @brief Lie la texture de profondeur sur une unité de texture
+     * @param unit Unité de texture
+     */
+    void bindTexture(GLuint unit);
+
+    bool isValid() const { return m_framebuffer != 0; }
+    int size() const { return m_size; }
+    const QMatrix4x4& lightViewProjection() const { return m_lightViewProjection; }
+
+private:
+    GLuint m_framebuffer = 0;
+    GLuint m_depthTexture = 0;
+    int m_size = 0;
+    QMatrix4x4 m_lightViewProjection;
+};
+
+#endif
@@ -0,0 +1,96 @@
+#include "SkinDetector.h"
+#include <algorithm>
+
+namespace {
+
+// Modèle générique de peau en YCrCb (Chai & Ngan), utilisé tant que la cascade
+// n'a pas confirmé de main
+const cv::Scalar DEFAULT_LOWER(40, 133, 77);
+const cv::Scalar DEFAULT_UPPER(255, 173, 127);
+
+// Limites que le modèle adapté ne peut pas dépasser
+const cv::Scalar LIMIT_LOWER(20, 120, 60);
+const cv::Scalar LIMIT_UPPER(255, 185, 140);
+
+const double MIN_HALF_WIDTH = 6.0;
+
+}
+
+SkinDetector::SkinDetector() {
+    reset();
+    m_kernel = cv::getStructuringElement(cv::MORPH_ELLIPSE, cv::Size(3, 3));
+}
+
+void SkinDetector::configure(const cv::Size& size) {
+    m_ycrcb.create(size, CV_8UC3);
+    m_mask.create(size, CV_8UC1);
+    m_labels.create(size, CV_32S);
+    m_sample.create(size, CV_8UC3);
+}
+
+bool SkinDetector::detect(const cv::Mat& bgr, cv::Point2f& center, cv::Rect& box) {
+    cv::cvtColor(bgr, m_ycrcb, cv::COLOR_BGR2YCrCb);
+    cv::inRange(m_ycrcb, m_lower, m_upper, m_mask);
+    cv::morphologyEx(m_mask, m_mask, cv::MORPH_OPEN, m_kernel);
+
+    int count = cv::connectedComponentsWithStats(m_mask, m_labels, m_stats, m_centroids, 8, CV_32S);
+
+    int best = 0;
+    int bestArea = MIN_BLOB_AREA - 1;
+    for (int label = 1; label < count; ++label) {
+        int area = m_stats.at<int>(label, cv::CC_STAT_AREA);
+        if (area > bestArea) {
+            bestArea = area;
+            best = label;
+        }
+    }
+
+    if (best == 0) {
+        return false;
+    }
+
+    center = cv::Point2f(float(m_centroids.at<double>(best, 0)), float(m_centroids.at<double>(best, 1)));
+    box = cv::Rect(m_stats.at<int>(best, cv::CC_STAT_LEFT), m_stats.at<int>(best, cv::CC_STAT_TOP),
+                   m_stats.at<int>(best, cv::CC_STAT_WIDTH), m_stats.at<int>(best, cv::CC_STAT_HEIGHT));
+    return true;
+}
+
+void SkinDetector::adapt(const cv::Mat& bgr, const cv::Rect& region) {
+    cv::Rect core(region.x + region.width / 4, region.y + region.height / 4,
+                  region.width / 2, region.height / 2);
+    core &= cv::Rect(0, 0, bgr.cols, bgr.rows);
+    if (core.empty()) {
+        return;
+    }
+
+    // En-tête sur le tampon préalloué : la taille correspond, cvtColor n'alloue rien
+    if (m_sample.rows < bgr.rows || m_sample.cols < bgr.cols) {
+        m_sample.create(bgr.size(), CV_8UC3);
+    }
+    cv::Mat sample = m_sample(core);
+    cv::cvtColor(bgr(core), sample, cv::COLOR_BGR2YCrCb);
+
+    cv::Scalar mean, stddev;
+    cv::meanStdDev(sample, mean, stddev);
+
+    const double rate = m_adapted ? ADAPT_RATE : 1.0;
+    for (int c = 1; c < 3; ++c) {
+        double halfWidth = std::max(SPREAD * stddev[c], MIN_HALF_WIDTH);
+        double lower = std::clamp(mean[c] - halfWidth, LIMIT_LOWER[c], LIMIT_UPPER[c]);
+        double upper = std::clamp(mean[c] + halfWidth, LIMIT_LOWER[c], LIMIT_UPPER[c]);
+
+        m_lower[c] += rate * (lower - m_lower[c]);
+        m_upper[c] += rate * (upper - m_upper[c]);
+    }
+
+    double minLuma = std::max(LIMIT_LOWER[0], mean[0] - SPREAD * stddev[0]);
+    m_lower[0] += rate * (std::min(minLuma, DEFAULT_LOWER[0]) - m_lower[0]);
+
+    m_adapted = true;
+}
+
+void SkinDetector::reset() {
+    m_lower = DEFAULT_LOWER;
+    m_upper = DEFAULT_UPPER;
+    m_adapted = false;
+}
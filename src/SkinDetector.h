@@ -0,0 +1,84 @@
+/**
+ * @file SkinDetector.h
+ * @brief Localisation rapide de la main par segmentation de la couleur de peau
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef SKINDETECTOR_H
+#define SKINDETECTOR_H
+
+#include <opencv2/opencv.hpp>
+
+/**
+ * @class SkinDetector
+ * @brief Détecteur de main par seuillage YCrCb et plus grande composante connexe
+ *
+ * L'image est convertie en YCrCb puis seuillée (cvtColor et inRange sont
+ * vectorisés par OpenCV). Le masque est nettoyé par une ouverture morphologique,
+ * puis la plus grande composante connexe donne la position de la main.
+ *
+ * Les bornes Cr/Cb partent d'un modèle de peau générique et sont ajustées à
+ * partir des régions confirmées par la cascade de Haar (adapt()), ce qui rend
+ * le détecteur robuste à l'éclairage et à la couleur de peau du joueur.
+ *
+ * Les tampons sont dimensionnés par configure(), hors de VisionBufferPool. Seuls
+ * m_stats et m_centroids échappent à cette préallocation : connectedComponentsWithStats
+ * les recrée dès que le nombre de composantes change.
+ */
+class SkinDetector {
+public:
+    static constexpr int MIN_BLOB_AREA = 150;   ///< Surface minimale (en pixels) d'une main
+    static constexpr double ADAPT_RATE = 0.3;   ///< Poids d'une nouvelle observation dans le modèle
+    static constexpr double SPREAD = 2.5;       ///< Demi-largeur des bornes, en écarts-types
+
+    SkinDetector();
+
+    /**
+     * @brief Dimensionne les tampons internes
+     * @param size Taille des images analysées
+     */
+    void configure(const cv::Size& size);
+
+    /**
+     * @brief Cherche la main dans une image BGR
+     * @param bgr Image BGR (typiquement l'aperçu réduit)
+     * @param center Centre de la plus grande zone de peau
+     * @param box Rectangle englobant de cette zone
+     * @return true si une zone de peau assez grande a été trouvée
+     */
+    bool detect(const cv::Mat& bgr, cv::Point2f& center, cv::Rect& box);
+
+    /**
+     * @brief Ajuste le modèle de couleur à partir d'une main confirmée
+     * @param bgr Image BGR analysée
+     * @param region Région où la cascade a trouvé la paume
+     *
+     * Seul le centre de la région est échantillonné pour éviter le fond ; il est
+     * converti dans une sous-matrice de m_sample, sans allocation.
+     */
+    void adapt(const cv::Mat& bgr, const cv::Rect& region);
+
+    /**
+     * @brief Revient au modèle de peau générique
+     */
+    void reset();
+
+    bool isAdapted() const { return m_adapted; }
+    const cv::Mat& mask() const { return m_mask; }
+
+private:
+    cv::Scalar m_lower;     ///< Bornes basses Y, Cr, Cb
+    cv::Scalar m_upper;     ///< Bornes hautes Y, Cr, Cb
+    bool m_adapted = false;
+
+    cv::Mat m_ycrcb;
+    cv::Mat m_mask;
+    cv::Mat m_labels;
+    cv::Mat m_stats;        ///< Recréée par OpenCV à chaque changement du nombre de composantes
+    cv::Mat m_centroids;    ///< Idem
+    cv::Mat m_sample;       ///< Échantillon YCrCb de adapt(), à la taille de l'image
+    cv::Mat m_kernel;
+};
+
+#endif
@@ -0,0 +1,34 @@
+#include "SliceJobs.h"
+#include <QThread>
+#include <algorithm>
+
+SliceJobs::SliceJobs(MeshUploadQueue* uploads)
+    : m_uploads(uploads)
+{
+    // La moitié des cœurs : la simulation, le rendu et la webcam gardent les leurs
+    m_pool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+    m_pool.setObjectName("SliceJobs");
+}
+
+SliceJobs::~SliceJobs() {
+    waitForDone();
+}
+
+void SliceJobs::submit(const Projectile::State& state) {
+    m_uploads->expect(state.id);
+
+    MeshUploadQueue* uploads = m_uploads;
+    m_pool.start([uploads, state]() {
+        MeshUploadRequest request;
+        request.ownerId = state.id;
+        request.levels.reserve(Projectile::LOD_COUNT);
+        for (int lod = 0; lod < Projectile::LOD_COUNT; ++lod) {
+            request.levels.push_back(PackedMeshData::pack(Projectile::buildFragmentMeshData(state, lod)));
+        }
+        uploads->post(std::move(request));
+    });
+}
+
+void SliceJobs::waitForDone() {
+    m_pool.waitForDone();
+}
@@ -0,0 +1,59 @@
+/**
+ * @file SliceJobs.h
+ * @brief Découpe des fragments en tâches de fond
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef SLICEJOBS_H
+#define SLICEJOBS_H
+
+#include <QThreadPool>
+#include "MeshUploadQueue.h"
+#include "Projectile.h"
+
+/**
+ * @class SliceJobs
+ * @brief Construit les maillages des fragments sur un groupe de threads dédié
+ *
+ * Chaque tâche découpe les LOD_COUNT niveaux d'un fragment, les compacte et les
+ * dépose dans la file d'envoi, où le rendu les reprend à l'image suivante. La
+ * demande est annoncée à la file dès la soumission : le rendu attend la tâche
+ * au lieu de refaire la découpe. Les threads ont chacun leur arène de découpe
+ * (MeshSlicer::Arena), réutilisée d'une tâche à l'autre.
+ *
+ * Le groupe est séparé du groupe global, occupé par le traitement de la webcam.
+ */
+class SliceJobs {
+public:
+    /**
+     * @brief Constructeur
+     * @param uploads File d'envoi des maillages (doit survivre aux tâches)
+     */
+    explicit SliceJobs(MeshUploadQueue* uploads);
+
+    /**
+     * @brief Destructeur : attend la fin des tâches en cours
+     */
+    ~SliceJobs();
+
+    SliceJobs(const SliceJobs&) = delete;
+    SliceJobs& operator=(const SliceJobs&) = delete;
+
+    /**
+     * @brief Lance la construction des maillages d'un fragment (n'importe quel thread)
+     * @param state État du fragment (type, plan et côté de coupe)
+     */
+    void submit(const Projectile::State& state);
+
+    /**
+     * @brief Attend la fin de toutes les tâches soumises
+     */
+    void waitForDone();
+
+private:
+    MeshUploadQueue* m_uploads;   ///< Destination des maillages construits
+    QThreadPool m_pool;           ///< Threads de découpe
+};
+
+#endif
@@ -0,0 +1,19 @@
+#include "StartupTimer.h"
+#include <QDebug>
+
+QElapsedTimer& StartupTimer::clock() {
+    static QElapsedTimer timer;
+    return timer;
+}
+
+void StartupTimer::start() {
+    clock().start();
+}
+
+double StartupTimer::elapsedMs() {
+    return clock().isValid() ? clock().nsecsElapsed() / 1e6 : 0.0;
+}
+
+void StartupTimer::mark(const char* stage) {
+    qDebug().noquote() << "Startup:" << stage << "after" << QString::number(elapsedMs(), 'f', 1) << "ms";
+}
@@ -0,0 +1,43 @@
+/**
+ * @file StartupTimer.h
+ * @brief Chronométrage des étapes du démarrage jusqu'à la première image
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef STARTUPTIMER_H
+#define STARTUPTIMER_H
+
+#include <QElapsedTimer>
+
+/**
+ * @class StartupTimer
+ * @brief Horloge unique du démarrage, lisible depuis n'importe quel thread
+ *
+ * start() est appelé au tout début de main(), avant la création des threads ;
+ * chaque étape du graphe de démarrage (caméra, cascade, textures, première
+ * image) journalise ensuite le temps écoulé depuis ce point.
+ */
+class StartupTimer {
+public:
+    /**
+     * @brief Démarre l'horloge (une seule fois, au début de main())
+     */
+    static void start();
+
+    /**
+     * @brief Temps écoulé depuis start(), en millisecondes
+     */
+    static double elapsedMs();
+
+    /**
+     * @brief Journalise la fin d'une étape du démarrage
+     * @param stage Nom de l'étape
+     */
+    static void mark(const char* stage);
+
+private:
+    static QElapsedTimer& clock();
+};
+
+#endif
@@ -0,0 +1,148 @@
+#include "StreamBuffer.h"
+#include <QOpenGLContext>
+#include <QDebug>
+#include <algorithm>
+#include <cstring>
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+namespace {
+
+typedef void (QOPENGLF_APIENTRYP BufferStorage)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+
+// glBufferStorage n'est pas exposé par QOpenGLExtraFunctions (contexte 3.3)
+BufferStorage resolveBufferStorage() {
+    QOpenGLContext* context = QOpenGLContext::currentContext();
+    if (!context || context->isOpenGLES()) return nullptr;
+    if (context->format().version() < qMakePair(4, 4) && !context->hasExtension("GL_ARB_buffer_storage")) return nullptr;
+    return reinterpret_cast<BufferStorage>(context->getProcAddress("glBufferStorage"));
+}
+
+}
+
+bool StreamBuffer::initialize(GLsizeiptr regionSize) {
+    initializeOpenGLFunctions();
+
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &m_uniformAlignment);
+    m_uniformAlignment = std::max(m_uniformAlignment, 4);
+
+    // Régions alignées pour que le début de chacune convienne à tout usage
+    m_regionSize = (regionSize + m_uniformAlignment - 1) / m_uniformAlignment * m_uniformAlignment;
+    const GLsizeiptr totalSize = m_regionSize * FRAME_COUNT;
+
+    glGenBuffers(1, &m_buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+
+    if (BufferStorage bufferStorage = resolveBufferStorage()) {
+        const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        bufferStorage(GL_COPY_WRITE_BUFFER, totalSize, nullptr, flags);
+        m_mapped = static_cast<char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, totalSize, flags));
+        if (!m_mapped) {
+            // Stockage immuable : impossible de revenir à glBufferData sur ce tampon
+            glDeleteBuffers(1, &m_buffer);
+            glGenBuffers(1, &m_buffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+        }
+    }
+    if (!m_mapped) {
+        glBufferData(GL_COPY_WRITE_BUFFER, totalSize, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    m_region = 0;
+    m_used = 0;
+    qDebug() << "Stream buffer:" << FRAME_COUNT << "x" << m_regionSize << "bytes,"
+             << (m_mapped ? "persistently mapped" : "mapped per write");
+    return true;
+}
+
+void StreamBuffer::destroy() {
+    if (!m_buffer) return;
+
+    for (GLsync& fence : m_fences) {
+        if (fence) {
+            glDeleteSync(fence);
+            fence = nullptr;
+        }
+    }
+    if (m_mapped) {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        m_mapped = nullptr;
+    }
+    glDeleteBuffers(1, &m_buffer);
+    m_buffer = 0;
+}
+
+void StreamBuffer::beginFrame() {
+    if (!m_buffer) return;
+
+    m_region = (m_region + 1) % FRAME_COUNT;
+    m_used = 0;
+    waitForRegion(m_region);
+}
+
+void StreamBuffer::endFrame() {
+    if (!m_buffer) return;
+
+    if (m_fences[m_region]) {
+        glDeleteSync(m_fences[m_region]);
+    }
+    m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+void StreamBuffer::waitForRegion(int region) {
+    GLsync& fence = m_fences[region];
+    if (!fence) return;
+
+    // Le premier essai n'attend pas : avec trois régions, la barrière est presque toujours passée
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        m_stalls++;
+        do {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+        } while (status == GL_TIMEOUT_EXPIRED);
+    }
+    if (status == GL_WAIT_FAILED) {
+        qWarning("Stream buffer fence wait failed");
+    }
+
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+GLintptr StreamBuffer::write(const void* data, GLsizeiptr size, GLsizeiptr alignment) {
+    if (!m_buffer) return -1;
+
+    const GLsizeiptr offset = (m_used + alignment - 1) / alignment * alignment;
+    if (offset + size > m_regionSize) {
+        m_overflows++;
+        return -1;
+    }
+
+    const GLintptr position = m_region * m_regionSize + offset;
+    if (m_mapped) {
+        std::memcpy(m_mapped + position, data, size_t(size));
+    } else {
+        glBindBuffer(GL_COPY_WRITE_BUFFER, m_buffer);
+        void* target = glMapBufferRange(GL_COPY_WRITE_BUFFER, position, size,
+                                        GL_MAP_WRITE_BIT | GL_MAP_UNSYNCHRONIZED_BIT | GL_MAP_INVALIDATE_RANGE_BIT);
+        if (!target) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            return -1;
+        }
+        std::memcpy(target, data, size_t(size));
+        glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+
+    m_used = offset + size;
+    m_writtenBytes += quint64(size);
+    return position;
+}
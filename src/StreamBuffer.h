@@ -0,0 +1,96 @@
+/**
+ * @file StreamBuffer.h
+ * @brief Tampon circulaire pour les données envoyées au GPU à chaque image
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef STREAMBUFFER_H
+#define STREAMBUFFER_H
+
+#include <QOpenGLExtraFunctions>
+#include <array>
+
+/**
+ * @class StreamBuffer
+ * @brief Un seul tampon découpé en FRAME_COUNT régions, une par image en vol
+ *
+ * Chaque image écrit ses données dynamiques (blocs uniformes, futures données
+ * d'instance) les unes à la suite des autres dans sa région, puis pose une
+ * barrière (glFenceSync) en fin d'image. La région n'est réécrite que
+ * FRAME_COUNT images plus tard, après attente de cette barrière : le GPU a
+ * alors fini de la lire, ce qui permet d'écrire sans aucune synchronisation
+ * implicite du pilote ni réallocation du stockage.
+ *
+ * Si le contexte offre glBufferStorage (OpenGL 4.4 ou GL_ARB_buffer_storage),
+ * le tampon est projeté une fois pour toutes (persistant et cohérent) ; sinon
+ * chaque écriture projette sa plage avec GL_MAP_UNSYNCHRONIZED_BIT et
+ * GL_MAP_INVALIDATE_RANGE_BIT, la barrière tenant lieu de synchronisation.
+ */
+class StreamBuffer : protected QOpenGLExtraFunctions {
+public:
+    static constexpr int FRAME_COUNT = 3;                       ///< Images pouvant être en vol (triple tampon)
+    static constexpr GLsizeiptr DEFAULT_REGION_SIZE = 256 * 1024; ///< Octets disponibles par image
+
+    StreamBuffer() = default;
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    /**
+     * @brief Crée le tampon (contexte courant requis)
+     * @param regionSize Octets disponibles pour une image
+     * @return true si le tampon est utilisable
+     */
+    bool initialize(GLsizeiptr regionSize = DEFAULT_REGION_SIZE);
+
+    /**
+     * @brief Libère le tampon et les barrières (contexte courant requis)
+     */
+    void destroy();
+
+    /**
+     * @brief Passe à la région suivante, après que le GPU a fini de la lire
+     */
+    void beginFrame();
+
+    /**
+     * @brief Pose la barrière qui protège la région de l'image courante
+     */
+    void endFrame();
+
+    /**
+     * @brief Copie des données dans la région de l'image courante
+     * @param data Données à copier
+     * @param size Taille en octets
+     * @param alignment Alignement exigé pour le décalage (ex. GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT)
+     * @return Décalage des données dans buffer(), ou -1 si la région est pleine
+     */
+    GLintptr write(const void* data, GLsizeiptr size, GLsizeiptr alignment = 4);
+
+    bool isValid() const { return m_buffer != 0; }
+    bool isPersistent() const { return m_mapped != nullptr; }
+    GLuint buffer() const { return m_buffer; }
+    GLint uniformAlignment() const { return m_uniformAlignment; }
+
+    quint64 writtenBytes() const { return m_writtenBytes; }   ///< Octets écrits depuis la création
+    int stalls() const { return m_stalls; }                   ///< Attentes d'une région encore lue par le GPU
+    int overflows() const { return m_overflows; }             ///< Écritures refusées faute de place
+
+private:
+    void waitForRegion(int region);
+
+    GLuint m_buffer = 0;
+    GLsizeiptr m_regionSize = 0;
+    GLint m_uniformAlignment = 256;
+    char* m_mapped = nullptr;                                 ///< Projection persistante (nullptr : projection à chaque écriture)
+    std::array<GLsync, FRAME_COUNT> m_fences{};               ///< Fin de lecture de chaque région
+    int m_region = 0;                                         ///< Région de l'image courante
+    GLsizeiptr m_used = 0;                                    ///< Octets déjà écrits dans cette région
+
+    quint64 m_writtenBytes = 0;
+    int m_stalls = 0;
+    int m_overflows = 0;
+};
+
+#endif
@@ -0,0 +1,127 @@
+#include "TextureLoader.h"
+#include "KtxFormat.h"
+#include <QCoreApplication>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QOpenGLContext>
+#include <QDebug>
+#include <cstring>
+
+QString TextureLoader::bakedDirectory() {
+    return QCoreApplication::applicationDirPath() + "/textures";
+}
+
+TextureLoader::Decoded TextureLoader::decode(const QString& sourcePath) {
+    Decoded decoded;
+    decoded.sourcePath = sourcePath;
+
+    const QString bakedPath = bakedDirectory() + "/" + QFileInfo(sourcePath).completeBaseName() + ".ktx";
+    if (QFile::exists(bakedPath)) {
+        auto file = std::make_shared<QFile>(bakedPath);
+        if (file->open(QIODevice::ReadOnly)) {
+            decoded.bakedSize = file->size();
+            decoded.bakedData = file->map(0, decoded.bakedSize);
+            if (decoded.bakedData) {
+                decoded.bakedFile = file;
+                return decoded;
+            }
+        }
+        qWarning() << "Cannot map baked texture" << bakedPath;
+    }
+
+    decoded.image = decodeSource(sourcePath);
+    return decoded;
+}
+
+QOpenGLTexture* TextureLoader::upload(const Decoded& decoded) {
+    QOpenGLTexture* texture = nullptr;
+    if (decoded.bakedData) {
+        texture = uploadBaked(decoded);
+    }
+    if (!texture) {
+        // Fichier précalculé absent ou refusé : l'image source n'a peut-être pas encore été décodée
+        const QImage image = decoded.image.isNull() ? decodeSource(decoded.sourcePath) : decoded.image;
+        if (!image.isNull()) {
+            texture = new QOpenGLTexture(image);
+        }
+    }
+    if (!texture) return nullptr;
+
+    texture->setMinificationFilter(QOpenGLTexture::LinearMipMapLinear);
+    texture->setMagnificationFilter(QOpenGLTexture::Linear);
+    texture->setWrapMode(QOpenGLTexture::Repeat);
+    return texture;
+}
+
+QImage TextureLoader::decodeSource(const QString& path) {
+    QImage image(path);
+    if (image.isNull()) return image;
+    return image.flipped();
+}
+
+QOpenGLTexture* TextureLoader::uploadBaked(const Decoded& decoded) {
+    const uchar* data = decoded.bakedData;
+    const qint64 fileSize = decoded.bakedSize;
+    const QString& path = decoded.bakedFile->fileName();
+    if (fileSize < qint64(sizeof(Ktx::Header))) {
+        qWarning() << "Truncated baked texture" << path;
+        return nullptr;
+    }
+
+    Ktx::Header header;
+    std::memcpy(&header, data, sizeof(header));
+
+    const bool compressed = header.glInternalFormat == Ktx::GL_INTERNAL_BC1_RGB;
+    if (std::memcmp(header.identifier, Ktx::IDENTIFIER, sizeof(Ktx::IDENTIFIER)) != 0
+        || header.endianness != Ktx::ENDIANNESS
+        || (!compressed && header.glInternalFormat != Ktx::GL_INTERNAL_RGBA8)
+        || header.pixelWidth == 0 || header.pixelHeight == 0
+        || header.numberOfMipmapLevels == 0 || header.numberOfFaces != 1) {
+        qWarning() << "Unsupported baked texture" << path;
+        return nullptr;
+    }
+
+    if (compressed && !QOpenGLContext::currentContext()->hasExtension("GL_EXT_texture_compression_s3tc")) {
+        qWarning() << "BC1 textures unsupported, decoding source image instead of" << path;
+        return nullptr;
+    }
+
+    QOpenGLTexture* texture = new QOpenGLTexture(QOpenGLTexture::Target2D);
+    texture->setAutoMipMapGenerationEnabled(false);
+    texture->setFormat(compressed ? QOpenGLTexture::RGB_DXT1 : QOpenGLTexture::RGBA8_UNorm);
+    texture->setSize(int(header.pixelWidth), int(header.pixelHeight));
+    texture->setMipLevels(int(header.numberOfMipmapLevels));
+    texture->allocateStorage();
+
+    // Chaque niveau est envoyé directement depuis la projection du fichier
+    qint64 offset = qint64(sizeof(header)) + header.bytesOfKeyValueData;
+    quint32 width = header.pixelWidth;
+    quint32 height = header.pixelHeight;
+
+    for (quint32 level = 0; level < header.numberOfMipmapLevels; ++level) {
+        quint32 imageSize = 0;
+        if (offset + qint64(sizeof(imageSize)) <= fileSize) {
+            std::memcpy(&imageSize, data + offset, sizeof(imageSize));
+        }
+        offset += sizeof(imageSize);
+
+        if (imageSize < Ktx::levelSize(header.glInternalFormat, width, height) || offset + imageSize > fileSize) {
+            qWarning() << "Truncated baked texture" << path << "at level" << level;
+            delete texture;
+            return nullptr;
+        }
+
+        if (compressed) {
+            texture->setCompressedData(int(level), int(imageSize), data + offset);
+        } else {
+            texture->setData(int(level), QOpenGLTexture::RGBA, QOpenGLTexture::UInt8, data + offset);
+        }
+
+        offset += (imageSize + 3) & ~quint32(3);
+        width = std::max(1u, width / 2);
+        height = std::max(1u, height / 2);
+    }
+
+    return texture;
+}
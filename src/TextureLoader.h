@@ -0,0 +1,73 @@
+/**
+ * @file TextureLoader.h
+ * @brief Chargement des textures précalculées (KTX projeté en mémoire) ou des images sources
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef TEXTURELOADER_H
+#define TEXTURELOADER_H
+
+#include <QFile>
+#include <QImage>
+#include <QOpenGLTexture>
+#include <QString>
+#include <memory>
+
+/**
+ * @class TextureLoader
+ * @brief Crée les textures du jeu à partir des fichiers produits par texture_baker
+ *
+ * Pour une image source « .../floor_texture.jpg », le loader cherche d'abord
+ * « textures/floor_texture.ktx » à côté de l'exécutable. Ce fichier est projeté
+ * en mémoire et sa chaîne de mipmaps, déjà retournée et éventuellement
+ * compressée en BC1, est envoyée telle quelle : ni décodage JPEG, ni copie,
+ * ni génération de mipmaps au démarrage. Sans fichier précalculé (ou si le
+ * format n'est pas pris en charge), l'image source est décodée comme avant.
+ *
+ * Le chargement se fait en deux temps : decode() (fichiers, décodage) peut
+ * s'exécuter sur n'importe quel thread, upload() doit être appelée avec le
+ * contexte OpenGL courant.
+ */
+class TextureLoader {
+public:
+    /**
+     * @struct Decoded
+     * @brief Texture prête à être envoyée : fichier KTX projeté, ou image source retournée
+     */
+    struct Decoded {
+        QString sourcePath;                  ///< Image source, décodée en secours si besoin
+        std::shared_ptr<QFile> bakedFile;    ///< Fichier KTX ouvert (garde la projection valide)
+        const uchar* bakedData = nullptr;    ///< Début de la projection, nullptr sans fichier précalculé
+        qint64 bakedSize = 0;
+        QImage image;                        ///< Image source retournée (sans fichier précalculé)
+    };
+
+    /**
+     * @brief Projette le fichier précalculé ou décode l'image source (tout thread)
+     * @param sourcePath Chemin de l'image source (ressource Qt)
+     */
+    static Decoded decode(const QString& sourcePath);
+
+    /**
+     * @brief Crée une texture répétée et filtrée trilinéairement (contexte courant requis)
+     * @return Texture créée, nullptr en cas d'échec
+     */
+    static QOpenGLTexture* upload(const Decoded& decoded);
+
+    /**
+     * @brief decode() puis upload(), sur le thread OpenGL
+     */
+    static QOpenGLTexture* load(const QString& sourcePath) { return upload(decode(sourcePath)); }
+
+    /**
+     * @brief Répertoire des textures précalculées
+     */
+    static QString bakedDirectory();
+
+private:
+    static QOpenGLTexture* uploadBaked(const Decoded& decoded);
+    static QImage decodeSource(const QString& path);
+};
+
+#endif
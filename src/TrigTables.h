@@ -0,0 +1,133 @@
+/**
+ * @file TrigTables.h
+ * @brief Tables de sinus et cosinus calculées à la compilation pour la génération des maillages
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef TRIGTABLES_H
+#define TRIGTABLES_H
+
+#include <array>
+
+/**
+ * @namespace Trig
+ * @brief Sinus et cosinus constexpr, et tables d'arcs paramétrées par leur nombre de segments
+ *
+ * Les générateurs de maillages parcourent toujours les mêmes angles : cercles
+ * de 8 à 48 segments, méridiens, courbure de la banane. Chaque table est une
+ * variable constexpr instanciée pour un nombre de segments donné : ses valeurs
+ * sont calculées par le compilateur et rangées dans le binaire, et les boucles
+ * de génération n'appellent plus std::sin ni std::cos.
+ */
+namespace Trig {
+
+constexpr double PI = 3.14159265358979323846;
+
+namespace detail {
+
+// Série de Taylor sur [-pi/2, pi/2], précise au double près
+constexpr double sinSeries(double x) {
+    const double x2 = x * x;
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 12; ++n) {
+        term *= -x2 / double((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+}
+
+/**
+ * @brief Sinus évaluable à la compilation
+ */
+constexpr double sin(double x) {
+    // Réduction à [-pi, pi], puis à [-pi/2, pi/2] par sin(pi - x) = sin(x)
+    const double turns = x / (2.0 * PI);
+    const long long whole = (long long)(turns >= 0.0 ? turns + 0.5 : turns - 0.5);
+    x -= double(whole) * 2.0 * PI;
+    if (x > PI / 2.0) x = PI - x;
+    if (x < -PI / 2.0) x = -PI - x;
+    return detail::sinSeries(x);
+}
+
+/**
+ * @brief Cosinus évaluable à la compilation
+ */
+constexpr double cos(double x) {
+    return sin(x + PI / 2.0);
+}
+
+/**
+ * @struct Arc
+ * @brief Sinus et cosinus de SEGMENTS + 1 angles régulièrement répartis de 0 à pi * SPAN_NUM / SPAN_DEN
+ *
+ * Le dernier angle est inclus : un anneau fermé de sommets (coordonnée de
+ * texture 0 et 1 sur la couture) s'écrit avec un seul indice de boucle.
+ */
+template <int SEGMENTS, int SPAN_NUM, int SPAN_DEN>
+struct Arc {
+    static_assert(SEGMENTS > 0, "an arc needs at least one segment");
+
+    std::array<float, SEGMENTS + 1> cos{};
+    std::array<float, SEGMENTS + 1> sin{};
+
+    static constexpr int segments() { return SEGMENTS; }
+
+    /**
+     * @brief Angle du sommet index (radians)
+     */
+    static constexpr double angle(int index) {
+        return PI * SPAN_NUM / SPAN_DEN * index / SEGMENTS;
+    }
+};
+
+/**
+ * @brief Remplit une table d'arc (évaluée à la compilation)
+ */
+template <int SEGMENTS, int SPAN_NUM, int SPAN_DEN>
+constexpr Arc<SEGMENTS, SPAN_NUM, SPAN_DEN> makeArc() {
+    Arc<SEGMENTS, SPAN_NUM, SPAN_DEN> arc;
+    for (int i = 0; i <= SEGMENTS; ++i) {
+        const double angle = Arc<SEGMENTS, SPAN_NUM, SPAN_DEN>::angle(i);
+        arc.cos[i] = float(Trig::cos(angle));
+        arc.sin[i] = float(Trig::sin(angle));
+    }
+    // Fermeture exacte : le sommet de couture coïncide avec le premier
+    if (SPAN_NUM == 2 * SPAN_DEN) {
+        arc.cos[SEGMENTS] = arc.cos[0];
+        arc.sin[SEGMENTS] = arc.sin[0];
+    }
+    return arc;
+}
+
+/// Arc de 0 à pi * SPAN_NUM / SPAN_DEN, une seule instance par paramètres dans le binaire
+template <int SEGMENTS, int SPAN_NUM, int SPAN_DEN>
+inline constexpr Arc<SEGMENTS, SPAN_NUM, SPAN_DEN> arc = makeArc<SEGMENTS, SPAN_NUM, SPAN_DEN>();
+
+/// Cercle complet (0 à 2 pi) : anneaux des fruits, cylindre de l'arène
+template <int SEGMENTS>
+inline constexpr const Arc<SEGMENTS, 2, 1>& circle = arc<SEGMENTS, 2, 1>;
+
+/// Demi-cercle (0 à pi) : méridiens des sphères, profils en sin(t * pi)
+template <int SEGMENTS>
+inline constexpr const Arc<SEGMENTS, 1, 1>& halfCircle = arc<SEGMENTS, 1, 1>;
+
+/**
+ * @brief Échantillonne une fonction constexpr en SEGMENTS + 1 points de [0, 1]
+ * @param function Fonction de t dans [0, 1]
+ */
+template <int SEGMENTS, typename Function>
+constexpr std::array<float, SEGMENTS + 1> sample(Function function) {
+    std::array<float, SEGMENTS + 1> values{};
+    for (int i = 0; i <= SEGMENTS; ++i) {
+        values[i] = float(function(double(i) / SEGMENTS));
+    }
+    return values;
+}
+
+}
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * @file TripleBuffer.h
+ * @brief Triple tampon sans verrou entre un producteur et un consommateur
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef TRIPLEBUFFER_H
+#define TRIPLEBUFFER_H
+
+#include <array>
+#include <atomic>
+
+/**
+ * @class TripleBuffer
+ * @brief Échange d'états complets entre deux threads sans verrou ni copie
+ *
+ * Le producteur écrit dans son tampon puis le publie ; le consommateur lit
+ * toujours la dernière publication complète. Le tampon intermédiaire est
+ * échangé atomiquement, si bien qu'aucun des deux threads n'attend l'autre et
+ * que les tampons (et leurs allocations) sont réutilisés d'une image à l'autre.
+ *
+ * @tparam T Type de l'état échangé
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    /**
+     * @brief Tampon en cours d'écriture (thread producteur uniquement)
+     */
+    T& writeBuffer() { return m_buffers[m_writeIndex]; }
+
+    /**
+     * @brief Publie le tampon écrit et récupère un tampon libre (thread producteur uniquement)
+     */
+    void publish() {
+        const int previous = m_middle.exchange(m_writeIndex | FRESH_BIT, std::memory_order_acq_rel);
+        m_writeIndex = previous & INDEX_MASK;
+    }
+
+    /**
+     * @brief Dernier état publié (thread consommateur uniquement)
+     *
+     * Reste valide et inchangé jusqu'au prochain appel.
+     */
+    const T& readBuffer() {
+        if (m_middle.load(std::memory_order_acquire) & FRESH_BIT) {
+            const int previous = m_middle.exchange(m_readIndex, std::memory_order_acq_rel);
+            m_readIndex = previous & INDEX_MASK;
+        }
+        return m_buffers[m_readIndex];
+    }
+
+private:
+    static constexpr int INDEX_MASK = 0x3;   ///< Indice du tampon intermédiaire
+    static constexpr int FRESH_BIT = 0x4;    ///< Publication pas encore lue
+
+    std::array<T, 3> m_buffers;
+    int m_writeIndex = 0;                    ///< Propriété du producteur
+    std::atomic<int> m_middle{ 1 };          ///< Tampon échangé entre les deux threads
+    int m_readIndex = 2;                     ///< Propriété du consommateur
+};
+
+#endif
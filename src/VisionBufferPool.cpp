@@ -0,0 +1,94 @@
+#include "VisionBufferPool.h"
+
+void VisionBufferPool::configure(const cv::Size& frameSize, const QSize& previewSize,
+                                 int detectionScale, int maxFeatures) {
+    m_frameSize = frameSize;
+
+    m_gray.create(frameSize, CV_8UC1);
+    if (detectionScale > 0) {
+        cv::Size detectionSize(frameSize.width / detectionScale, frameSize.height / detectionScale);
+        m_smallGray.create(detectionSize, CV_8UC1);
+        m_detection.create(detectionSize, CV_8UC1);
+    }
+    m_descriptors.create(maxFeatures, 32, CV_8U);
+
+    m_detections.reserve(MAX_DETECTIONS);
+    m_keypoints.reserve(maxFeatures);
+    m_matches.reserve(maxFeatures);
+    m_goodMatches.reserve(maxFeatures);
+    m_levelKeypoints.reserve(maxFeatures);
+
+    // Taille reçue telle quelle : la recalculer ici peut différer d'un pixel de celle du prétraitement
+    for (QImage& preview : m_previews) {
+        preview = previewSize.isEmpty() ? QImage() : QImage(previewSize, QImage::Format_BGR888);
+    }
+    m_nextPreview = 0;
+
+    m_configured = true;
+    m_pendingAllocations = 0;
+    m_states = captureStates();
+}
+
+void VisionBufferPool::beginFrame() {
+    m_pendingAllocations = 0;
+    m_states = captureStates();
+}
+
+void VisionBufferPool::endFrame() {
+    BufferStates current = captureStates();
+
+    int allocations = m_pendingAllocations;
+    for (int i = 0; i < TRACKED_BUFFERS; ++i) {
+        if (current[i].data && (current[i].data != m_states[i].data || current[i].capacity > m_states[i].capacity)) {
+            allocations++;
+        }
+    }
+
+    m_states = current;
+    m_pendingAllocations = 0;
+
+    m_allocationsLastFrame = allocations;
+    m_allocationCount += allocations;
+    m_frameCount++;
+}
+
+QImage& VisionBufferPool::acquirePreview() {
+    for (int i = 0; i < PREVIEW_SLOTS; ++i) {
+        int slot = (m_nextPreview + i) % PREVIEW_SLOTS;
+        if (m_previews[slot].isDetached()) {
+            m_nextPreview = (slot + 1) % PREVIEW_SLOTS;
+            return m_previews[slot];
+        }
+    }
+
+    QImage& preview = m_previews[m_nextPreview];
+    preview = QImage(preview.size(), preview.format());
+    m_pendingAllocations++;
+
+    m_nextPreview = (m_nextPreview + 1) % PREVIEW_SLOTS;
+    return preview;
+}
+
+cv::Mat VisionBufferPool::previewMat(QImage& image) const {
+    return cv::Mat(image.height(), image.width(), CV_8UC3, image.bits(), image.bytesPerLine());
+}
+
+VisionBufferPool::BufferStates VisionBufferPool::captureStates() const {
+    BufferStates states = {{
+        { m_frame.datastart, size_t(m_frame.dataend - m_frame.datastart) },
+        { m_gray.datastart, size_t(m_gray.dataend - m_gray.datastart) },
+        { m_smallGray.datastart, size_t(m_smallGray.dataend - m_smallGray.datastart) },
+        { m_detection.datastart, size_t(m_detection.dataend - m_detection.datastart) },
+        { m_descriptors.datastart, size_t(m_descriptors.dataend - m_descriptors.datastart) },
+        { m_detections.data(), m_detections.capacity() },
+        { m_keypoints.data(), m_keypoints.capacity() },
+        { m_matches.data(), m_matches.capacity() },
+        { m_goodMatches.data(), m_goodMatches.capacity() },
+        { m_levelKeypoints.data(), m_levelKeypoints.capacity() }
+    }};
+    for (int i = 0; i < MAX_LEVELS; ++i) {
+        const cv::Mat& level = m_levelDescriptors[i];
+        states[10 + i] = { level.datastart, size_t(level.dataend - level.datastart) };
+    }
+    return states;
+}
@@ -0,0 +1,141 @@
+/**
+ * @file VisionBufferPool.h
+ * @brief Tampons préalloués et réutilisables pour la chaîne de vision
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef VISIONBUFFERPOOL_H
+#define VISIONBUFFERPOOL_H
+
+#include <QImage>
+#include <QSize>
+#include <opencv2/opencv.hpp>
+#include <array>
+#include <atomic>
+#include <vector>
+
+/**
+ * @class VisionBufferPool
+ * @brief Réserve de tampons réutilisés d'une image à l'autre
+ *
+ * Les images intermédiaires (niveaux de gris, image de détection réduite),
+ * les points caractéristiques, les descripteurs, les correspondances et les
+ * images d'aperçu sont dimensionnés une seule fois par configure(). En régime établi, la boucle de capture
+ * n'effectue plus d'allocation sur le tas : les compteurs d'allocation,
+ * mis à jour entre beginFrame() et endFrame(), permettent de le vérifier.
+ *
+ * Les sorties de cv::ORB par niveau sont aussi suivies : ORB recrée la matrice de
+ * descripteurs dès que le nombre de points du niveau change, ce que les compteurs
+ * font apparaître (une matrice par niveau, pour qu'un nombre stable ne coûte rien).
+ * Les allocations internes d'OpenCV (cascade, recherche FLANN) restent hors de la réserve,
+ * comme les statistiques de composantes de SkinDetector.
+ */
+class VisionBufferPool {
+public:
+    static constexpr int PREVIEW_SLOTS = 3;     ///< Nombre d'images d'aperçu en rotation
+    static constexpr int MAX_FEATURES = 500;    ///< Nombre maximal de points ORB (valeur par défaut d'ORB)
+    static constexpr int MAX_DETECTIONS = 64;   ///< Nombre maximal de détections réservées
+    static constexpr int MAX_LEVELS = 8;        ///< Niveaux de pyramide ayant leurs propres sorties ORB
+
+    /**
+     * @brief Dimensionne tous les tampons pour une taille d'image donnée
+     * @param frameSize Taille des images de la caméra
+     * @param previewSize Taille exacte de l'aperçu, celle de l'image réduite du prétraitement (vide pour ne pas en créer)
+     * @param detectionScale Facteur de réduction de l'image de détection (0 pour ne pas en créer)
+     * @param maxFeatures Nombre maximal de points caractéristiques attendus
+     *
+     * Les allocations faites ici ne sont pas comptabilisées.
+     */
+    void configure(const cv::Size& frameSize, const QSize& previewSize,
+                   int detectionScale = 0, int maxFeatures = MAX_FEATURES);
+
+    /**
+     * @brief Indique si les tampons sont dimensionnés pour cette taille d'image
+     * @param frameSize Taille des images de la caméra
+     * @return true si configure() a déjà été appelée avec cette taille
+     */
+    bool isConfiguredFor(const cv::Size& frameSize) const { return m_configured && frameSize == m_frameSize; }
+
+    /**
+     * @brief Mémorise l'état des tampons au début du traitement d'une image
+     */
+    void beginFrame();
+
+    /**
+     * @brief Compte les tampons réalloués depuis beginFrame()
+     */
+    void endFrame();
+
+    /**
+     * @brief Renvoie une image d'aperçu qui n'est plus partagée
+     * @return Image d'aperçu réutilisable
+     *
+     * Les images émises par signal restent partagées tant que l'interface ne les
+     * a pas relâchées ; on prend alors l'emplacement suivant. Une allocation n'a lieu
+     * (et n'est comptée) que si tous les emplacements sont encore utilisés.
+     */
+    QImage& acquirePreview();
+
+    /**
+     * @brief Construit une matrice OpenCV qui partage la mémoire d'une image d'aperçu
+     * @param image Image d'aperçu obtenue par acquirePreview()
+     * @return En-tête cv::Mat (BGR) pointant sur les pixels de l'image
+     */
+    cv::Mat previewMat(QImage& image) const;
+
+    cv::Mat& frame() { return m_frame; }
+    cv::Mat& gray() { return m_gray; }
+    cv::Mat& smallGray() { return m_smallGray; }
+    cv::Mat& detection() { return m_detection; }
+    cv::Mat& descriptors() { return m_descriptors; }
+    std::vector<cv::Rect>& detections() { return m_detections; }
+    std::vector<cv::KeyPoint>& keypoints() { return m_keypoints; }
+    std::vector<cv::DMatch>& matches() { return m_matches; }
+    std::vector<cv::DMatch>& goodMatches() { return m_goodMatches; }
+    std::vector<cv::KeyPoint>& levelKeypoints() { return m_levelKeypoints; }
+    cv::Mat& levelDescriptors(int level) { return m_levelDescriptors[level]; }
+
+    quint64 frameCount() const { return m_frameCount.load(); }
+    quint64 allocationCount() const { return m_allocationCount.load(); }
+    int allocationsLastFrame() const { return m_allocationsLastFrame.load(); }
+
+private:
+    /// État d'un tampon : adresse de ses données et capacité
+    struct BufferState {
+        const void* data = nullptr;
+        size_t capacity = 0;
+    };
+
+    static constexpr int TRACKED_BUFFERS = 10 + MAX_LEVELS;
+    using BufferStates = std::array<BufferState, TRACKED_BUFFERS>;
+
+    BufferStates captureStates() const;
+
+    cv::Mat m_frame;
+    cv::Mat m_gray;
+    cv::Mat m_smallGray;
+    cv::Mat m_detection;
+    cv::Mat m_descriptors;
+    std::vector<cv::Rect> m_detections;
+    std::vector<cv::KeyPoint> m_keypoints;
+    std::vector<cv::DMatch> m_matches;
+    std::vector<cv::DMatch> m_goodMatches;
+    std::vector<cv::KeyPoint> m_levelKeypoints;
+    std::array<cv::Mat, MAX_LEVELS> m_levelDescriptors;
+
+    std::array<QImage, PREVIEW_SLOTS> m_previews;
+    int m_nextPreview = 0;
+
+    cv::Size m_frameSize;
+    bool m_configured = false;
+
+    BufferStates m_states;
+    int m_pendingAllocations = 0;
+
+    std::atomic<quint64> m_frameCount{0};
+    std::atomic<quint64> m_allocationCount{0};
+    std::atomic<int> m_allocationsLastFrame{0};
+};
+
+#endif
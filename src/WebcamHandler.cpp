@@ -1,4 +1,6 @@
 #include "WebcamHandler.h"
+#include "PalmTracker.h"
+#include "StartupTimer.h"
 #include <QtConcurrent>
 #include <QDebug>
 #include <QThreadPool>
@@ -6,9 +8,21 @@
 #include <QDir>
 #include <QStandardPaths>
 #include <QTemporaryFile>
+#include <algorithm>
 
 WebcamHandler::WebcamHandler(QObject *parent) : QObject(parent), running(false) {
+    moveToThread(&workerThread);
+    connect(&workerThread, &QThread::started, this, &WebcamHandler::startProcessing);
+    connect(&workerThread, &QThread::finished, this, &QObject::deleteLater);
+}
+
+WebcamHandler::~WebcamHandler() {
+    stopCamera();
+    workerThread.quit();
+    workerThread.wait();
+}
 
+bool WebcamHandler::loadCascade() {
     QString resourcePath = ":/new/prefix3/resources/hand/palm.xml";
     QFile resourceFile(resourcePath);
 
@@ -63,27 +77,32 @@ WebcamHandler::WebcamHandler(QObject *parent) : QObject(parent), running(false)
         }
     }
 
-    moveToThread(&workerThread);
-    connect(&workerThread, &QThread::started, this, &WebcamHandler::startProcessing);
-    connect(&workerThread, &QThread::finished, this, &QObject::deleteLater);
-}
-
-WebcamHandler::~WebcamHandler() {
-    stopCamera();
-    workerThread.quit();
-    workerThread.wait();
+    if (!palmCascade.empty()) {
+        StartupTimer::mark("palm cascade loaded");
+    }
+    return !palmCascade.empty();
 }
 
 void WebcamHandler::startCamera() {
-    if (!cap.open(0)) {
-        qWarning() << "Failed to open webcam";
-        return;
-    }
-    running = true;
-    QThreadPool::globalInstance()->start([this]() { processFrame(); });
+    // Cascade et caméra ne dépendent pas l'une de l'autre : chargées en parallèle, le traitement attend les deux
+    QList<QFuture<bool>> stages;
+    stages.append(QtConcurrent::run([this]() { return loadCascade(); }));
+    stages.append(QtConcurrent::run([this]() { return cap.open(0); }));
+
+    startup = QtFuture::whenAll(stages.begin(), stages.end()).then([this](const QList<QFuture<bool>>& results) {
+        if (!results.at(1).result()) {
+            qWarning() << "Failed to open webcam";
+            return;
+        }
+        StartupTimer::mark("camera opened");
+        running = true;
+        QThreadPool::globalInstance()->start([this]() { processFrame(); });
+    });
 }
 
 void WebcamHandler::stopCamera() {
+    // Une ouverture en cours se termine avant la libération de la caméra
+    startup.waitForFinished();
     running = false;
     if (cap.isOpened()) {
         cap.release();
@@ -92,37 +111,134 @@ void WebcamHandler::stopCamera() {
     workerThread.wait();
 }
 
+void WebcamHandler::setPalmTracker(PalmTracker* tracker) {
+    palmTracker = tracker;
+}
+
+void WebcamHandler::startCalibration() {
+    if (!calibrating.exchange(true)) {
+        qDebug() << "Palm calibration started, show your palm in different poses";
+    }
+}
+
+void WebcamHandler::stopCalibration() {
+    calibrating = false;
+}
+
 void WebcamHandler::startProcessing() {
     QThreadPool::globalInstance()->start([this]() { processFrame(); });
 }
 
+void WebcamHandler::detectPalms(std::vector<cv::Rect>& palms) {
+    if (palmCascade.empty()) {
+        return;
+    }
+
+    const int scale = preprocessor.scale();
+    const int firstLevel = pyramid.firstLevelAtScale(scale);
+    pyramid.equalize(preprocessor.equalizationLut(), firstLevel, buffers.detection());
+
+    const cv::Size window = palmCascade.getOriginalWindowSize();
+    for (int i = firstLevel; i < pyramid.levelCount(); ++i) {
+        palmCascade.detectMultiScale(pyramid.equalizedLevel(i), levelDetections, 1.1, 0, 0, window, window);
+
+        const double toDetection = pyramid.scale(i) / scale;
+        for (const auto& hit : levelDetections) {
+            palms.emplace_back(cvRound(hit.x * toDetection), cvRound(hit.y * toDetection),
+                               cvRound(hit.width * toDetection), cvRound(hit.height * toDetection));
+        }
+    }
+
+    cv::groupRectangles(palms, 3, 0.2);
+}
+
 void WebcamHandler::processFrame() {
     while (running) {
-        cv::Mat frame;
+        buffers.beginFrame();
+
+        cv::Mat& frame = buffers.frame();
         if (!cap.read(frame)) {
             qWarning() << "Failed to capture frame";
             continue;
         }
 
-        cv::Mat gray;
-        cv::cvtColor(frame, gray, cv::COLOR_BGR2GRAY);
-        cv::equalizeHist(gray, gray);
+        if (!buffers.isConfiguredFor(frame.size())) {
+            preprocessor.configure(frame.size(), DETECTION_SCALE);
+            buffers.configure(frame.size(), preprocessor.reducedSize(), DETECTION_SCALE);
+            skinDetector.configure(cv::Size(preprocessor.reducedSize().width(), preprocessor.reducedSize().height()));
 
-        std::vector<cv::Rect> palms;
-        palmCascade.detectMultiScale(gray, palms);
+            cv::Size window = palmCascade.empty() ? cv::Size(32, 32) : palmCascade.getOriginalWindowSize();
+            pyramid.configure(frame.size(), PalmTracker::PYRAMID_SCALE_FACTOR, window);
+        }
+
+        QImage& preview = buffers.acquirePreview();
+        cv::Mat previewView = buffers.previewMat(preview);
+        preprocessor.process(frame, buffers, previewView);
+
+        if (!calibrating) {
+            framesSinceCalibrationView = CALIBRATION_VIEW_INTERVAL;
+        } else if (++framesSinceCalibrationView >= CALIBRATION_VIEW_INTERVAL && !palmCascade.empty()) {
+            framesSinceCalibrationView = 0;
+            emit calibrationViewReady(buffers.gray(), palmCascade);
+        }
+
+        cv::Point2f skinCenter;
+        cv::Rect skinBox;
+        const bool skinFound = skinDetector.detect(previewView, skinCenter, skinBox);
+        const bool skinTrusted = skinDetector.isAdapted() && framesSinceConfirmation < CONFIRMATION_TIMEOUT;
+
+        bool pyramidBuilt = false;
+        auto sharedPyramid = [&]() -> const ImagePyramid& {
+            if (!pyramidBuilt) {
+                pyramid.build(buffers.gray(), buffers.smallGray());
+                pyramidBuilt = true;
+            }
+            return pyramid;
+        };
+
+        std::vector<cv::Rect>& palms = buffers.detections();
+        palms.clear();
+        if (!skinFound || !skinTrusted || ++framesSinceCascade >= CASCADE_INTERVAL) {
+            framesSinceCascade = 0;
+            sharedPyramid();
+            detectPalms(palms);
+        }
+
+        if (!palms.empty()) {
+            const cv::Rect& largest = *std::max_element(palms.begin(), palms.end(),
+                [](const cv::Rect& a, const cv::Rect& b) { return a.area() < b.area(); });
+            skinDetector.adapt(previewView, largest);
+            framesSinceConfirmation = 0;
+        } else if (framesSinceConfirmation < CONFIRMATION_TIMEOUT) {
+            framesSinceConfirmation++;
+        }
 
+        const int scale = preprocessor.scale();
         for (const auto &palm : palms) {
-            cv::rectangle(frame, palm, cv::Scalar(0, 255, 0), 2);
+            cv::rectangle(previewView, palm, cv::Scalar(0, 255, 0), 1);
 
-            QPoint center(palm.x + palm.width / 2, palm.y + palm.height / 2);
+            QPoint center((palm.x + palm.width / 2) * scale, (palm.y + palm.height / 2) * scale);
             emit handDetected(center);
         }
 
-        QImage qFrame(frame.data, frame.cols, frame.rows, frame.step, QImage::Format_BGR888);
+        PalmTracker* tracker = palmTracker.load();
+        if (palms.empty() && skinFound && skinTrusted) {
+            cv::rectangle(previewView, skinBox, cv::Scalar(255, 128, 0), 1);
+            emit handDetected(QPoint(int(skinCenter.x * scale), int(skinCenter.y * scale)));
+        } else if (palms.empty() && tracker && tracker->trackPalm(sharedPyramid())) {
+            QPointF position = tracker->getNormalizedPosition();
+            emit handDetected(QPoint(int(position.x() * frame.cols), int(position.y() * frame.rows)));
+        }
 
-        QSize targetSize(640, 360); 
-        QImage resizedFrame = qFrame.scaled(targetSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        buffers.endFrame();
 
-        emit frameReady(resizedFrame);
+        emit frameReady(preview);
+
+        if (buffers.frameCount() % 300 == 0) {
+            qDebug() << "Vision buffers:" << buffers.allocationCount() << "allocations over"
+                     << buffers.frameCount() << "frames, last frame:" << buffers.allocationsLastFrame()
+                     << "| palm tracker:" << (tracker ? tracker->bufferAllocations() : 0)
+                     << "| not pooled: OpenCV cascade and FLANN internals, skin component stats";
+        }
     }
-}
\ No newline at end of file
+}
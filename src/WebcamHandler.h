@@ -10,9 +10,17 @@
 
 #include <QObject>
 #include <QThread>
+#include <QFuture>
 #include <QImage>
 #include <QPoint>
 #include <opencv2/opencv.hpp>
+#include "VisionBufferPool.h"
+#include "FramePreprocessor.h"
+#include "SkinDetector.h"
+#include "ImagePyramid.h"
+#include <atomic>
+
+class PalmTracker;
 
 /**
  * @class WebcamHandler
@@ -30,8 +38,8 @@ public:
      * @brief Constructeur
      * @param parent Pointeur vers l'objet parent (nullptr par défaut)
      * 
-     * Initialise les ressources nécessaires, notamment le fichier XML pour
-     * la détection des paumes et configure le thread de travail.
+     * Configure le thread de travail ; la cascade de détection des paumes
+     * est chargée par startCamera().
      */
     explicit WebcamHandler(QObject *parent = nullptr);
     
@@ -43,9 +51,10 @@ public:
     ~WebcamHandler();
 
     /**
-     * @brief Démarre la capture vidéo
+     * @brief Démarre la capture vidéo sans attendre
      * 
-     * Ouvre la webcam et lance le traitement des images dans un thread séparé.
+     * Charge la cascade et ouvre la webcam en parallèle (QtConcurrent), puis
+     * lance le traitement des images dans un thread séparé quand les deux sont prêts.
      */
     void startCamera();
     
@@ -56,6 +65,28 @@ public:
      */
     void stopCamera();
 
+    /**
+     * @brief Associe un suivi de paume par points caractéristiques
+     * @param tracker Suivi utilisé lorsque la cascade ne trouve pas de paume (nullptr pour aucun)
+     *
+     * Le suivi reçoit directement l'image en niveaux de gris du prétraitement partagé.
+     */
+    void setPalmTracker(PalmTracker* tracker);
+
+    /**
+     * @brief Passe en mode calibration de la paume (tout thread)
+     *
+     * Toutes les CALIBRATION_VIEW_INTERVAL images, l'image en niveaux de gris et la
+     * cascade déjà chargée sont transmises par calibrationViewReady, le temps que
+     * le joueur change la pose de sa main entre deux vues.
+     */
+    void startCalibration();
+
+    /**
+     * @brief Quitte le mode calibration (tout thread)
+     */
+    void stopCalibration();
+
 signals:
     /**
      * @brief Signal émis lorsqu'une image est prête
@@ -69,28 +100,75 @@ signals:
      */
     void handDetected(const QPoint &center);
 
+    /**
+     * @brief Signal émis, dans le thread de traitement, pour chaque vue de calibration
+     * @param gray Image pleine résolution en niveaux de gris (valide pendant l'appel)
+     * @param cascade Cascade de détection des paumes du gestionnaire
+     *
+     * À connecter en Qt::DirectConnection : ni l'image ni la cascade ne sont copiées,
+     * et la cascade n'est utilisée que par ce thread.
+     */
+    void calibrationViewReady(const cv::Mat &gray, cv::CascadeClassifier &cascade);
+
 private:
     /**
      * @brief Traite les images capturées par la webcam
      * 
      * Cette méthode s'exécute dans un thread séparé et effectue :
-     * - Capture d'image depuis la webcam
-     * - Conversion en niveaux de gris
-     * - Détection des paumes avec OpenCV
-     * - Dessin des rectangles autour des paumes détectées
+     * - Capture d'image depuis la webcam dans les tampons préalloués
+     * - Prétraitement fusionné (gris, image de détection égalisée, aperçu réduit)
+     * - Construction, seulement si nécessaire, de la pyramide partagée par la
+     *   cascade et le suivi ORB
+     * - Localisation rapide de la main par couleur de peau à chaque image
+     * - Détection des paumes avec la cascade, toutes les CASCADE_INTERVAL images
+     *   pour vérifier la couleur de peau et ajuster son modèle, ou à chaque image
+     *   tant que la couleur de peau n'est pas fiable
+     * - Dessin des rectangles autour des mains détectées sur l'aperçu
      * - Émission des signaux avec l'image et la position des mains
      */
     void processFrame();
+
+    /**
+     * @brief Détecte les paumes niveau par niveau sur la pyramide partagée
+     * @param palms Détections, dans le repère de l'image de détection réduite
+     *
+     * La cascade n'est appliquée qu'à sa taille de fenêtre d'origine sur chaque
+     * niveau égalisé, puis les détections brutes sont regroupées comme le ferait
+     * detectMultiScale.
+     */
+    void detectPalms(std::vector<cv::Rect>& palms);
     
     /**
      * @brief Démarre le traitement dans le thread de travail
      */
     void startProcessing();
 
+    /**
+     * @brief Extrait palm.xml des ressources et charge la cascade (tout thread)
+     * @return true si la cascade est chargée
+     */
+    bool loadCascade();
+
     QThread workerThread;           ///< Thread séparé pour le traitement des images
     cv::VideoCapture cap;           ///< Objet OpenCV pour la capture vidéo
     cv::CascadeClassifier palmCascade; ///< Classificateur en cascade pour détecter les paumes
     bool running;                   ///< Indicateur d'état de fonctionnement
+    QFuture<void> startup;          ///< Chargement de la cascade et ouverture de la caméra
+    VisionBufferPool buffers;       ///< Tampons réutilisés d'une image à l'autre
+    FramePreprocessor preprocessor; ///< Noyau de prétraitement en une passe
+    std::atomic<PalmTracker*> palmTracker{nullptr}; ///< Suivi ORB utilisé en complément de la cascade
+    SkinDetector skinDetector;      ///< Détecteur rapide par couleur de peau
+    ImagePyramid pyramid;           ///< Pyramide construite une fois par image
+    std::vector<cv::Rect> levelDetections; ///< Détections brutes d'un niveau de la pyramide
+    int framesSinceCascade = 0;     ///< Images depuis le dernier passage de la cascade
+    int framesSinceConfirmation = CONFIRMATION_TIMEOUT; ///< Images depuis la dernière paume confirmée par la cascade
+    std::atomic<bool> calibrating{false}; ///< Mode calibration demandé
+    int framesSinceCalibrationView = 0;   ///< Images depuis la dernière vue de calibration
+
+    static constexpr int DETECTION_SCALE = 2;       ///< Réduction de l'image de détection et de l'aperçu
+    static constexpr int CASCADE_INTERVAL = 10;     ///< Période de vérification par la cascade
+    static constexpr int CONFIRMATION_TIMEOUT = 90; ///< Images sans confirmation avant de ne plus se fier à la peau
+    static constexpr int CALIBRATION_VIEW_INTERVAL = 30; ///< Images entre deux vues de calibration
 };
 
 #endif 
\ No newline at end of file
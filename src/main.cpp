@@ -1,23 +1,48 @@
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QSurfaceFormat>
 #include "MainWindow.h"
 #include "PalmTracker.h"
-#include <opencv2/core.hpp>
+#include "PalmCalibrationModel.h"
+#include "StartupTimer.h"
+#include "DynamicResolution.h"
+#include <QDebug>
 
 int main(int argc, char *argv[]) {
-    QApplication app(argc, argv);
+    StartupTimer::start();
 
-    PalmTracker* palmTracker = new PalmTracker();
+    // Rendu cadencé par la synchronisation verticale (frameSwapped)
+    QSurfaceFormat format = QSurfaceFormat::defaultFormat();
+    format.setSwapInterval(1);
+    QSurfaceFormat::setDefaultFormat(format);
 
-    cv::Rect dummyPalmRegion(100, 100, 200, 200);
-    std::vector<cv::KeyPoint> dummyKeypoints;
-    cv::Mat dummyDescriptors;
+    QApplication app(argc, argv);
 
-    dummyKeypoints.push_back(cv::KeyPoint(150.0f, 150.0f, 10.0f));
-    dummyDescriptors = cv::Mat::zeros(1, 32, CV_8U);  
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    parser.addOption({ "min-render-scale", "Lowest 3D render scale per side when the GPU is over budget.", "scale",
+                       QString::number(DynamicResolution::DEFAULT_MIN_SCALE) });
+    parser.addOption({ "max-render-scale", "Highest 3D render scale per side.", "scale",
+                       QString::number(DynamicResolution::DEFAULT_MAX_SCALE) });
+    parser.addOption({ "gpu-budget", "GPU time per frame the render scale adapts to, in ms.", "ms",
+                       QString::number(DynamicResolution::DEFAULT_BUDGET_MS) });
+    parser.process(app);
+
+    PalmTracker* palmTracker = new PalmTracker();
 
-    palmTracker->setCalibrationData(dummyPalmRegion, dummyKeypoints, dummyDescriptors);
+    PalmCalibrationModel calibrationModel;
+    if (calibrationModel.load(PalmCalibrationModel::defaultPath())) {
+        palmTracker->setCalibrationModel(calibrationModel);
+        qDebug() << "Palm model loaded:" << calibrationModel.descriptors().rows << "descriptors";
+    } else {
+        qDebug() << "No palm model found, press C to calibrate";
+    }
 
     MainWindow* mainWindow = new MainWindow();
+    mainWindow->setPalmTracker(palmTracker);
+    mainWindow->setRenderScaling(parser.value("min-render-scale").toFloat(),
+                                 parser.value("max-render-scale").toFloat(),
+                                 parser.value("gpu-budget").toFloat());
 
     mainWindow->showMaximized();
 
@@ -0,0 +1,124 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QDebug>
+#include "MeshAssetFormat.h"
+#include "MeshLibrary.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Maillage généré et compacté, et son entrée dans la table
+ */
+struct BakedMesh {
+    MeshAsset::Entry entry;
+    PackedMeshData data;
+};
+
+void pad(QByteArray& bytes) {
+    bytes.append(QByteArray((4 - bytes.size() % 4) % 4, '\0'));
+}
+
+/**
+ * @brief Ajoute sommets, indices et plages d'un maillage à la suite des données
+ * @param payload Données écrites après la table
+ * @param base Position de payload dans le fichier
+ */
+void appendMesh(QByteArray& payload, quint32 base, BakedMesh& mesh) {
+    const MeshView view = mesh.data.view();
+    MeshAsset::Entry& entry = mesh.entry;
+
+    entry.vertexCount = quint32(mesh.data.vertices.size());
+    entry.vertexOffset = base + quint32(payload.size());
+    payload.append(static_cast<const char*>(view.vertices), qsizetype(view.vertexBytes));
+
+    entry.indexSize = view.indexType == GL_UNSIGNED_SHORT ? 2 : 4;
+    entry.indexCount = quint32(view.indexBytes / entry.indexSize);
+    entry.indexOffset = base + quint32(payload.size());
+    payload.append(static_cast<const char*>(view.indices), qsizetype(view.indexBytes));
+    pad(payload);
+
+    entry.partCount = quint32(view.parts.size());
+    entry.partOffset = base + quint32(payload.size());
+    for (const MeshPart& part : view.parts) {
+        const MeshAsset::Part stored = { quint32(part.firstIndex), quint32(part.indexCount), quint32(part.mode) };
+        payload.append(reinterpret_cast<const char*>(&stored), sizeof(stored));
+    }
+
+    entry.boundingRadius = view.boundingRadius;
+}
+
+bool writeMeshes(const QString& path, std::vector<BakedMesh>& meshes) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Cannot write" << path;
+        return false;
+    }
+
+    MeshAsset::Header header{};
+    std::memcpy(header.magic, MeshAsset::MAGIC, sizeof(MeshAsset::MAGIC));
+    header.version = MeshAsset::VERSION;
+    header.entryCount = quint32(meshes.size());
+
+    const quint32 payloadBase = quint32(sizeof(header) + meshes.size() * sizeof(MeshAsset::Entry));
+    QByteArray payload;
+    for (BakedMesh& mesh : meshes) {
+        appendMesh(payload, payloadBase, mesh);
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const BakedMesh& mesh : meshes) {
+        file.write(reinterpret_cast<const char*>(&mesh.entry), sizeof(mesh.entry));
+    }
+    file.write(payload);
+
+    return file.error() == QFileDevice::NoError;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("mesh_baker");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Bakes the procedural projectile and sword meshes, with every LOD, packed and cache-optimized into meshes.bin.");
+    parser.addHelpOption();
+    parser.addOption({ { "o", "output" }, "Output file (next to the game executable).", "file", "meshes.bin" });
+    parser.process(app);
+
+    const QString output = parser.value("output");
+    const QDir outputDir = QFileInfo(output).absoluteDir();
+    if (!outputDir.exists() && !QDir().mkpath(outputDir.path())) {
+        qWarning() << "Cannot create" << outputDir.path();
+        return 1;
+    }
+
+    std::vector<BakedMesh> meshes;
+    for (int kind = 0; kind < MeshAsset::KIND_COUNT; ++kind) {
+        for (int lod = 0; lod < MeshLibrary::lodCount(MeshAsset::Kind(kind)); ++lod) {
+            BakedMesh mesh;
+            mesh.entry = MeshAsset::Entry{};
+            mesh.entry.kind = quint16(kind);
+            mesh.entry.lod = quint16(lod);
+            mesh.data = PackedMeshData::pack(MeshLibrary::generate(MeshAsset::Kind(kind), lod));
+            meshes.push_back(std::move(mesh));
+        }
+    }
+
+    if (!writeMeshes(output, meshes)) {
+        return 1;
+    }
+
+    for (const BakedMesh& mesh : meshes) {
+        qDebug().noquote() << QString("kind %1 lod %2: %3 vertices, %4 indices (%5-bit), radius %6")
+                              .arg(mesh.entry.kind).arg(mesh.entry.lod).arg(mesh.entry.vertexCount)
+                              .arg(mesh.entry.indexCount).arg(mesh.entry.indexSize * 8).arg(mesh.entry.boundingRadius);
+    }
+    qDebug().noquote() << output << QString("(%1 meshes, %2 bytes)").arg(meshes.size()).arg(QFileInfo(output).size());
+    return 0;
+}
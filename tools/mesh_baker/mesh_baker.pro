@@ -0,0 +1,24 @@
+QT += core gui
+QT -= widgets
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = mesh_baker
+
+INCLUDEPATH += ../../src
+
+SOURCES += \
+    main.cpp \
+    ../../src/MeshLibrary.cpp \
+    ../../src/Projectile.cpp \
+    ../../src/MeshSlicer.cpp \
+    ../../src/Mesh.cpp
+
+HEADERS += \
+    ../../src/MeshAssetFormat.h \
+    ../../src/MeshLibrary.h \
+    ../../src/Projectile.h \
+    ../../src/MeshSlicer.h \
+    ../../src/TrigTables.h \
+    ../../src/Mesh.h
@@ -0,0 +1,280 @@
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLFunctions>
+#include <QRandomGenerator>
+#include <QTextStream>
+#include <QtMath>
+#include "SceneRenderer.h"
+#include "MeshUploadQueue.h"
+#include "Projectile.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Charge scriptée : fruits entiers, fragments et rotation de la caméra
+ */
+struct Scenario {
+    const char* name;
+    int fruits;             ///< Projectiles entiers
+    int fragments;          ///< Fragments découpés (par paires, une gerbe de jus par découpe)
+    float orbitDegrees;     ///< Rotation de la caméra autour de l'arène sur l'ensemble des images
+};
+
+const Scenario SCENARIOS[] = {
+    { "empty-arena", 0, 0, 360.0f },
+    { "fruits-20", 20, 0, 360.0f },
+    { "fragments-100", 10, 100, 360.0f },
+    { "stress", 60, 300, 360.0f },
+};
+
+/**
+ * @brief Résultats d'un scénario, moyennés par image
+ */
+struct Result {
+    double cpuAverage = 0.0;     ///< Préparation et soumission (ms)
+    double cpuP95 = 0.0;
+    double wallAverage = 0.0;    ///< Jusqu'à la fin du travail GPU, glFinish compris (ms)
+    double gpuAverage = 0.0;     ///< Somme des passes d'après les requêtes de minutage (ms)
+    double draws = 0.0;
+    double uploadBytes = 0.0;
+    double drawnProjectiles = 0.0;
+};
+
+const float SIMULATION_STEP = 1.0f / 120.0f;
+const int RESTART_FRAMES = 60;      ///< Remise à la position initiale avant que la gravité ne sorte la charge du champ
+quint64 burstSequence = 0;          ///< Numéros des gerbes, croissants d'un scénario à l'autre
+
+Projectile makeProjectile(QRandomGenerator& random, int index) {
+    const Projectile::Type type = Projectile::Type(index % Projectile::TYPE_COUNT);
+
+    // Volume parcouru par les projectiles en jeu, entre la zone de génération et le joueur
+    const QVector3D position(random.bounded(-200, 200) / 100.0f,
+                             random.bounded(-100, 150) / 100.0f,
+                             random.bounded(-500, 200) / 100.0f);
+    const QVector3D velocity(random.bounded(-20, 20) / 100.0f,
+                             random.bounded(-20, 20) / 100.0f,
+                             random.bounded(-20, 20) / 100.0f);
+    return Projectile(type, position, velocity);
+}
+
+std::vector<Projectile> buildLoad(const Scenario& scenario, MeshUploadQueue& uploads, std::vector<JuiceBurst>& bursts) {
+    QRandomGenerator random(20250501);
+    std::vector<Projectile> projectiles;
+
+    int index = 0;
+    for (int i = 0; i < scenario.fruits; ++i) {
+        projectiles.push_back(makeProjectile(random, index++));
+    }
+
+    // Les fragments passent par la file d'envoi, comme ceux découpés par la simulation
+    for (int i = 0; i < scenario.fragments; i += 2) {
+        Projectile whole = makeProjectile(random, index++);
+
+        JuiceBurst burst;
+        burst.type = whole.type();
+        burst.position = whole.position();
+        burst.velocity = whole.velocity();
+
+        std::vector<Projectile> pieces = whole.slice();
+        if (!pieces.empty()) {
+            burst.sliceNormal = pieces.front().state().lastCut().normal;
+            bursts.push_back(burst);
+        }
+
+        for (Projectile& fragment : pieces) {
+            const Projectile::State state = fragment.state();
+
+            MeshUploadRequest request;
+            request.ownerId = state.id;
+            request.levels.reserve(Projectile::LOD_COUNT);
+            for (int lod = 0; lod < Projectile::LOD_COUNT; ++lod) {
+                request.levels.push_back(PackedMeshData::pack(Projectile::buildFragmentMeshData(state, lod)));
+            }
+            uploads.post(std::move(request));
+            projectiles.push_back(fragment);
+        }
+    }
+    return projectiles;
+}
+
+Result runScenario(const Scenario& scenario, SceneRenderer& scene, QOpenGLFramebufferObject& target,
+                   QOpenGLFunctions* gl, int warmupFrames, int measuredFrames) {
+    MeshUploadQueue uploads;
+    std::vector<JuiceBurst> bursts;
+    const std::vector<Projectile> initialLoad = buildLoad(scenario, uploads, bursts);
+    std::vector<Projectile> projectiles = initialLoad;
+    std::vector<Projectile::State> states;
+    states.reserve(projectiles.size());
+
+    std::vector<double> cpuTimes;
+    cpuTimes.reserve(measuredFrames);
+    Result result;
+    QElapsedTimer timer;
+
+    const int totalFrames = warmupFrames + measuredFrames;
+    for (int frameIndex = 0; frameIndex < totalFrames; ++frameIndex) {
+        // Chaque remise en place relance les gerbes des découpes, sous de nouveaux numéros
+        const bool restart = frameIndex % RESTART_FRAMES == 0;
+        if (restart) {
+            projectiles = initialLoad;
+            for (JuiceBurst& burst : bursts) {
+                burst.sequence = ++burstSequence;
+            }
+        }
+
+        states.clear();
+        for (Projectile& projectile : projectiles) {
+            projectile.storePreviousState();
+            projectile.update(SIMULATION_STEP);
+            states.push_back(projectile.state());
+        }
+
+        const float yaw = qDegreesToRadians(scenario.orbitDegrees * frameIndex / totalFrames);
+        const float pitch = qDegreesToRadians(15.0f);
+        const QVector3D eye(5.0f * qCos(pitch) * qSin(yaw), 5.0f * qSin(pitch), 5.0f * qCos(pitch) * qCos(yaw));
+
+        SceneFrame frame;
+        frame.view.lookAt(eye, QVector3D(0, 0, 0), QVector3D(0, 1, 0));
+        frame.projection.perspective(frame.fieldOfView, float(target.width()) / target.height(), 0.1f, 100.0f);
+        frame.eye = eye;
+        frame.targetFramebuffer = target.handle();
+        frame.viewportWidth = target.width();
+        frame.viewportHeight = target.height();
+        frame.time = frameIndex * SIMULATION_STEP;
+        frame.showSword = true;
+        frame.handPosition = QVector3D(1.5f * qCos(frame.time), 0.0f, 1.5f * qSin(frame.time));
+        frame.projectiles = &states;
+        frame.bursts = restart ? &bursts : nullptr;
+
+        const quint64 bytesBefore = scene.uploadedBytes();
+        timer.start();
+        scene.beginFrame(uploads);
+        scene.render(frame);
+        const double cpu = timer.nsecsElapsed() / 1e6;
+        gl->glFinish();
+        const double wall = timer.nsecsElapsed() / 1e6;
+
+        if (frameIndex < warmupFrames) continue;
+
+        cpuTimes.push_back(cpu);
+        result.cpuAverage += cpu;
+        result.wallAverage += wall;
+        result.draws += scene.queueStats().draws;
+        result.uploadBytes += double(scene.uploadedBytes() - bytesBefore);
+        result.drawnProjectiles += scene.cullingStats().drawn;
+    }
+
+    result.cpuAverage /= measuredFrames;
+    result.wallAverage /= measuredFrames;
+    result.draws /= measuredFrames;
+    result.uploadBytes /= measuredFrames;
+    result.drawnProjectiles /= measuredFrames;
+
+    auto p95 = cpuTimes.begin() + (cpuTimes.size() * 95) / 100;
+    std::nth_element(cpuTimes.begin(), p95, cpuTimes.end());
+    result.cpuP95 = *p95;
+
+    // Fenêtre glissante du profileur : couvre les dernières images mesurées
+    result.gpuAverage = scene.profiler().isSupported() ? scene.profiler().gpuStats().average : -1.0;
+    return result;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    // Sans affichage : la plateforme offscreen suffit (Mesa llvmpipe convient)
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM") && qEnvironmentVariableIsEmpty("DISPLAY")
+        && qEnvironmentVariableIsEmpty("WAYLAND_DISPLAY")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QSurfaceFormat format;
+    format.setVersion(3, 3);
+    format.setProfile(QSurfaceFormat::CoreProfile);
+    format.setDepthBufferSize(24);
+    QSurfaceFormat::setDefaultFormat(format);
+
+    QGuiApplication app(argc, argv);
+    QCoreApplication::setApplicationName("render_benchmark");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Renders the game scene offscreen under scripted loads and reports per-frame costs.");
+    parser.addHelpOption();
+    parser.addOption({ "frames", "Measured frames per scenario.", "count", "300" });
+    parser.addOption({ "warmup", "Unmeasured frames before each scenario.", "count", "30" });
+    parser.addOption({ "size", "Framebuffer size.", "WxH", "1280x720" });
+    parser.addOption({ "scenario", "Run only this scenario (repeatable).", "name" });
+    parser.addOption({ "csv", "Print results as CSV." });
+    parser.process(app);
+
+    const int measuredFrames = std::max(1, parser.value("frames").toInt());
+    const int warmupFrames = std::max(0, parser.value("warmup").toInt());
+    const QStringList size = parser.value("size").split('x');
+    const QSize targetSize(size.value(0).toInt(), size.value(1).toInt());
+    if (targetSize.isEmpty()) {
+        qWarning("Invalid --size, expected WxH");
+        return 1;
+    }
+    const QStringList selected = parser.values("scenario");
+
+    QOpenGLContext context;
+    if (!context.create()) {
+        qWarning("Cannot create an OpenGL 3.3 core context");
+        return 1;
+    }
+    QOffscreenSurface surface;
+    surface.setFormat(context.format());
+    surface.create();
+    if (!context.makeCurrent(&surface)) {
+        qWarning("Cannot make the offscreen context current");
+        return 1;
+    }
+
+    QOpenGLFramebufferObject target(targetSize, QOpenGLFramebufferObject::Depth);
+
+    SceneRenderer scene(1.5f, 2.0f);
+    scene.prefetchTextures();
+    scene.initialize();
+
+    QTextStream out(stdout);
+    const bool csv = parser.isSet("csv");
+    const char* renderer = reinterpret_cast<const char*>(context.functions()->glGetString(GL_RENDERER));
+    if (csv) {
+        out << "scenario,projectiles,drawn,cpu_ms,cpu_p95_ms,wall_ms,gpu_ms,draws,upload_bytes\n";
+    } else {
+        out << "Renderer: " << renderer << ", " << targetSize.width() << "x" << targetSize.height()
+            << ", " << measuredFrames << " frames per scenario\n";
+        out << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9\n")
+                   .arg("scenario", -14).arg("proj", 6).arg("drawn", 7).arg("cpu ms", 8).arg("p95", 8)
+                   .arg("wall ms", 8).arg("gpu ms", 8).arg("draws", 7).arg("upload B", 10);
+    }
+
+    for (const Scenario& scenario : SCENARIOS) {
+        if (!selected.isEmpty() && !selected.contains(scenario.name)) continue;
+
+        const Result r = runScenario(scenario, scene, target, context.functions(), warmupFrames, measuredFrames);
+        const int projectileCount = scenario.fruits + scenario.fragments;
+
+        if (csv) {
+            out << scenario.name << ',' << projectileCount << ',' << r.drawnProjectiles << ',' << r.cpuAverage << ','
+                << r.cpuP95 << ',' << r.wallAverage << ',' << r.gpuAverage << ',' << r.draws << ','
+                << r.uploadBytes << '\n';
+        } else {
+            out << QString("%1 %2 %3 %4 %5 %6 %7 %8 %9\n")
+                       .arg(scenario.name, -14).arg(projectileCount, 6).arg(r.drawnProjectiles, 7, 'f', 1)
+                       .arg(r.cpuAverage, 8, 'f', 3).arg(r.cpuP95, 8, 'f', 3).arg(r.wallAverage, 8, 'f', 3)
+                       .arg(r.gpuAverage, 8, 'f', 3).arg(r.draws, 7, 'f', 1).arg(r.uploadBytes, 10, 'f', 0);
+        }
+        out.flush();
+    }
+
+    scene.destroy();
+    context.doneCurrent();
+    return 0;
+}
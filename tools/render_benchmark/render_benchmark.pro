@@ -0,0 +1,50 @@
+QT += core gui opengl concurrent
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = render_benchmark
+
+INCLUDEPATH += ../../src
+
+SOURCES += \
+    main.cpp \
+    ../../src/SceneRenderer.cpp \
+    ../../src/ProjectileRenderer.cpp \
+    ../../src/Projectile.cpp \
+    ../../src/MeshSlicer.cpp \
+    ../../src/Mesh.cpp \
+    ../../src/MeshLibrary.cpp \
+    ../../src/MeshUploadQueue.cpp \
+    ../../src/RenderQueue.cpp \
+    ../../src/RenderUniforms.cpp \
+    ../../src/ShaderLibrary.cpp \
+    ../../src/ShadowMap.cpp \
+    ../../src/Frustum.cpp \
+    ../../src/GpuProfiler.cpp \
+    ../../src/JuiceParticles.cpp \
+    ../../src/StreamBuffer.cpp \
+    ../../src/TextureLoader.cpp
+
+HEADERS += \
+    ../../src/SceneRenderer.h \
+    ../../src/ProjectileRenderer.h \
+    ../../src/Projectile.h \
+    ../../src/MeshSlicer.h \
+    ../../src/Mesh.h \
+    ../../src/MeshAssetFormat.h \
+    ../../src/MeshLibrary.h \
+    ../../src/MeshUploadQueue.h \
+    ../../src/RenderQueue.h \
+    ../../src/RenderUniforms.h \
+    ../../src/ShaderLibrary.h \
+    ../../src/ShadowMap.h \
+    ../../src/Frustum.h \
+    ../../src/GpuProfiler.h \
+    ../../src/JuiceParticles.h \
+    ../../src/StreamBuffer.h \
+    ../../src/TrigTables.h \
+    ../../src/KtxFormat.h \
+    ../../src/TextureLoader.h
+
+RESOURCES += ../../resources.qrc
@@ -0,0 +1,106 @@
+#include "Bc1Encoder.h"
+#include <algorithm>
+#include <climits>
+
+namespace {
+
+quint16 packRgb565(int r, int g, int b) {
+    return quint16(((r * 31 + 127) / 255) << 11 | ((g * 63 + 127) / 255) << 5 | ((b * 31 + 127) / 255));
+}
+
+void unpackRgb565(quint16 color, int rgb[3]) {
+    const int r = (color >> 11) & 31;
+    const int g = (color >> 5) & 63;
+    const int b = color & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+}
+
+QByteArray Bc1Encoder::encode(const QImage& image) {
+    const int width = image.width();
+    const int height = image.height();
+    const int blocksX = std::max(1, (width + 3) / 4);
+    const int blocksY = std::max(1, (height + 3) / 4);
+
+    QByteArray result(blocksX * blocksY * 8, Qt::Uninitialized);
+    uchar* output = reinterpret_cast<uchar*>(result.data());
+
+    uchar texels[16][4];
+    for (int by = 0; by < blocksY; ++by) {
+        for (int bx = 0; bx < blocksX; ++bx) {
+            for (int i = 0; i < 16; ++i) {
+                // Les niveaux de 1 ou 2 texels de côté répètent leur bord
+                const int x = std::min(bx * 4 + i % 4, width - 1);
+                const int y = std::min(by * 4 + i / 4, height - 1);
+                std::copy_n(image.constScanLine(y) + x * 4, 4, texels[i]);
+            }
+            encodeBlock(texels, output);
+            output += 8;
+        }
+    }
+    return result;
+}
+
+void Bc1Encoder::encodeBlock(const uchar texels[16][4], uchar* block) {
+    int minColor[3] = { 255, 255, 255 };
+    int maxColor[3] = { 0, 0, 0 };
+    for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+            minColor[c] = std::min(minColor[c], int(texels[i][c]));
+            maxColor[c] = std::max(maxColor[c], int(texels[i][c]));
+        }
+    }
+
+    // Resserre la boîte d'un seizième : les extrémités tombent moins souvent sur un texel isolé
+    for (int c = 0; c < 3; ++c) {
+        const int inset = (maxColor[c] - minColor[c]) / 16;
+        minColor[c] += inset;
+        maxColor[c] -= inset;
+    }
+
+    quint16 color0 = packRgb565(maxColor[0], maxColor[1], maxColor[2]);
+    quint16 color1 = packRgb565(minColor[0], minColor[1], minColor[2]);
+    if (color0 < color1) {
+        std::swap(color0, color1);
+    }
+
+    quint32 indices = 0;
+    if (color0 != color1) {
+        int palette[4][3];
+        unpackRgb565(color0, palette[0]);
+        unpackRgb565(color1, palette[1]);
+        for (int c = 0; c < 3; ++c) {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        for (int i = 0; i < 16; ++i) {
+            int best = 0;
+            int bestDistance = INT_MAX;
+            for (int p = 0; p < 4; ++p) {
+                int distance = 0;
+                for (int c = 0; c < 3; ++c) {
+                    const int delta = int(texels[i][c]) - palette[p][c];
+                    distance += delta * delta;
+                }
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = p;
+                }
+            }
+            indices |= quint32(best) << (2 * i);
+        }
+    }
+
+    // Petit-boutiste, comme attendu par OpenGL
+    block[0] = uchar(color0 & 0xFF);
+    block[1] = uchar(color0 >> 8);
+    block[2] = uchar(color1 & 0xFF);
+    block[3] = uchar(color1 >> 8);
+    for (int i = 0; i < 4; ++i) {
+        block[4 + i] = uchar(indices >> (8 * i));
+    }
+}
@@ -0,0 +1,36 @@
+/**
+ * @file Bc1Encoder.h
+ * @brief Compression BC1 (DXT1) des niveaux de texture pour texture_baker
+ * @author Aymane ASSERRAR + Marieme Benzha
+ * @date Mai 2025
+ */
+
+#ifndef BC1ENCODER_H
+#define BC1ENCODER_H
+
+#include <QByteArray>
+#include <QImage>
+
+/**
+ * @class Bc1Encoder
+ * @brief Encodeur BC1 simple : extrémités prises sur la boîte englobante des couleurs du bloc
+ *
+ * Chaque bloc de 4x4 texels devient deux couleurs RGB565 et seize indices de
+ * deux bits (mode quatre couleurs, sans transparence). La qualité est en deçà
+ * d'un encodeur par moindres carrés mais largement suffisante pour les
+ * textures de l'arène et des fruits, vues à distance et filtrées.
+ */
+class Bc1Encoder {
+public:
+    /**
+     * @brief Compresse une image entière
+     * @param image Image au format RGBA8888 (les bords sont répétés si la taille n'est pas multiple de 4)
+     * @return Blocs de 8 octets, ligne de blocs par ligne de blocs
+     */
+    static QByteArray encode(const QImage& image);
+
+private:
+    static void encodeBlock(const uchar texels[16][4], uchar* block);
+};
+
+#endif
@@ -0,0 +1,123 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+#include <QDebug>
+#include "KtxFormat.h"
+#include "Bc1Encoder.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Chaîne de mipmaps complète, niveau 0 compris, déjà retournée pour OpenGL
+ */
+std::vector<QImage> buildMipChain(const QImage& source) {
+    std::vector<QImage> levels;
+    levels.push_back(source.convertToFormat(QImage::Format_RGBA8888).flipped());
+
+    while (levels.back().width() > 1 || levels.back().height() > 1) {
+        const QImage& previous = levels.back();
+        levels.push_back(previous.scaled(std::max(1, previous.width() / 2), std::max(1, previous.height() / 2),
+                                         Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    }
+    return levels;
+}
+
+bool writeKtx(const QString& path, const std::vector<QImage>& levels, bool compress) {
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Cannot write" << path;
+        return false;
+    }
+
+    Ktx::Header header{};
+    std::memcpy(header.identifier, Ktx::IDENTIFIER, sizeof(Ktx::IDENTIFIER));
+    header.endianness = Ktx::ENDIANNESS;
+    header.glType = compress ? 0 : Ktx::GL_TYPE_UNSIGNED_BYTE;
+    header.glTypeSize = 1;
+    header.glFormat = compress ? 0 : Ktx::GL_FORMAT_RGBA;
+    header.glInternalFormat = compress ? Ktx::GL_INTERNAL_BC1_RGB : Ktx::GL_INTERNAL_RGBA8;
+    header.glBaseInternalFormat = compress ? Ktx::GL_FORMAT_RGB : Ktx::GL_FORMAT_RGBA;
+    header.pixelWidth = quint32(levels.front().width());
+    header.pixelHeight = quint32(levels.front().height());
+    header.numberOfFaces = 1;
+    header.numberOfMipmapLevels = quint32(levels.size());
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for (const QImage& level : levels) {
+        QByteArray texels;
+        if (compress) {
+            texels = Bc1Encoder::encode(level);
+        } else {
+            // Lignes contiguës, sans le remplissage éventuel de QImage
+            texels.reserve(level.width() * level.height() * 4);
+            for (int y = 0; y < level.height(); ++y) {
+                texels.append(reinterpret_cast<const char*>(level.constScanLine(y)), level.width() * 4);
+            }
+        }
+
+        const quint32 imageSize = quint32(texels.size());
+        file.write(reinterpret_cast<const char*>(&imageSize), sizeof(imageSize));
+        file.write(texels);
+
+        const int padding = (4 - texels.size() % 4) % 4;
+        file.write(QByteArray(padding, '\0'));
+    }
+
+    return file.error() == QFileDevice::NoError;
+}
+
+}
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("texture_baker");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Bakes source images into pre-flipped, pre-mipmapped KTX textures.");
+    parser.addHelpOption();
+    parser.addOption({ { "o", "output" }, "Output directory (textures/ next to the game executable).", "directory", "textures" });
+    parser.addOption({ "bc1", "Compress every level to BC1 (DXT1), 8:1 against RGBA8." });
+    parser.addPositionalArgument("images", "Source images, e.g. resources/images/*.jpg", "images...");
+    parser.process(app);
+
+    const QStringList inputs = parser.positionalArguments();
+    if (inputs.isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    const QDir outputDir(parser.value("output"));
+    if (!outputDir.exists() && !QDir().mkpath(outputDir.path())) {
+        qWarning() << "Cannot create" << outputDir.path();
+        return 1;
+    }
+
+    const bool compress = parser.isSet("bc1");
+    int failures = 0;
+
+    for (const QString& input : inputs) {
+        QImage source(input);
+        if (source.isNull()) {
+            qWarning() << "Cannot read" << input;
+            failures++;
+            continue;
+        }
+
+        const std::vector<QImage> levels = buildMipChain(source);
+        const QString output = outputDir.filePath(QFileInfo(input).completeBaseName() + ".ktx");
+
+        if (writeKtx(output, levels, compress)) {
+            qDebug().noquote() << input << "->" << output << QString("(%1x%2, %3 levels%4)")
+                                  .arg(source.width()).arg(source.height()).arg(levels.size())
+                                  .arg(compress ? ", BC1" : "");
+        } else {
+            failures++;
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,17 @@
+QT += core gui
+QT -= widgets
+
+CONFIG += c++17 console
+CONFIG -= app_bundle
+
+TARGET = texture_baker
+
+INCLUDEPATH += ../../src
+
+SOURCES += \
+    main.cpp \
+    Bc1Encoder.cpp
+
+HEADERS += \
+    Bc1Encoder.h \
+    ../../src/KtxFormat.h